@@ -27,11 +27,14 @@
 
 #include "memorychunks.h"
 
+// /!\ __comment__ is used as statistics tag and must be a string literal (not copied)
+
 #define _NEW_CHUNK_( __type__, __item__ ) mage::core::MemoryChunks::getInstance()->registerChunk<__type__>( new __item__, sizeof( __type__ ), #__item__, __FUNCTION__, __LINE__, __FILE__ )
 #define _NEW_CHUNK_WITH_COMMENT( __type__, __item__, __comment__ ) mage::core::MemoryChunks::getInstance()->registerChunk<__type__>( new __item__, sizeof( __type__ ), #__item__, __FUNCTION__, __LINE__, __FILE__, __comment__ )
 
 #define _NEW_CHUNK_EXPLICIT_SIZE_( __type__, __item__, __size__ ) mage::core::MemoryChunks::getInstance()->registerChunk<__type__>( new __item__, __size__, #__item__, __FUNCTION__, __LINE__, __FILE__ )
 #define _NEW_CHUNK_EXPLICIT_SIZE_WITH_COMMENT( __type__, __item__, __size__, __comment__ ) mage::core::MemoryChunks::getInstance()->registerChunk<__type__>( new __item__, __size__, #__item__, __FUNCTION__, __LINE__, __FILE__, __comment__ )
 
-#define _DELETE_CHUNK_( __ptr__ ) delete __ptr__; mage::core::MemoryChunks::getInstance()->unregisterChunk( __ptr__ ); __ptr__ = nullptr
-#define _DELETE_CHUNK_N_( __ptr__ ) delete[] __ptr__; mage::core::MemoryChunks::getInstance()->unregisterChunk( __ptr__ ); __ptr__ = nullptr
+// chunk unregistered before delete : once freed, address can be reused by another thread allocation
+#define _DELETE_CHUNK_( __ptr__ ) mage::core::MemoryChunks::getInstance()->unregisterChunk( __ptr__ ); delete __ptr__; __ptr__ = nullptr
+#define _DELETE_CHUNK_N_( __ptr__ ) mage::core::MemoryChunks::getInstance()->unregisterChunk( __ptr__ ); delete[] __ptr__; __ptr__ = nullptr
@@ -0,0 +1,127 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#include <algorithm>
+#include <cstdint>
+
+#include "framearena.h"
+
+using namespace mage::core;
+
+void FrameArena::setBlockSize(size_t p_size)
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    m_block_size = p_size;
+}
+
+void FrameArena::reset(void)
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_last_frame_stats = m_stats;
+
+    if (m_blocks.size() > 1)
+    {
+        // frame did not fit in one block : replace them all with a single one large enough for next frames
+        size_t total{ 0 };
+        for (const auto& block : m_blocks)
+        {
+            total += block.size;
+        }
+        m_blocks.clear();
+        m_stats.capacity = 0;
+        add_block(total);
+    }
+
+    m_offset = 0;
+    m_stats.allocations = 0;
+    m_stats.bytes = 0;
+    m_stats.blocks = m_blocks.size();
+}
+
+FrameArena::Stats FrameArena::getCurrentStats(void) const
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+FrameArena::Stats FrameArena::getLastFrameStats(void) const
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    return m_last_frame_stats;
+}
+
+void FrameArena::add_block(size_t p_size)
+{
+    Block block;
+    block.data = std::make_unique<std::byte[]>(p_size);
+    block.size = p_size;
+    m_blocks.push_back(std::move(block));
+
+    m_offset = 0;
+    m_stats.capacity += p_size;
+    m_stats.blocks = m_blocks.size();
+}
+
+void* FrameArena::do_allocate(size_t p_bytes, size_t p_alignment)
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (0 == m_blocks.size())
+    {
+        add_block(m_block_size);
+    }
+
+    auto align_offset{ [&](const Block& p_block)
+    {
+        const auto base{ reinterpret_cast<uintptr_t>(p_block.data.get()) };
+        const auto aligned{ (base + m_offset + p_alignment - 1) & ~(uintptr_t)(p_alignment - 1) };
+        return static_cast<size_t>(aligned - base);
+    }};
+
+    size_t offset{ align_offset(m_blocks.back()) };
+    if (offset + p_bytes > m_blocks.back().size)
+    {
+        add_block(std::max(m_block_size, p_bytes + p_alignment));
+        offset = align_offset(m_blocks.back());
+    }
+
+    m_offset = offset + p_bytes;
+
+    m_stats.allocations++;
+    m_stats.bytes += p_bytes;
+
+    return m_blocks.back().data.get() + offset;
+}
+
+void FrameArena::do_deallocate(void*, size_t, size_t)
+{
+    // memory recycled in reset()
+}
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource& p_other) const noexcept
+{
+    return this == &p_other;
+}
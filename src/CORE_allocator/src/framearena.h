@@ -0,0 +1,92 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#pragma once
+
+#include <memory_resource>
+#include <memory>
+#include <vector>
+#include <mutex>
+#include <cstddef>
+
+#include "singleton.h"
+
+namespace mage
+{
+    namespace core
+    {
+        // linear allocator for per-frame temporaries : deallocate() does nothing, all memory is recycled at once by reset()
+        // /!\ anything allocated here must not be kept beyond the current frame
+        class FrameArena : public std::pmr::memory_resource, public property::Singleton<FrameArena>
+        {
+        public:
+
+            struct Stats
+            {
+                size_t  allocations{ 0 };
+                size_t  bytes{ 0 };
+                size_t  capacity{ 0 };
+                size_t  blocks{ 0 };
+            };
+
+            FrameArena(void) = default;
+            ~FrameArena() = default;
+
+            FrameArena(const FrameArena&) = delete;
+            FrameArena& operator=(const FrameArena&) = delete;
+
+            void    setBlockSize(size_t p_size);
+
+            // called once per frame by SystemEngine::run()
+            void    reset(void);
+
+            Stats   getCurrentStats(void) const;
+            Stats   getLastFrameStats(void) const;
+
+        private:
+
+            struct Block
+            {
+                std::unique_ptr<std::byte[]>    data;
+                size_t                          size{ 0 };
+            };
+
+            mutable std::mutex      m_mutex;
+
+            std::vector<Block>      m_blocks;
+            size_t                  m_offset{ 0 };
+            size_t                  m_block_size{ 1024 * 1024 };
+
+            Stats                   m_stats;
+            Stats                   m_last_frame_stats;
+
+            void    add_block(size_t p_size);
+
+            void*   do_allocate(size_t p_bytes, size_t p_alignment) override;
+            void    do_deallocate(void* p_ptr, size_t p_bytes, size_t p_alignment) override;
+            bool    do_is_equal(const std::pmr::memory_resource& p_other) const noexcept override;
+        };
+    }
+}
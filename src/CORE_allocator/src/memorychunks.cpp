@@ -22,6 +22,8 @@
 */
 /* -*-LIC_END-*- */
 
+#include <algorithm>
+
 #include "memorychunks.h"
 
 #include "logsink.h"
@@ -34,11 +36,19 @@ static logger::Sink memAllocLogger("MemAlloc", logger::Configuration::getInstanc
 
 void MemoryChunks::dumpContent(void)
 {
-    _MAGE_DEBUG(memAllocLogger, std::string("Allocations total size : ") + std::to_string(m_totalSize) + std::string (" byte(s)"))
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    merge();
 
-    long count{ 1 };
+    _MAGE_DEBUG(memAllocLogger, std::string("Allocations total size : ") + std::to_string(m_totalSize) + std::string (" byte(s), peak : ") + std::to_string(m_peakSize) + std::string(" byte(s)"));
+
+    for (const auto& e : m_tags)
+    {
+        _MAGE_DEBUG(memAllocLogger, std::string("tag [") << e.first << std::string("] live = ") << e.second.live_bytes << std::string(" byte(s) in ") << e.second.live_count
+                        << std::string(" chunk(s), peak = ") << e.second.peak_bytes << std::string(" byte(s), total = ") << e.second.total_count << std::string(" chunk(s)"));
+    }
 
-    for(auto e : m_chunks)
+    long count{ 1 };
+    for(const auto& e : m_chunks)
     {
         _MAGE_DEBUG(memAllocLogger, 
                         std::string("--> ") << count 
@@ -46,49 +56,232 @@ void MemoryChunks::dumpContent(void)
                         << std::string("/ ptr = ") << e.first 
                         << std::string(" size = ") << e.second.size 
             
-                        << std::string(" object = ") << e.second.item.c_str() 
-                        << std::string(" in function : ") << e.second.func.c_str() << std::string(" ") << e.second.file.c_str() 
+                        << std::string(" object = ") << e.second.item 
+                        << std::string(" in function : ") << e.second.func << std::string(" ") << e.second.file 
                                         
                         << std::string(", line ") << e.second.linenum 
-                        << std::string(" comment = [") << e.second.comment 
+                        << std::string(" tag = [") << m_tags.at(e.second.tag).first 
             
-                        << std::string("]"))    
+                        << std::string("]"));    
         count++;
     }
 
+    for (const auto& e : m_orphans)
+    {
+        _MAGE_WARN(memAllocLogger, std::string("no mem bloc ") << e.first << std::string("(already unallocated ?)"));
+    }
 }
 
 void MemoryChunks::unregisterChunk(void* p_ptr)
 {
-    if (m_chunks.count(p_ptr) > 0)
+    if (!is_sampled(p_ptr))
     {
-        _MAGE_TRACE(memAllocLogger, 
-                        std::string("ptr = ") << p_ptr << 
-                        std::string(" size = ") << m_chunks[p_ptr].size <<
-                        std::string(" object = ") << m_chunks[p_ptr].item.c_str() << 
-                        std::string(" in function : ") << m_chunks[p_ptr].func.c_str() << std::string(" ") << m_chunks[p_ptr].file.c_str() << 
-                        std::string(", line ") << m_chunks[p_ptr].linenum)
+        return;
+    }
+
+    record r{};
+    r.ptr = p_ptr;
+    r.seq = m_seq++;
+    push_record(r);
+}
+
+size_t MemoryChunks::getTotalSize(void) const
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    merge();
+    return m_totalSize * m_sampling_rate;
+}
+
+size_t MemoryChunks::getPeakSize(void) const
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    merge();
+    return m_peakSize * m_sampling_rate;
+}
+
+std::map<std::string, MemoryChunks::TagStats> MemoryChunks::getTagsStats(void)
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    merge();
 
-        m_totalSize -= m_chunks.at(p_ptr).size;
-        m_chunks.erase(p_ptr);
+    const size_t rate{ m_sampling_rate };
+
+    std::map<std::string, TagStats> stats;
+    for (const auto& e : m_tags)
+    {
+        TagStats s{ e.second };
+        s.live_bytes *= rate;
+        s.live_count *= rate;
+        s.peak_bytes *= rate;
+        s.total_count *= rate;
+        stats[e.first] = s;
     }
-    else
+    return stats;
+}
+
+void MemoryChunks::setSamplingRate(size_t p_rate)
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    merge();
+
+    m_sampling_rate = std::max<size_t>(p_rate, 1);
+
+    // chunks registered with previous rate cannot be matched anymore
+    m_chunks.clear();
+    m_orphans.clear();
+    for (auto& e : m_tags)
     {
-        _MAGE_WARN(memAllocLogger, std::string("no mem bloc ") << p_ptr << std::string("(already unallocated ?)"))
+        e.second = TagStats();
     }
+    m_totalSize = 0;
+    m_peakSize = 0;
 }
 
-size_t MemoryChunks::getTotalSize(void) const
+bool MemoryChunks::is_sampled(void* p_ptr) const
 {
-	return m_totalSize;
+    const size_t rate{ m_sampling_rate };
+    if (1 == rate)
+    {
+        return true;
+    }
+    // address based : registration and unregistration of a chunk are sampled together
+    const uint64_t h{ (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(p_ptr)) >> 4) * 0x9E3779B97F4A7C15ull };
+    return 0 == (h >> 32) % rate;
 }
 
-void MemoryChunks::register_bloc(void* p_ptr, size_t p_size, const std::string& p_item, const std::string& p_funcname, long p_line, const std::string& p_filename, const std::string& p_comment)
+void MemoryChunks::push_record(const record& p_record)
 {
-    const chunk c{ p_size, p_item, p_funcname, p_line, p_filename, p_comment };
-    m_chunks[p_ptr] = c;
-    m_totalSize += p_size;
+    thread_local std::shared_ptr<threadBuffer> buffer;
+    if (!buffer)
+    {
+        buffer = std::make_shared<threadBuffer>();
+        buffer->records.reserve(bufferFlushSize);
 
-    _MAGE_TRACE(memAllocLogger, std::string("ptr = ") << p_ptr << std::string(" size = ") << p_size << std::string(" object = ") << p_item.c_str() << std::string(" in function : ") << p_funcname.c_str()
-        << std::string(" ") << p_filename.c_str() << std::string(", line ") << p_line)
-}
\ No newline at end of file
+        const std::lock_guard<std::mutex> lock(m_buffers_mutex);
+        m_buffers.push_back(buffer);
+    }
+
+    bool flush{ false };
+    {
+        const std::lock_guard<std::mutex> lock(buffer->mutex);
+        buffer->records.push_back(p_record);
+        flush = (buffer->records.size() >= bufferFlushSize);
+    }
+
+    if (flush)
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        merge();
+    }
+}
+
+void MemoryChunks::merge(void) const
+{
+    std::vector<record> records;
+    {
+        const std::lock_guard<std::mutex> lock(m_buffers_mutex);
+        for (auto& buffer : m_buffers)
+        {
+            const std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            records.insert(records.end(), buffer->records.begin(), buffer->records.end());
+            buffer->records.clear();
+        }
+
+        // forget buffers of terminated threads
+        m_buffers.erase(std::remove_if(m_buffers.begin(), m_buffers.end(), [](const std::shared_ptr<threadBuffer>& p_buffer) { return 1 == p_buffer.use_count(); }), m_buffers.end());
+    }
+
+    std::sort(records.begin(), records.end(), [](const record& p_a, const record& p_b) { return p_a.seq < p_b.seq; });
+
+    for (const auto& r : records)
+    {
+        if (r.item)
+        {
+            const auto orphan{ m_orphans.find(r.ptr) };
+            if (orphan != m_orphans.end() && orphan->second > r.seq)
+            {
+                // already unregistered
+                m_orphans.erase(orphan);
+                continue;
+            }
+
+            const auto stale{ m_chunks.find(r.ptr) };
+            if (stale != m_chunks.end())
+            {
+                // address reused, its unregistration was missed : previous chunk is no longer live
+                release_chunk(stale->second);
+            }
+
+            const size_t tag{ intern_tag(r.tag ? r.tag : r.item) };
+            m_chunks[r.ptr] = chunk{ r.size, r.item, r.func, r.linenum, r.file, tag };
+
+            auto& tag_stats{ m_tags.at(tag).second };
+            tag_stats.live_bytes += r.size;
+            tag_stats.live_count++;
+            tag_stats.total_count++;
+            tag_stats.peak_bytes = std::max(tag_stats.peak_bytes, tag_stats.live_bytes);
+
+            m_totalSize += r.size;
+            m_peakSize = std::max(m_peakSize, m_totalSize);
+        }
+        else
+        {
+            const auto it{ m_chunks.find(r.ptr) };
+            if (it == m_chunks.end())
+            {
+                m_orphans[r.ptr] = r.seq;
+                continue;
+            }
+
+            release_chunk(it->second);
+            m_chunks.erase(it);
+        }
+    }
+}
+
+void MemoryChunks::release_chunk(const chunk& p_chunk) const
+{
+    auto& tag_stats{ m_tags.at(p_chunk.tag).second };
+    tag_stats.live_bytes -= p_chunk.size;
+    tag_stats.live_count--;
+
+    m_totalSize -= p_chunk.size;
+}
+
+size_t MemoryChunks::intern_tag(const char* p_tag) const
+{
+    const auto it{ m_tags_by_ptr.find(p_tag) };
+    if (it != m_tags_by_ptr.end())
+    {
+        return it->second;
+    }
+
+    // same literal may have different addresses from one module to another
+    const std::string name{ p_tag };
+    const auto it_name{ m_tags_by_name.find(name) };
+
+    size_t tag;
+    if (it_name != m_tags_by_name.end())
+    {
+        tag = it_name->second;
+    }
+    else
+    {
+        tag = m_tags.size();
+        m_tags.push_back(std::make_pair(name, TagStats()));
+        m_tags_by_name[name] = tag;
+    }
+    m_tags_by_ptr[p_tag] = tag;
+    return tag;
+}
+
+void MemoryChunks::register_bloc(void* p_ptr, size_t p_size, const char* p_item, const char* p_funcname, long p_line, const char* p_filename, const char* p_tag)
+{
+    if (!is_sampled(p_ptr))
+    {
+        return;
+    }
+
+    const record r{ p_ptr, p_size, p_item, p_funcname, p_line, p_filename, p_tag, m_seq++ };
+    push_record(r);
+}
@@ -26,6 +26,12 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <cstdint>
 
 #include "singleton.h"
 
@@ -33,45 +39,103 @@ namespace mage
 {
     namespace core
     {
+        // allocations tracking : registrations are stored in per-thread buffers and merged lazily in chunks map
+        // item, function, file and tag names are expected to be string literals : only pointers are stored
         class MemoryChunks : public property::Singleton<MemoryChunks>
         {
         public:
 
+            struct TagStats
+            {
+                size_t  live_bytes{ 0 };
+                size_t  live_count{ 0 };
+                size_t  peak_bytes{ 0 };
+                size_t  total_count{ 0 };
+            };
+
             MemoryChunks(void) = default;
             ~MemoryChunks() = default;
 
             void dumpContent(void);
 
             template <typename base>
-            base* registerChunk(base* p_ptr, size_t p_size, const std::string& p_item, const std::string& p_funcname, long p_line, const std::string& p_filename, const std::string& p_comment = "")
+            base* registerChunk(base* p_ptr, size_t p_size, const char* p_item, const char* p_funcname, long p_line, const char* p_filename, const char* p_tag = nullptr)
             {
                 base* t = p_ptr;
-                register_bloc(t, p_size, p_item, p_funcname, p_line, p_filename, p_comment);
-
+                register_bloc(t, p_size, p_item, p_funcname, p_line, p_filename, p_tag);
                 return t;
             };
 
             void    unregisterChunk(void* p_ptr);
+
             size_t  getTotalSize(void) const;
+            size_t  getPeakSize(void) const;
+
+            // per tag stats (tag is item name when not specified); estimations when sampling is enabled
+            std::map<std::string, TagStats> getTagsStats(void);
 
+            // only track 1 chunk address out of p_rate (1 : track all); current stats are reset
+            void    setSamplingRate(size_t p_rate);
 
         private:
 
+            struct record
+            {
+                void*           ptr;
+                size_t          size;
+                const char*     item;       // nullptr for unregistration
+                const char*     func;
+                long            linenum;
+                const char*     file;
+                const char*     tag;
+                uint64_t        seq;
+            };
+
+            struct threadBuffer
+            {
+                std::mutex              mutex;
+                std::vector<record>     records;
+            };
+
             struct chunk
             {
                 size_t          size;
-                std::string     item;
-                std::string     func;
+                const char*     item;
+                const char*     func;
                 long            linenum;
-                std::string     file;
-                std::string     comment;
+                const char*     file;
+                size_t          tag;
             };
 
-            std::unordered_map<void*, chunk>  m_chunks;
-            size_t                  m_totalSize{ 0 };
-           
-            void register_bloc(void* p_ptr, size_t p_size, const std::string& p_item, const std::string& p_funcname, long p_line, const std::string& p_filename, const std::string& p_comment);
+            static constexpr size_t                         bufferFlushSize{ 1024 };
+
+            std::atomic<uint64_t>                           m_seq{ 0 };
+            std::atomic<size_t>                             m_sampling_rate{ 1 };
+
+            // merged lazily, by const getters too
+            mutable std::mutex                              m_buffers_mutex;
+            mutable std::vector<std::shared_ptr<threadBuffer>> m_buffers;
+
+            // below : protected by m_mutex
+            mutable std::mutex                              m_mutex;
+
+            mutable std::unordered_map<void*, chunk>        m_chunks;
+            mutable std::unordered_map<void*, uint64_t>     m_orphans; // unregistrations merged before their registration
+
+            mutable std::unordered_map<const char*, size_t> m_tags_by_ptr;
+            mutable std::unordered_map<std::string, size_t> m_tags_by_name;
+            mutable std::vector<std::pair<std::string, TagStats>> m_tags;
+
+            mutable size_t                                  m_totalSize{ 0 };
+            mutable size_t                                  m_peakSize{ 0 };
+
+            bool    is_sampled(void* p_ptr) const;
+            void    push_record(const record& p_record);
+            void    merge(void) const;
+            void    release_chunk(const chunk& p_chunk) const;
+            size_t  intern_tag(const char* p_tag) const;
 
+            void    register_bloc(void* p_ptr, size_t p_size, const char* p_item, const char* p_funcname, long p_line, const char* p_filename, const char* p_tag);
         };
     }
 }
@@ -0,0 +1,214 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#pragma once
+
+#include <new>
+#include <memory>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <cstddef>
+
+namespace mage
+{
+    namespace core
+    {
+        // all pools counters, for frame stats
+        struct PoolsCounters
+        {
+            static inline std::atomic<size_t>   allocations{ 0 };
+            static inline std::atomic<size_t>   deallocations{ 0 };
+        };
+
+        // fixed size blocks allocator, one pool per type
+        template<typename T>
+        class Pool
+        {
+        public:
+
+            struct Stats
+            {
+                size_t  live{ 0 };
+                size_t  capacity{ 0 };
+            };
+
+            // never destroyed : pooled objects may be released during static destruction
+            static Pool* getInstance(void)
+            {
+                static Pool* instance{ new Pool() };
+                return instance;
+            }
+
+            void* allocate(void)
+            {
+                const std::lock_guard<std::mutex> lock(m_mutex);
+
+                if (nullptr == m_free)
+                {
+                    add_chunk();
+                }
+
+                Slot* slot{ m_free };
+                m_free = slot->next;
+
+                m_stats.live++;
+                PoolsCounters::allocations++;
+                return slot->storage;
+            }
+
+            void deallocate(void* p_ptr)
+            {
+                const std::lock_guard<std::mutex> lock(m_mutex);
+
+                Slot* slot{ reinterpret_cast<Slot*>(p_ptr) };
+                slot->next = m_free;
+                m_free = slot;
+
+                m_stats.live--;
+                PoolsCounters::deallocations++;
+            }
+
+            Stats getStats(void) const
+            {
+                const std::lock_guard<std::mutex> lock(m_mutex);
+                return m_stats;
+            }
+
+        private:
+
+            union Slot
+            {
+                Slot*                               next;
+                alignas(T) std::byte                storage[sizeof(T)];
+            };
+
+            static constexpr size_t                 maxChunkSize{ 4096 };
+
+            mutable std::mutex                      m_mutex;
+            std::vector<std::unique_ptr<Slot[]>>    m_chunks;
+            Slot*                                   m_free{ nullptr };
+            size_t                                  m_chunk_size{ 16 };
+
+            Stats                                   m_stats;
+
+            Pool(void) = default;
+
+            void add_chunk(void)
+            {
+                m_chunks.push_back(std::make_unique<Slot[]>(m_chunk_size));
+                Slot* chunk{ m_chunks.back().get() };
+
+                for (size_t i = 0; i < m_chunk_size; i++)
+                {
+                    chunk[i].next = (i + 1 < m_chunk_size ? &chunk[i + 1] : m_free);
+                }
+                m_free = chunk;
+
+                m_stats.capacity += m_chunk_size;
+                if (m_chunk_size < maxChunkSize)
+                {
+                    m_chunk_size *= 2;
+                }
+            }
+        };
+
+        // std allocator on top of Pool<T>, i.e for std::allocate_shared
+        template<typename T>
+        class PoolAllocator
+        {
+        public:
+            using value_type = T;
+
+            PoolAllocator(void) = default;
+
+            template<typename U>
+            PoolAllocator(const PoolAllocator<U>&) noexcept
+            {
+            }
+
+            T* allocate(size_t p_count)
+            {
+                if (1 == p_count)
+                {
+                    return static_cast<T*>(Pool<T>::getInstance()->allocate());
+                }
+                return std::allocator<T>().allocate(p_count);
+            }
+
+            void deallocate(T* p_ptr, size_t p_count)
+            {
+                if (1 == p_count)
+                {
+                    Pool<T>::getInstance()->deallocate(p_ptr);
+                }
+                else
+                {
+                    std::allocator<T>().deallocate(p_ptr, p_count);
+                }
+            }
+
+            template<typename U>
+            bool operator==(const PoolAllocator<U>&) const noexcept
+            {
+                return true;
+            }
+
+            template<typename U>
+            bool operator!=(const PoolAllocator<U>&) const noexcept
+            {
+                return false;
+            }
+        };
+
+        template<typename T>
+        struct PoolDeleter
+        {
+            void operator()(T* p_ptr) const
+            {
+                p_ptr->~T();
+                Pool<T>::getInstance()->deallocate(p_ptr);
+            }
+        };
+
+        template<typename T>
+        using PoolPtr = std::unique_ptr<T, PoolDeleter<T>>;
+
+        template<typename T, class... Args>
+        PoolPtr<T> makePooled(Args&&... p_args)
+        {
+            void* storage{ Pool<T>::getInstance()->allocate() };
+            try
+            {
+                return PoolPtr<T>(new (storage) T(std::forward<Args>(p_args)...));
+            }
+            catch (...)
+            {
+                Pool<T>::getInstance()->deallocate(storage);
+                throw;
+            }
+        }
+    }
+}
@@ -26,6 +26,8 @@
 
 #include "app.h"
 
+#include <thread>
+
 #include "filesystem.h"
 #include "logsink.h"
 #include "logconf.h"
@@ -44,6 +46,13 @@ static mage::core::logger::Sink localLogger("App", mage::core::logger::Configura
     __x__ = (WORD)( __pLParam__ & 0x0000ffff ); \
     __y__ = (WORD)( ( __pLParam__ & 0xffff0000 ) >> 16 );
 
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+// end of frame wait is done by spinning, timer resolution is not enough
+static constexpr std::chrono::microseconds frameSpinDuration{ 1000 };
+
 
 
 App::App()
@@ -65,6 +74,11 @@ App::App()
                 
                 this->onModuleMouseModeUpdate(p_evt_value);
                 break;
+
+            case interfaces::ModuleEvents::FRAME_REQUESTED:
+
+                m_frame_scheduler.requestFrame();
+                break;
         }
     };
 }
@@ -108,10 +122,34 @@ void App::init(HINSTANCE p_hInstance, const std::string& p_logconfig_path, const
         m_w_fullscreen = windows_settings.fullscreen;
         m_w_width = windows_settings.width;
         m_w_height = windows_settings.height;
+
+        const auto& frame_pacing{ windows_settings.frame_pacing };
+        if ("continuous" == frame_pacing.mode)
+        {
+            m_frame_scheduler.setMode(FrameScheduler::Mode::CONTINUOUS);
+        }
+        else if ("on_demand" == frame_pacing.mode)
+        {
+            m_frame_scheduler.setMode(FrameScheduler::Mode::ON_DEMAND);
+        }
+        else
+        {
+            _EXCEPTION("Unknown frame pacing mode: " + frame_pacing.mode)
+        }
+        m_frame_scheduler.setTargetRate(frame_pacing.target_fps);
+        m_frame_scheduler.setIdleTimeout(std::chrono::milliseconds(frame_pacing.idle_timeout_ms));
+    }
+
+    // high resolution timer (win10 1803+), fallback on standard one
+    m_frame_timer = ::CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (!m_frame_timer)
+    {
+        m_frame_timer = ::CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
     }
 
 
 	_MAGE_DEBUG(localLogger, std::string("app config is : ") << m_w_width << std::string(" x ") << m_w_height << std::string(" fullscreen : ") << m_w_fullscreen);
+	_MAGE_DEBUG(localLogger, std::string("frame pacing : ") << std::string(FrameScheduler::Mode::ON_DEMAND == m_frame_scheduler.getMode() ? "on_demand" : "continuous") << std::string(" target fps : ") << m_frame_scheduler.getTargetRate());
 
     // set static to spare some space on stack // compiler message
 	static WNDCLASSA wc;
@@ -130,7 +168,7 @@ void App::init(HINSTANCE p_hInstance, const std::string& p_logconfig_path, const
 
     if (!RegisterClassA(&wc))
     {
-        _MAGE_FATAL(localLogger, "RegisterClass FAIL")
+        _MAGE_FATAL(localLogger, "RegisterClass FAIL");
         _EXCEPTION("RegisterClass FAIL")
     }
     else
@@ -148,13 +186,13 @@ void App::init(HINSTANCE p_hInstance, const std::string& p_logconfig_path, const
             m_w_width = fsw;
             m_w_height = fsh;
 
-            _MAGE_DEBUG(localLogger, std::string("Fullscreen mode : CreateWindowExA ") << fsw << std::string(" x ") << fsh)
+            _MAGE_DEBUG(localLogger, std::string("Fullscreen mode : CreateWindowExA ") << fsw << std::string(" x ") << fsh);
             m_hwnd = CreateWindowExA(WS_EX_TOPMOST, wc.lpszClassName, "", WS_POPUP, 0, 0, fsw, fsh, nullptr, nullptr, p_hInstance, nullptr);
         }
         else
         {
             // mode fenetre
-            _MAGE_DEBUG(localLogger, std::string("Windowed mode : CreateWindowA ") << m_w_width << std::string(" x ") << m_w_height)
+            _MAGE_DEBUG(localLogger, std::string("Windowed mode : CreateWindowA ") << m_w_width << std::string(" x ") << m_w_height);
 
             static const std::string wTitle{ "mage" };
             m_hwnd = CreateWindowA(wc.lpszClassName, (LPCSTR)wTitle.c_str(), WS_SYSMENU | WS_MINIMIZEBOX | WS_MAXIMIZE, CW_USEDEFAULT, CW_USEDEFAULT, m_w_width, m_w_height, nullptr, nullptr, p_hInstance, nullptr);
@@ -162,7 +200,7 @@ void App::init(HINSTANCE p_hInstance, const std::string& p_logconfig_path, const
 
         if (!m_hwnd)
         {
-            _MAGE_FATAL(localLogger, "CreateWindow FAIL")
+            _MAGE_FATAL(localLogger, "CreateWindow FAIL");
             _EXCEPTION("CreateWindowA FAIL")
         }
         else
@@ -200,7 +238,7 @@ void App::init(HINSTANCE p_hInstance, const std::string& p_logconfig_path, const
             }
             else
             {
-                _MAGE_WARN(localLogger, "no entity graph in attached module")
+                _MAGE_WARN(localLogger, "no entity graph in attached module");
             }
         }
     }
@@ -368,31 +406,98 @@ void App::loop(void)
         MSG	msg;
         while (1)
         {
-            if (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE))
+            while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE))
             {
                 if (WM_QUIT == msg.message)
                 {
-                    _MAGE_DEBUG(localLogger, "WM_QUIT, calling OnClose()")
+                    _MAGE_DEBUG(localLogger, "WM_QUIT, calling OnClose()");
                     onClose();
-                    break;
+                    return;
                 }
 
-                else
+                TranslateMessage(&msg);
+                DispatchMessage(&msg);
+
+                if ((msg.message >= WM_KEYFIRST && msg.message <= WM_KEYLAST) ||
+                    (msg.message >= WM_MOUSEFIRST && msg.message <= WM_MOUSELAST) ||
+                    WM_PAINT == msg.message || WM_APP == msg.message)
                 {
-                    TranslateMessage(&msg);
-                    DispatchMessage(&msg);
+                    m_frame_scheduler.requestFrame();
                 }
             }
-            else
+
+            if (!m_app_ready || !isFrameNeeded())
             {
-                if (m_app_ready)
-                {
-                    processInputEvents();
-                    onRenderFrame();
-                }
+                // nothing to render : sleep until next OS message or idle timeout
+                waitEvents(static_cast<DWORD>(m_frame_scheduler.getIdleTimeout().count()));
+                continue;
+            }
+
+            if (!waitFrameDeadline())
+            {
+                // woken up by an OS message
+                continue;
+            }
+
+            m_frame_scheduler.beginFrame();
+
+            processInputEvents();
+            onRenderFrame();
+
+            if (m_module_root)
+            {
+                const interfaces::FrameStats stats{ m_frame_scheduler.getFramesCount(), m_frame_scheduler.getFrameTimeMean(), m_frame_scheduler.getFrameTimeVariance() };
+                m_module_root->onFrameEnd(stats);
+            }
+        }
+    }
+}
+
+FrameScheduler& App::getFrameScheduler()
+{
+    return m_frame_scheduler;
+}
+
+bool App::isFrameNeeded(void)
+{
+    if (FrameScheduler::Mode::CONTINUOUS == m_frame_scheduler.getMode())
+    {
+        return true;
+    }
+    return m_frame_scheduler.isFrameRequested() || (m_module_root && m_module_root->hasPendingWork());
+}
+
+bool App::waitFrameDeadline(void)
+{
+    const auto remaining{ m_frame_scheduler.getTimeToNextFrame() };
+
+    if (remaining > frameSpinDuration && m_frame_timer)
+    {
+        // relative due time, in 100 ns units
+        LARGE_INTEGER due_time;
+        due_time.QuadPart = -static_cast<LONGLONG>(std::chrono::duration_cast<std::chrono::nanoseconds>(remaining - frameSpinDuration).count() / 100);
+
+        if (::SetWaitableTimer(m_frame_timer, &due_time, 0, nullptr, nullptr, FALSE))
+        {
+            const auto status{ ::MsgWaitForMultipleObjectsEx(1, &m_frame_timer, INFINITE, QS_ALLINPUT, MWMO_INPUTAVAILABLE) };
+            if (WAIT_OBJECT_0 != status)
+            {
+                ::CancelWaitableTimer(m_frame_timer);
+                return false;
             }
         }
     }
+
+    while (m_frame_scheduler.getTimeToNextFrame() > FrameScheduler::Clock::duration::zero())
+    {
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+void App::waitEvents(DWORD p_timeout_ms)
+{
+    ::MsgWaitForMultipleObjectsEx(0, nullptr, p_timeout_ms, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
 }
 
 
@@ -415,6 +520,12 @@ void App::onClose(void)
     {
         m_module_root->close();
     }
+
+    if (m_frame_timer)
+    {
+        ::CloseHandle(m_frame_timer);
+        m_frame_timer = nullptr;
+    }
 }
 
 void App::onKeyPress(long p_key)
@@ -34,19 +34,30 @@
 
 #include "singleton.h"
 #include "module_root.h"
+#include "framescheduler.h"
 
 namespace mage
 {
     namespace json
     {
+        struct FramePacingSettings
+        {
+            std::string                 mode{ "continuous" };   // "continuous" or "on_demand"
+            double                      target_fps{ 0.0 };      // 0 : no limit
+            long                        idle_timeout_ms{ 250 };
+
+            JS_OBJ(mode, target_fps, idle_timeout_ms);
+        };
+
         struct WindowsSettings
         {
             bool                        fullscreen{ false };
             long                        width{ 0 };
             long                        height{ 0 };
             std::vector<std::string>    fonts;
+            FramePacingSettings         frame_pacing;
 
-            JS_OBJ(fullscreen, width, height, fonts);
+            JS_OBJ(fullscreen, width, height, fonts, frame_pacing);
         };
     }
 
@@ -62,6 +73,8 @@ namespace mage
             void init(HINSTANCE p_hInstance, const std::string& p_logconfig_path, const std::string& p_rtconfig_path, mage::interfaces::ModuleRoot* p_root);
             void loop(void);
 
+            FrameScheduler& getFrameScheduler();
+
         private:
 
             HWND                                    m_hwnd                  { nullptr };
@@ -98,11 +111,18 @@ namespace mage
 
             std::vector<std::string>                m_fonts;
 
+            FrameScheduler                          m_frame_scheduler;
+            HANDLE                                  m_frame_timer           { nullptr };
+
 
             void    processInputEvents(void);
 
             bool    loopAppInit();
 
+            bool    isFrameNeeded(void);
+            bool    waitFrameDeadline(void);
+            void    waitEvents(DWORD p_timeout_ms);
+
             void    onRenderFrame(void);
 
 
@@ -0,0 +1,179 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#include "framescheduler.h"
+
+#include <cmath>
+
+using namespace mage;
+using namespace mage::core;
+
+void FrameScheduler::setMode(Mode p_mode)
+{
+    m_mode = p_mode;
+    m_frame_requested = true;
+}
+
+FrameScheduler::Mode FrameScheduler::getMode() const
+{
+    return m_mode;
+}
+
+void FrameScheduler::setTargetRate(double p_fps)
+{
+    m_target_rate = p_fps > 0.0 ? p_fps : 0.0;
+    if (m_target_rate > 0.0)
+    {
+        m_frame_period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / m_target_rate));
+    }
+    else
+    {
+        m_frame_period = Clock::duration::zero();
+    }
+}
+
+double FrameScheduler::getTargetRate() const
+{
+    return m_target_rate;
+}
+
+void FrameScheduler::setIdleTimeout(std::chrono::milliseconds p_timeout)
+{
+    m_idle_timeout = p_timeout;
+}
+
+std::chrono::milliseconds FrameScheduler::getIdleTimeout() const
+{
+    return m_idle_timeout;
+}
+
+void FrameScheduler::requestFrame()
+{
+    m_frame_requested.store(true, std::memory_order_release);
+}
+
+bool FrameScheduler::isFrameRequested() const
+{
+    return m_frame_requested.load(std::memory_order_acquire);
+}
+
+FrameScheduler::Clock::duration FrameScheduler::getTimeToNextFrame() const
+{
+    if (m_first_frame || Clock::duration::zero() == m_frame_period)
+    {
+        return Clock::duration::zero();
+    }
+
+    const auto now{ Clock::now() };
+    return now < m_next_frame ? m_next_frame - now : Clock::duration::zero();
+}
+
+void FrameScheduler::beginFrame()
+{
+    // requests posted while rendering this frame will trigger the next one
+    m_frame_requested.store(false, std::memory_order_release);
+
+    const auto now{ Clock::now() };
+
+    if (m_first_frame)
+    {
+        m_first_frame = false;
+    }
+    else
+    {
+        const double frame_time{ std::chrono::duration<double, std::milli>(now - m_last_frame).count() };
+
+        if (m_frame_times_count == statsWindowSize)
+        {
+            const double oldest{ m_frame_times[m_frame_times_index] };
+            m_frame_times_sum -= oldest;
+            m_frame_times_sum_sq -= oldest * oldest;
+        }
+        else
+        {
+            m_frame_times_count++;
+        }
+
+        m_frame_times[m_frame_times_index] = frame_time;
+        m_frame_times_sum += frame_time;
+        m_frame_times_sum_sq += frame_time * frame_time;
+
+        m_frame_times_index = (m_frame_times_index + 1) % statsWindowSize;
+        if (0 == m_frame_times_index)
+        {
+            // window wrapped : recompute sums to cancel accumulated rounding errors
+            m_frame_times_sum = 0.0;
+            m_frame_times_sum_sq = 0.0;
+            for (int i = 0; i < m_frame_times_count; i++)
+            {
+                m_frame_times_sum += m_frame_times[i];
+                m_frame_times_sum_sq += m_frame_times[i] * m_frame_times[i];
+            }
+        }
+    }
+
+    // next deadline is based on previous one to avoid drift, unless we are late by more than a period
+    if (Clock::duration::zero() != m_frame_period)
+    {
+        m_next_frame += m_frame_period;
+        if (m_next_frame < now)
+        {
+            m_next_frame = now + m_frame_period;
+        }
+    }
+
+    m_last_frame = now;
+    m_frames_count++;
+}
+
+long long FrameScheduler::getFramesCount() const
+{
+    return m_frames_count;
+}
+
+double FrameScheduler::getFrameTimeMean() const
+{
+    if (0 == m_frame_times_count)
+    {
+        return 0.0;
+    }
+    return m_frame_times_sum / m_frame_times_count;
+}
+
+double FrameScheduler::getFrameTimeVariance() const
+{
+    if (m_frame_times_count < 2)
+    {
+        return 0.0;
+    }
+    const double mean{ getFrameTimeMean() };
+    const double variance{ (m_frame_times_sum_sq / m_frame_times_count) - (mean * mean) };
+    return variance > 0.0 ? variance : 0.0;
+}
+
+double FrameScheduler::getFrameTimeStdDev() const
+{
+    return std::sqrt(getFrameTimeVariance());
+}
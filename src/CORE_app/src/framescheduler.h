@@ -0,0 +1,102 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#pragma once
+
+#include <chrono>
+#include <atomic>
+#include <array>
+
+namespace mage
+{
+    namespace core
+    {
+        // main loop pacing : target rate limiter, on-demand rendering requests and frame time statistics
+        class FrameScheduler
+        {
+        public:
+
+            enum class Mode
+            {
+                CONTINUOUS,     // render every loop iteration (limited by target rate if any)
+                ON_DEMAND       // render only when a frame has been requested or module has pending work
+            };
+
+            using Clock = std::chrono::steady_clock;
+
+            static constexpr int statsWindowSize{ 128 };
+
+            FrameScheduler() = default;
+            ~FrameScheduler() = default;
+
+            void                    setMode(Mode p_mode);
+            Mode                    getMode() const;
+
+            // 0.0 : no rate limit
+            void                    setTargetRate(double p_fps);
+            double                  getTargetRate() const;
+
+            // on-demand mode : max wait before polling module for pending work
+            void                    setIdleTimeout(std::chrono::milliseconds p_timeout);
+            std::chrono::milliseconds getIdleTimeout() const;
+
+            // can be called from any thread; request is cleared by beginFrame()
+            void                    requestFrame();
+            bool                    isFrameRequested() const;
+
+            // remaining time before next frame is allowed, zero if already reached
+            Clock::duration         getTimeToNextFrame() const;
+
+            // to call just before rendering a frame : clear frame request and update statistics
+            void                    beginFrame();
+
+            long long               getFramesCount() const;
+            double                  getFrameTimeMean() const;       // ms
+            double                  getFrameTimeVariance() const;   // ms^2
+            double                  getFrameTimeStdDev() const;     // ms
+
+        private:
+
+            Mode                                    m_mode                  { Mode::CONTINUOUS };
+            Clock::duration                         m_frame_period          { Clock::duration::zero() };
+            double                                  m_target_rate           { 0.0 };
+            std::chrono::milliseconds               m_idle_timeout          { 250 };
+
+            std::atomic<bool>                       m_frame_requested       { true };
+
+            Clock::time_point                       m_last_frame;
+            Clock::time_point                       m_next_frame;
+            bool                                    m_first_frame           { true };
+
+            // frame times sliding window
+            std::array<double, statsWindowSize>     m_frame_times;
+            int                                     m_frame_times_index     { 0 };
+            int                                     m_frame_times_count     { 0 };
+            double                                  m_frame_times_sum       { 0.0 };
+            double                                  m_frame_times_sum_sq    { 0.0 };
+            long long                               m_frames_count          { 0 };
+        };
+    }
+}
@@ -24,52 +24,89 @@
 
 #pragma once
 #include <memory>
+#include <functional>
+#include <type_traits>
+#include <cstring>
 #include "exceptions.h"
 
 namespace mage
 {
     namespace core
     {
+        // ref-counted buffer : copies and slices share the same memory block, update() detach it when shared (copy on write)
         template<typename T>
         class Buffer
         {
         public:
 
+            using Release = std::function<void(T*)>;
+
             Buffer() = default;
 
-            Buffer(const Buffer& p_other)
+            Buffer(const Buffer&) = default;
+            Buffer& operator=(const Buffer&) = default;
+
+            Buffer(Buffer&& p_other) noexcept :
+            m_owner(std::move(p_other.m_owner)),
+            m_data(p_other.m_data),
+            m_dataSize(p_other.m_dataSize)
             {
-                if (p_other.isEmpty())
-                {
-                    return;
-                }
+                p_other.m_data = nullptr;
+                p_other.m_dataSize = 0;
+            }
 
-                m_data.release();
-                m_data = std::make_unique<T[]>(p_other.m_dataSize);
-                memcpy((void*)m_data.get(), p_other.m_data.get(), p_other.m_dataSize * sizeof(T));
-                m_dataSize = p_other.m_dataSize;
-            }            
-            Buffer(Buffer&&) = delete;
-            
-            Buffer& operator=(const Buffer& p_other)
+            Buffer& operator=(Buffer&& p_other) noexcept
             {
-                if (p_other.isEmpty())
+                if (this != &p_other)
                 {
-                    return *this;
-                }
-                m_data.release();
-                m_data = std::make_unique<T[]>(p_other.m_dataSize);
-                memcpy((void*)m_data.get(), p_other.m_data.get(), p_other.m_dataSize * sizeof(T));
-                m_dataSize = p_other.m_dataSize;
+                    m_owner = std::move(p_other.m_owner);
+                    m_data = p_other.m_data;
+                    m_dataSize = p_other.m_dataSize;
 
+                    p_other.m_data = nullptr;
+                    p_other.m_dataSize = 0;
+                }
                 return *this;
             }
 
             ~Buffer() = default;
 
+            // use external memory without copy; p_release called when last reference is dropped
+            static Buffer adopt(T* p_data, size_t p_dataSize, const Release& p_release)
+            {
+                Buffer buffer;
+                buffer.m_owner = std::shared_ptr<T>(p_data, p_release);
+                buffer.m_data = p_data;
+                buffer.m_dataSize = p_dataSize;
+                return buffer;
+            }
+
+            static Buffer adopt(std::unique_ptr<T[]>&& p_data, size_t p_dataSize)
+            {
+                Buffer buffer;
+                buffer.m_data = p_data.get();
+                buffer.m_owner = std::shared_ptr<T>(p_data.release(), std::default_delete<T[]>());
+                buffer.m_dataSize = p_dataSize;
+                return buffer;
+            }
+
+            // sub-view sharing same memory block
+            Buffer slice(size_t p_offset, size_t p_count) const
+            {
+                if (p_offset + p_count > m_dataSize)
+                {
+                    _EXCEPTION("buffer slice out of range")
+                }
+
+                Buffer buffer{ *this };
+                buffer.m_data = m_data + p_offset;
+                buffer.m_dataSize = p_count;
+                return buffer;
+            }
+
             T* getData(void) const
             {
-                return m_data.get();
+                return m_data;
             }
 
             size_t getDataSize(void) const
@@ -79,18 +116,36 @@ namespace mage
 
             bool isEmpty() const
             {
-                return (m_data.get()==nullptr);
+                return (m_data == nullptr);
             }
 
-            void fill(T* p_buffer, size_t p_bufferSize)
+            bool isShared() const
             {
-                m_data.release();
-                m_data = std::make_unique<T[]>(p_bufferSize);
-                memcpy((void*)m_data.get(), p_buffer, p_bufferSize * sizeof(T));
-                m_dataSize = p_bufferSize;
+                return (m_owner.use_count() > 1);
             }
 
-            void update(T* p_buffer)
+            T* begin() const
+            {
+                return m_data;
+            }
+
+            T* end() const
+            {
+                return m_data + m_dataSize;
+            }
+
+            T& operator[](size_t p_index) const
+            {
+                return m_data[p_index];
+            }
+
+            void fill(const T* p_buffer, size_t p_bufferSize)
+            {
+                allocate(p_bufferSize);
+                memcpy((void*)m_data, p_buffer, p_bufferSize * sizeof(T));
+            }
+
+            void update(const T* p_buffer)
             {
                 if (isEmpty())
                 {
@@ -98,13 +153,36 @@ namespace mage
                 }
                 else
                 {
-                    memcpy((void*)m_data.get(), p_buffer, m_dataSize * sizeof(T));
+                    if (isShared())
+                    {
+                        allocate(m_dataSize);
+                    }
+                    memcpy((void*)m_data, p_buffer, m_dataSize * sizeof(T));
                 }
             }
 
+            void clear()
+            {
+                m_owner.reset();
+                m_data = nullptr;
+                m_dataSize = 0;
+            }
+
         private:
-            std::unique_ptr<T[]>    m_data;
+
+            using MutableT = std::remove_const_t<T>;
+
+            std::shared_ptr<T>      m_owner;
+            T*                      m_data{ nullptr };
             size_t                  m_dataSize { 0 };
+
+            void allocate(size_t p_size)
+            {
+                MutableT* block{ new MutableT[p_size] };
+                m_owner = std::shared_ptr<T>(block, [](T* p_ptr) { delete[] const_cast<MutableT*>(p_ptr); });
+                m_data = block;
+                m_dataSize = p_size;
+            }
         };
     }
 }
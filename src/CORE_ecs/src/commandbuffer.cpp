@@ -0,0 +1,65 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#include "commandbuffer.h"
+
+using namespace mage::core;
+
+void CommandBuffer::append(CommandBuffer&& p_other)
+{
+	if (p_other.m_entitygraph != m_entitygraph)
+	{
+		_EXCEPTION("cannot append commands targeting another entitygraph");
+	}
+
+	m_commands.reserve(m_commands.size() + p_other.m_commands.size());
+	for (auto& command : p_other.m_commands)
+	{
+		m_commands.push_back(std::move(command));
+	}
+	p_other.m_commands.clear();
+}
+
+void CommandBuffer::apply()
+{
+	// swap first : a command may trigger entitygraph events whose handlers record into this buffer
+	std::vector<std::unique_ptr<Command>> commands;
+	commands.swap(m_commands);
+
+	for (auto& command : commands)
+	{
+		command->apply(*m_entitygraph);
+	}
+}
+
+size_t CommandBuffer::size() const
+{
+	return m_commands.size();
+}
+
+bool CommandBuffer::empty() const
+{
+	return m_commands.empty();
+}
@@ -0,0 +1,154 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "entity.h"
+#include "entitygraph.h"
+
+namespace mage
+{
+	namespace core
+	{
+		// records entitygraph structural changes (entities, aspects, components creation/removal) to apply them later on main thread.
+		// recording thread builds components purposes; apply() only links them into the graph.
+		// a buffer is not thread-safe : one buffer per recording thread (System::m_commands for systems), applied by SystemEngine at end of frame.
+		// entities are referenced by id, so commands can target entities created earlier in the same buffer
+		class CommandBuffer
+		{
+		public:
+			CommandBuffer(Entitygraph& p_entitygraph) :
+			m_entitygraph(&p_entitygraph)
+			{
+			}
+
+			~CommandBuffer() = default;
+
+			CommandBuffer(const CommandBuffer&) = delete;
+			CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+			CommandBuffer(CommandBuffer&&) = default;
+			CommandBuffer& operator=(CommandBuffer&&) = default;
+
+			void addEntity(const std::string& p_parent_id, const std::string& p_entity_id)
+			{
+				record([=](Entitygraph& p_entitygraph)
+				{
+					p_entitygraph.add(p_entitygraph.node(p_parent_id), p_entity_id);
+				});
+			}
+
+			void removeEntity(const std::string& p_entity_id)
+			{
+				record([=](Entitygraph& p_entitygraph)
+				{
+					p_entitygraph.remove(p_entity_id);
+				});
+			}
+
+			void removeSubtree(const std::string& p_entity_id)
+			{
+				record([=](Entitygraph& p_entitygraph)
+				{
+					p_entitygraph.removeSubtree(p_entity_id);
+				});
+			}
+
+			void makeAspect(const std::string& p_entity_id, int p_aspect)
+			{
+				record([=](Entitygraph& p_entitygraph)
+				{
+					p_entitygraph.node(p_entity_id).data()->makeAspect(p_aspect);
+				});
+			}
+
+			void removeAspect(const std::string& p_entity_id, int p_aspect)
+			{
+				record([=](Entitygraph& p_entitygraph)
+				{
+					p_entitygraph.node(p_entity_id).data()->removeAspect(p_aspect);
+				});
+			}
+
+			// purpose is built now, in recording thread
+			template<typename T, class... Args>
+			void addComponent(const std::string& p_entity_id, int p_aspect, const std::string& p_component_id, Args&&... p_args)
+			{
+				record([=, purpose = std::make_unique<T>((std::forward<Args>(p_args))...)](Entitygraph& p_entitygraph) mutable
+				{
+					p_entitygraph.node(p_entity_id).data()->makeAspect(p_aspect).adoptComponent<T>(p_component_id, std::move(purpose));
+				});
+			}
+
+			template<typename T>
+			void removeComponent(const std::string& p_entity_id, int p_aspect, const std::string& p_component_id)
+			{
+				record([=](Entitygraph& p_entitygraph)
+				{
+					p_entitygraph.node(p_entity_id).data()->aspectAccess(p_aspect).removeComponent<T>(p_component_id);
+				});
+			}
+
+			// commands of p_other are moved after this buffer ones
+			void append(CommandBuffer&& p_other);
+
+			// main thread; commands applied in recording order, then buffer is emptied
+			void apply();
+
+			size_t size() const;
+			bool empty() const;
+
+		private:
+
+			struct Command
+			{
+				virtual ~Command() = default;
+				virtual void apply(Entitygraph& p_entitygraph) = 0;
+			};
+
+			template<typename F>
+			struct FuncCommand : public Command
+			{
+				FuncCommand(F&& p_func) : func(std::move(p_func)) {}
+				void apply(Entitygraph& p_entitygraph) override { func(p_entitygraph); }
+
+				F func;
+			};
+
+			Entitygraph*							m_entitygraph{ nullptr };
+			std::vector<std::unique_ptr<Command>>	m_commands;
+
+			template<typename F>
+			void record(F&& p_func)
+			{
+				m_commands.push_back(std::make_unique<FuncCommand<F>>(std::move(p_func)));
+			}
+		};
+	}
+}
@@ -26,6 +26,7 @@
 #pragma once
 
 #include <memory>
+#include <memory_resource>
 #include <vector>
 
 namespace mage
@@ -69,6 +70,11 @@ namespace mage
 				m_purpose = std::make_unique<T>((std::forward<Args>(p_args))...);
 			}
 
+			void setPurpose(ComponentPurpose<T>&& p_purpose)
+			{
+				m_purpose = std::move(p_purpose);
+			}
+
 			T& getPurpose(void) const
 			{
 				return *(m_purpose.get());
@@ -80,5 +86,8 @@ namespace mage
 
 		template<typename T>
 		using ComponentList = std::vector<Component<T>*>;
+
+		template<typename T>
+		using PmrComponentList = std::pmr::vector<Component<T>*>;
 	}
 }
\ No newline at end of file
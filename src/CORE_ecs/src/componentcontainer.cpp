@@ -26,5 +26,5 @@
 #include "componentcontainer.h"
 
 using namespace mage::core;
-int ComponentContainer::m_uid_count{ 0 };
+std::atomic<int> ComponentContainer::m_uid_count{ 0 };
 
@@ -29,10 +29,13 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <memory_resource>
 #include <algorithm>
+#include <atomic>
 
 #include "exceptions.h"
 #include "component.h"
+#include "pool.h"
 
 
 namespace mage
@@ -54,20 +57,31 @@ namespace mage
 			{
 			}
 
-			static int getUIDCount() { return m_uid_count; };
+			static int getUIDCount() { return m_uid_count.load(); };
 
 			template<typename T, class... Args>
 			void addComponent(const std::string& p_id, Args&&... p_args)
+			{
+				if (m_components.count(p_id) > 0)
+				{
+					_EXCEPTION("Component with same id already exists : " + p_id);
+				}
+				adoptComponent<T>(p_id, std::make_unique<T>((std::forward<Args>(p_args))...));
+			}
+
+			// add component with an already built purpose (i.e built by another thread, see CommandBuffer)
+			template<typename T>
+			void adoptComponent(const std::string& p_id, ComponentPurpose<T>&& p_purpose)
 			{
 				if (m_components.count(p_id) > 0)
 				{
 					_EXCEPTION("Component with same id already exists : " + p_id);
 				}
 
-				m_components[p_id] = std::make_shared<Component<T>>();
+				m_components[p_id] = std::allocate_shared<Component<T>>(PoolAllocator<Component<T>>());
 				const auto newcomp { m_components.at(p_id).get()};
 				Component<T>* newcompT{ static_cast<Component<T>*>(newcomp) };
-				newcompT->makePurpose((std::forward<Args>(p_args))...);
+				newcompT->setPurpose(std::move(p_purpose));
 
 				// ajout dans m_components_by_type
 				const auto tid{ typeid(T).hash_code() };
@@ -79,7 +93,7 @@ namespace mage
 
 				//////////////////////////////////////
 
-				newcomp->setUID( m_uid_count++ );
+				newcomp->setUID( m_uid_count.fetch_add(1) );
 			}
 
 			template<typename T>
@@ -107,7 +121,7 @@ namespace mage
 				m_components_type_names.erase(p_id);
 				m_components_type_names_str.erase(p_id);
 			
-				m_uid_count--;				
+				m_uid_count.fetch_sub(1);
 			}
 
 			
@@ -140,6 +154,40 @@ namespace mage
 				return outlist;
 			}
 
+			// same as getComponentsByType(), list allocated from p_resource (i.e core::FrameArena for per-frame lists)
+			template<typename T>
+			PmrComponentList<T> getComponentsByType(std::pmr::memory_resource* p_resource) const
+			{
+				PmrComponentList<T> outlist{ p_resource };
+
+				const auto tid{ typeid(T).hash_code() };
+				const auto it{ m_components_by_type.find(tid) };
+				if (it != m_components_by_type.end())
+				{
+					outlist.reserve(it->second.size());
+					for (const auto& e : it->second)
+					{
+						outlist.push_back(static_cast<Component<T>*>(e));
+					}
+				}
+				return outlist;
+			}
+
+			// same as getComponentsByType() without building a list
+			template<typename T, class Func>
+			void forEachComponentByType(const Func& p_func) const
+			{
+				const auto tid{ typeid(T).hash_code() };
+				const auto it{ m_components_by_type.find(tid) };
+				if (it != m_components_by_type.end())
+				{
+					for (const auto& e : it->second)
+					{
+						p_func(static_cast<Component<T>*>(e));
+					}
+				}
+			}
+
 			const std::unordered_map<std::string, size_t>& getComponentsIdList() const
 			{
 				return m_components_type_names;
@@ -151,7 +199,7 @@ namespace mage
 			}
 			
 		protected:
-			static int															m_uid_count;
+			static std::atomic<int>												m_uid_count;
 
 			// map globale, regroupant les composants par id...
 			std::unordered_map<std::string, std::shared_ptr<ComponentBase>>		m_components;
@@ -29,6 +29,7 @@
 #include "componentcontainer.h"
 #include "st_tree.h"
 #include "entitygraph.h"
+#include "entityhandle.h"
 
 namespace mage
 {
@@ -50,11 +51,16 @@ namespace mage
 
 			~Entity() = default;
 
-			std::string getId() const
+			const std::string& getId() const
 			{
 				return m_id;
 			}
 
+			EntityHandle getHandle() const
+			{
+				return m_handle;
+			}
+
 			ComponentContainer& makeAspect(int p_aspect)
 			{
 				if (m_aspects.count(p_aspect))
@@ -72,7 +78,7 @@ namespace mage
 			{
 				if (m_aspects.count(p_aspect))
 				{
-					m_aspects.at(p_aspect).removeComponent<int>("aspect");
+					m_owner->unregisterEntityFromAspect(this, p_aspect);
 					m_aspects.erase(p_aspect);
 				}
 				else
@@ -115,10 +121,17 @@ namespace mage
 				return m_depth;
 			}
 
+			bool isCommitted() const
+			{
+				return m_committed;
+			}
+
 		private:
 			std::unordered_map<int, ComponentContainer>	m_aspects;
 			const std::string							m_id;
+			EntityHandle								m_handle;
 			int											m_depth{ 0 };
+			bool										m_committed{ false };
 			Entity*										m_parent{ nullptr };
 
 			Entitygraph*								m_owner{ nullptr };
@@ -23,6 +23,7 @@
 /* -*-LIC_END-*- */
 
 #include <iostream>
+#include <vector>
 
 #include "entitygraph.h"
 #include "entity.h"
@@ -37,18 +38,14 @@ Entitygraph::Node& Entitygraph::makeRoot(const std::string& p_entity_id)
 		_EXCEPTION("Entitygraph root already set")
 	}
 
-	m_entites[p_entity_id] = std::make_unique<Entity>(p_entity_id);
-	m_entites.at(p_entity_id)->m_owner = this;
-	m_tree.insert(m_entites.at(p_entity_id).get());
+	const auto entity{ create_entity(p_entity_id, nullptr) };
+	m_tree.insert(entity);
 
 	m_rootNodeName = p_entity_id; // later we can access to root node through (see bellow)
 
-	for (const auto& call : m_callbacks)
-	{
-		call(EntitygraphEvents::ENTITYGRAPHNODE_ADDED, *m_entites.at(p_entity_id).get());
-	}
+	m_slots[entity->m_handle.index].node = &m_tree.root();
 
-	m_nodes[p_entity_id] = &m_tree.root();
+	notify(EntitygraphEvents::ENTITYGRAPHNODE_ADDED, *entity);
 
 	return m_tree.root();
 }
@@ -60,31 +57,25 @@ bool Entitygraph::hasRoot() const
 
 Entitygraph::Node& Entitygraph::add(Node& p_parent, const std::string& p_entity_id)
 {
-	const auto parent_id{ p_parent.data()->getId() };
-
-	if (0 == m_entites.count(parent_id))
+	if (!isValid(p_parent.data()->m_handle))
 	{
-		_EXCEPTION("parent not registered : " + parent_id)
+		_EXCEPTION("parent not registered : " + p_parent.data()->getId())
 	}
 
-	if (m_nodes.count(p_entity_id))
+	if (m_names.count(p_entity_id))
 	{
 		_EXCEPTION("entity already exists : " + p_entity_id);
 	}
 
-	m_entites[p_entity_id] = std::make_unique<Entity>(p_entity_id, p_parent.data());
+	const auto entity{ create_entity(p_entity_id, p_parent.data()) };
 
-	NodeIterator ite_new_node{ p_parent.insert(&*(m_entites[p_entity_id].get())) };
+	NodeIterator ite_new_node{ p_parent.insert(entity) };
 
-	m_nodes[p_entity_id] = &*ite_new_node;
+	m_slots[entity->m_handle.index].node = &*ite_new_node;
 
-	m_entites.at(p_entity_id)->m_depth = p_parent.data()->m_depth + 1;
-	m_entites.at(p_entity_id)->m_owner = this;
+	entity->m_depth = p_parent.data()->m_depth + 1;
 
-	for (const auto& call : m_callbacks)
-	{
-		call(EntitygraphEvents::ENTITYGRAPHNODE_ADDED, *m_entites.at(p_entity_id).get());
-	}
+	notify(EntitygraphEvents::ENTITYGRAPHNODE_ADDED, *entity);
 	return *ite_new_node;
 }
 
@@ -97,111 +88,206 @@ void Entitygraph::remove(Node& p_node)
 		_EXCEPTION("Cant remove entity " + entity.getId() + " : it has children");
 	}
 
-	for (const auto& call : m_callbacks)
+	notify(EntitygraphEvents::ENTITYGRAPHNODE_REMOVED, entity);
+
+	p_node.erase();
+	unregister_entity(&entity);
+}
+
+void Entitygraph::remove(const std::string& p_entity_id)
+{
+	remove(node(p_entity_id));
+}
+
+void Entitygraph::removeSubtree(Node& p_node)
+{
+	// bottom-up : children entities notified before their parent
+	std::vector<Entity*> entities;
+	entities.reserve(p_node.subtree_size());
+	for (auto it = p_node.df_post_begin(); it != p_node.df_post_end(); ++it)
+	{
+		entities.push_back(it->data());
+	}
+
+	for (const auto entity : entities)
 	{
-		call(EntitygraphEvents::ENTITYGRAPHNODE_REMOVED, entity);
+		notify(EntitygraphEvents::ENTITYGRAPHNODE_REMOVED, *entity);
 	}
 
+	notify(EntitygraphEvents::ENTITYGRAPHSUBTREE_REMOVED, *entities.back());
+
+	// whole branch erased at once
 	p_node.erase();
-	const auto id{ entity.getId() };
 
-	m_nodes.erase(id);
-	m_entites.erase(id);
+	for (const auto entity : entities)
+	{
+		unregister_entity(entity);
+	}
+}
 
-	for (auto a_pair : m_entities_by_aspect)
+void Entitygraph::removeSubtree(const std::string& p_entity_id)
+{
+	removeSubtree(node(p_entity_id));
+}
+
+Entity* Entitygraph::create_entity(const std::string& p_entity_id, Entity* p_parent)
+{
+	uint32_t index;
+	if (m_free_slots.size() > 0)
+	{
+		index = m_free_slots.back();
+		m_free_slots.pop_back();
+	}
+	else
 	{
-		mage::core::Entity* entity_ptr{ &entity };
-		std::unordered_set<Entity*> list_ent{ a_pair.second };
+		index = static_cast<uint32_t>(m_slots.size());
+		m_slots.emplace_back();
+	}
 
-		if (list_ent.count(entity_ptr))
-		{
-			m_entities_by_aspect[a_pair.first].erase(const_cast<Entity*>(entity_ptr));
-		}
-	}	
+	Slot& slot{ m_slots[index] };
+	slot.entity = makePooled<Entity>(p_entity_id, p_parent);
+
+	const auto entity{ slot.entity.get() };
+	entity->m_owner = this;
+	entity->m_handle = EntityHandle{ index, slot.generation };
+
+	if ("" != p_entity_id)
+	{
+		m_names[p_entity_id] = entity->m_handle;
+	}
+	m_uncommitted.push_back(entity->m_handle);
+
+	return entity;
 }
 
-void Entitygraph::remove(const std::string& p_entity_id)
+void Entitygraph::unregister_entity(Entity* p_entity)
 {
-	if (!m_nodes.count(p_entity_id))
+	for (auto& a_pair : m_entities_by_aspect)
+	{
+		a_pair.second.erase(p_entity);
+	}
+
+	const auto handle{ p_entity->m_handle };
+	if ("" != p_entity->getId())
 	{
-		_EXCEPTION("unknown entity : " + p_entity_id);
+		m_names.erase(p_entity->getId());
 	}
-	remove(*m_nodes.at(p_entity_id));
+
+	Slot& slot{ m_slots[handle.index] };
+	slot.entity.reset(); // entity deleted here
+	slot.node = nullptr;
+	slot.generation++; // invalidate all handles on this slot
+
+	m_free_slots.push_back(handle.index);
 }
 
-void Entitygraph::move_subtree(Node& p_parent_dest, Node& p_src)
+void Entitygraph::notify(EntitygraphEvents p_event, Entity& p_entity, int p_aspect)
 {
-	st_tree::tree<core::Entity*> temp_tree;
+	for (const auto& call : m_callbacks)
+	{
+		call(p_event, p_entity);
+	}
+
+	m_event_bus.post({ p_event, &p_entity, p_entity.m_handle, p_aspect });
+}
 
-	const auto& entity{ *p_src.data() };
-	const auto entity_id{ entity.getId() };
+void Entitygraph::commit(Node& p_node)
+{
+	commit_entity(p_node.data());
+}
 
-	temp_tree.insert(m_entites.at(entity_id).get());
+void Entitygraph::commit(const std::string& p_entity_id)
+{
+	commit(node(p_entity_id));
+}
 
-	const std::function<void(Node&, Node&)> clone_subtree
+void Entitygraph::commitPending()
+{
+	// index based : a COMMITTED subscriber may add entities
+	for (size_t i = 0; i < m_uncommitted.size(); i++)
 	{
-		[&] (Node& p_src, Node& p_parent_dest)
+		const auto entity{ getEntity(m_uncommitted[i]) };
+		if (entity)
 		{
-			for (auto it = m_tree.df_pre_begin(); it != m_tree.df_pre_end(); ++it)
-			{
-				if (!it->is_root() && it->parent() == p_src) 
-				{
-					const auto& entity{ it->data()};
-					const auto entity_id{ entity->getId() };
-
-					auto new_node{ p_parent_dest.insert(m_entites.at(entity_id).get()) };
-
-					clone_subtree(*it, *new_node);
-				}
-			}
+			commit_entity(entity);
 		}
-	};
+	}
+	m_uncommitted.clear();
+}
+
+void Entitygraph::commit_entity(Entity* p_entity)
+{
+	if (!p_entity->m_committed)
+	{
+		p_entity->m_committed = true;
+		notify(EntitygraphEvents::ENTITYGRAPHNODE_COMMITTED, *p_entity);
+	}
+}
 
-	clone_subtree(p_src, temp_tree.root());
+mage::property::EventBus<EntitygraphEvent>& Entitygraph::getEventBus()
+{
+	return m_event_bus;
+}
 
-	p_src.erase();
-	m_nodes.erase(entity_id);
+void Entitygraph::move_subtree(Node& p_parent_dest, Node& p_src)
+{
+	// nodes are moved, not copied : slots nodes remain valid
+	p_parent_dest.graft(p_src);
 
-	auto new_node{ p_parent_dest.insert(m_entites.at(entity_id).get()) };
-	m_nodes[entity_id] = &*new_node;
-	m_entites.at(entity_id)->m_depth = p_parent_dest.data()->m_depth + 1;
+	const auto entity{ p_src.data() };
+	entity->m_parent = p_parent_dest.data();
+	entity->m_depth = p_parent_dest.data()->m_depth + 1;
 
-	m_entites.at(entity_id)->m_parent = p_parent_dest.data();
-	
-	const std::function<void(Node&, Node&)> restore_subtree
+	for (auto it = p_src.df_pre_begin(); it != p_src.df_pre_end(); ++it)
 	{
-		[&](Node& p_src, Node& p_parent_dest)
+		if (&*it != &p_src)
 		{
-			for (auto it = temp_tree.df_pre_begin(); it != temp_tree.df_pre_end(); ++it)
-			{
-				if (!it->is_root() && it->parent() == p_src)
-				{
-					const auto& entity{ it->data()};
-					const auto entity_id{ entity->getId() };
-
-					auto new_node { p_parent_dest.insert(m_entites.at(entity_id).get()) };
+			it->data()->m_depth = it->parent().data()->m_depth + 1;
+		}
+	}
+}
 
-					m_nodes[entity_id] = &*new_node ;
-					m_entites.at(entity_id)->m_depth = p_parent_dest.data()->m_depth + 1;
+Entitygraph::Node& Entitygraph::node(const std::string& p_entity_id)
+{
+	const auto it{ m_names.find(p_entity_id) };
+	if (it == m_names.end())
+	{
+		_EXCEPTION("node not registered " + p_entity_id)
+	}
+	return (*m_slots[it->second.index].node);
+}
 
-					restore_subtree(*it, *new_node);
-				}
-			}
-		}
-	};
+Entitygraph::Node& Entitygraph::node(EntityHandle p_handle)
+{
+	if (!isValid(p_handle))
+	{
+		_EXCEPTION("node not registered (invalid handle) " + std::to_string(p_handle.index) + "/" + std::to_string(p_handle.generation))
+	}
+	return (*m_slots[p_handle.index].node);
+}
 
-	restore_subtree(temp_tree.root(), *new_node);
+Entity* Entitygraph::getEntity(EntityHandle p_handle) const
+{
+	if (!isValid(p_handle))
+	{
+		return nullptr;
+	}
+	return m_slots[p_handle.index].entity.get();
 }
 
-Entitygraph::Node& Entitygraph::node(const std::string& p_entity_id)
+bool Entitygraph::isValid(EntityHandle p_handle) const
 {
-	const auto id{ p_entity_id };
+	return (p_handle.index < m_slots.size() && m_slots[p_handle.index].generation == p_handle.generation && m_slots[p_handle.index].entity);
+}
 
-	if (0 == m_nodes.count(id))
+EntityHandle Entitygraph::getHandle(const std::string& p_entity_id) const
+{
+	const auto it{ m_names.find(p_entity_id) };
+	if (it == m_names.end())
 	{
-		_EXCEPTION("node not registered " + id)
+		return EntityHandle();
 	}
-	return (*m_nodes.at(id));		
+	return it->second;
 }
 
 Entitygraph::PreIterator Entitygraph::preBegin()
@@ -226,7 +312,7 @@ Entitygraph::PostIterator Entitygraph::postEnd()
 
 bool Entitygraph::hasNode(const std::string& p_entity_id)
 {
-	return (m_nodes.count(p_entity_id) > 0);
+	return (m_names.count(p_entity_id) > 0);
 }
 
 std::unordered_set<Entity*> Entitygraph::getEntitiesListForAspect(int p_aspect)
@@ -241,4 +327,18 @@ std::unordered_set<Entity*> Entitygraph::getEntitiesListForAspect(int p_aspect)
 void Entitygraph::registerEntityInAspect(Entity* p_entity,int p_aspect)
 {
 	m_entities_by_aspect[p_aspect].insert(p_entity);
+
+	if (p_entity->m_committed)
+	{
+		notify(EntitygraphEvents::ENTITYGRAPHNODE_ASPECT_ADDED, *p_entity, p_aspect);
+	}
+}
+
+void Entitygraph::unregisterEntityFromAspect(Entity* p_entity, int p_aspect)
+{
+	const auto it{ m_entities_by_aspect.find(p_aspect) };
+	if (it != m_entities_by_aspect.end())
+	{
+		it->second.erase(p_entity);
+	}
 }
\ No newline at end of file
@@ -27,10 +27,14 @@
 
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <memory>
 #include "st_tree.h"
 #include "eventsource.h"
+#include "eventbus.h"
+#include "pool.h"
+#include "entityhandle.h"
 
 namespace mage
 {
@@ -41,7 +45,19 @@ namespace mage
 		enum class EntitygraphEvents
 		{
 			ENTITYGRAPHNODE_ADDED,
-			ENTITYGRAPHNODE_REMOVED
+			ENTITYGRAPHNODE_REMOVED,
+			ENTITYGRAPHSUBTREE_REMOVED,	// sent by removeSubtree() with branch root, after ENTITYGRAPHNODE_REMOVED for each branch entity
+			ENTITYGRAPHNODE_COMMITTED,	// entity construction done (aspects and components set) : sent once per entity, by commit() or commitPending()
+			ENTITYGRAPHNODE_ASPECT_ADDED	// aspect made on an already committed entity
+		};
+
+		// entitygraph events record, for deferred consumers (see Entitygraph::getEventBus())
+		struct EntitygraphEvent
+		{
+			EntitygraphEvents	type;
+			Entity*				entity{ nullptr };	// removed entities are already deleted when record is drained : use as a key only
+			EntityHandle		handle;
+			int					aspect{ -1 };		// ENTITYGRAPHNODE_ASPECT_ADDED only
 		};
 
 		class Entitygraph : public property::EventSource<EntitygraphEvents, const core::Entity&>
@@ -71,10 +87,21 @@ namespace mage
 			void						remove(Node& p_node);
 			void						remove(const std::string& p_entity_id);
 
+			// remove node and all its descendants
+			void						removeSubtree(Node& p_node);
+			void						removeSubtree(const std::string& p_entity_id);
+
 			Node&						node(const std::string& p_entity_id);
+			Node&						node(EntityHandle p_handle);
 
 			bool						hasNode(const std::string& p_entity_id);
 
+			// nullptr if entity has been removed
+			Entity*						getEntity(EntityHandle p_handle) const;
+			bool						isValid(EntityHandle p_handle) const;
+
+			EntityHandle				getHandle(const std::string& p_entity_id) const;
+
 			PreIterator					preBegin();
 			PreIterator					preEnd();
 
@@ -86,17 +113,48 @@ namespace mage
 			std::unordered_set<Entity*> getEntitiesListForAspect(int p_aspect);
 
 			void						registerEntityInAspect(Entity* p_entity, int p_aspect);
+			void						unregisterEntityFromAspect(Entity* p_entity, int p_aspect);
+
+			// declare entity construction done; entities not explicitly committed are committed by commitPending(),
+			// called by SystemEngine before systems run and after deferred commands are applied (see SystemEngine::commitEntities())
+			void						commit(Node& p_node);
+			void						commit(const std::string& p_entity_id);
+			void						commitPending();
+
+			// same events as subscribers callbacks, recorded to be drained in batches
+			property::EventBus<EntitygraphEvent>&	getEventBus();
 
 		private:
+			struct Slot
+			{
+				PoolPtr<Entity>		entity;
+				Node*				node{ nullptr };
+				uint32_t			generation{ 0 };
+			};
+
 			st_tree::tree<core::Entity*>								m_tree;
-			std::unordered_map<std::string, std::unique_ptr<Entity>>	m_entites;
+
+			// entities storage, indexed by EntityHandle::index
+			std::vector<Slot>											m_slots;
+			std::vector<uint32_t>										m_free_slots;
 
 			Node														m_rootNode;
 			std::string													m_rootNodeName;
 
-			std::unordered_map<std::string, Node*>						m_nodes;
+			// entities ids index; entities created with an empty id are not indexed
+			std::unordered_map<std::string, EntityHandle>				m_names;
 
 			std::unordered_map<int, std::unordered_set<Entity*>>		m_entities_by_aspect;
+
+			property::EventBus<EntitygraphEvent>						m_event_bus;
+
+			// added entities not committed yet, in adding order
+			std::vector<EntityHandle>									m_uncommitted;
+
+			Entity*						create_entity(const std::string& p_entity_id, Entity* p_parent);
+			void						unregister_entity(Entity* p_entity);
+			void						notify(EntitygraphEvents p_event, Entity& p_entity, int p_aspect = -1);
+			void						commit_entity(Entity* p_entity);
 		};
 	}
 }
\ No newline at end of file
@@ -0,0 +1,71 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace mage
+{
+	namespace core
+	{
+		// compact entity reference : slot index in Entitygraph slot map + slot generation, to detect references on removed entities
+		struct EntityHandle
+		{
+			static constexpr uint32_t invalidIndex{ 0xffffffff };
+
+			uint32_t	index{ invalidIndex };
+			uint32_t	generation{ 0 };
+
+			bool isNull() const
+			{
+				return (invalidIndex == index);
+			}
+
+			bool operator==(const EntityHandle& p_other) const
+			{
+				return index == p_other.index && generation == p_other.generation;
+			}
+
+			bool operator!=(const EntityHandle& p_other) const
+			{
+				return !(*this == p_other);
+			}
+		};
+	}
+}
+
+namespace std
+{
+	template<>
+	struct hash<mage::core::EntityHandle>
+	{
+		size_t operator()(const mage::core::EntityHandle& p_handle) const
+		{
+			return std::hash<uint64_t>()((static_cast<uint64_t>(p_handle.generation) << 32) | p_handle.index);
+		}
+	};
+}
@@ -22,39 +22,144 @@
 */
 /* -*-LIC_END-*- */
 
-#include <chrono>
+#include <algorithm>
 #include <string>
 
 #include "sysengine.h"
+#include "entitygraph.h"
+#include "profiler.h"
 
 #include "datacloud.h"
+#include "framearena.h"
 
 using namespace mage::core;
 
 
 SystemEngine::SystemEngine()
 {
+	profiler::Profiler::getInstance()->setThreadName("main");
+
 	const auto dataCloud{ mage::rendering::Datacloud::getInstance() };
-	dataCloud->registerData<std::string>("mage.timings.systemengine");
+	dataCloud->registerData<double>("mage.timings.estimated_fps");
 }
 
 void SystemEngine::run()
 {
-	const auto start_time{ std::chrono::high_resolution_clock::now() };
+	{
+		_MAGE_PROFILE_ZONE("systemengine");
+
+		if (m_schedule_dirty)
+		{
+			buildSchedule();
+		}
+
+		// entities built by application since last frame
+		commitEntities();
+
+		m_scheduler.run();
+
+		applyCommands();
+
+		// per-frame lists allocated by systems are no longer used
+		FrameArena::getInstance()->reset();
+	}
+
+	profiler::Profiler::getInstance()->endFrame();
+	publishTimings();
+}
+
+void SystemEngine::setWorkersCount(int p_count)
+{
+	m_scheduler.setWorkersCount(p_count);
+}
+
+std::vector<int> SystemEngine::getDependencies(int p_executionslot)
+{
+	if (m_schedule_dirty)
+	{
+		buildSchedule();
+	}
+	return m_scheduler.getDependencies(p_executionslot);
+}
 
+void SystemEngine::submitCommands(CommandBuffer&& p_commands)
+{
+	std::unique_lock<std::mutex> lock(m_submitted_commands_mutex);
+	m_submitted_commands.push_back(std::move(p_commands));
+}
+
+void SystemEngine::applyCommands()
+{
+	_MAGE_PROFILE_ZONE("systemengine.commands");
+
+	// sync point : all systems are done
 	for (auto& system : m_systems)
 	{
-		system.second.get()->run();
+		system.second->m_commands.apply();
+	}
+
+	std::vector<CommandBuffer> submitted_commands;
+	{
+		std::unique_lock<std::mutex> lock(m_submitted_commands_mutex);
+		submitted_commands.swap(m_submitted_commands);
+	}
+
+	for (auto& commands : submitted_commands)
+	{
+		commands.apply();
+	}
+
+	commitEntities();
+}
+
+void SystemEngine::commitEntities()
+{
+	for (const auto entitygraph : m_entitygraphs)
+	{
+		entitygraph->commitPending();
 	}
+}
 
-	const auto end_time{ std::chrono::high_resolution_clock::now() };
-	const auto duration{ std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time) };
+void SystemEngine::buildSchedule()
+{
+	std::vector<std::pair<int, System*>> systems;
+	m_entitygraphs.clear();
+	for (auto& system : m_systems)
+	{
+		systems.emplace_back(system.first, system.second.get());
 
-	// estimated fps
-	const int estimated_fps = 1000 / duration.count();
+		const auto entitygraph{ &system.second->m_entitygraph };
+		if (std::find(m_entitygraphs.begin(), m_entitygraphs.end(), entitygraph) == m_entitygraphs.end())
+		{
+			m_entitygraphs.push_back(entitygraph);
+		}
+	}
+	m_scheduler.build(systems);
+	m_schedule_dirty = false;
+}
 
+void SystemEngine::publishTimings()
+{
+	const auto profilerInstance{ profiler::Profiler::getInstance() };
 	const auto dataCloud{ mage::rendering::Datacloud::getInstance() };
-	dataCloud->updateDataValue<std::string>("mage.timings.systemengine", std::to_string(duration.count()) + " ms, estimated fps = " + std::to_string(estimated_fps));
+
+	for (const auto& e : profilerInstance->getZonesStats())
+	{
+		const std::string var_id{ "mage.timings." + e.first };
+		if (!m_published_timings.count(e.first))
+		{
+			dataCloud->registerData<profiler::ZoneStats>(var_id);
+			m_published_timings.insert(e.first);
+		}
+		dataCloud->updateDataValue<profiler::ZoneStats>(var_id, e.second);
+	}
+
+	// estimated fps, from full frame duration (between two endFrame() calls)
+	const auto frame_stats{ profilerInstance->getFrameStats() };
+	if (frame_stats.avg_ms > 0.0)
+	{
+		dataCloud->updateDataValue<double>("mage.timings.estimated_fps", 1000.0 / frame_stats.avg_ms);
+	}
 }
 
 System* SystemEngine::getSystem(int p_executionslot) const
@@ -26,10 +26,15 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
 
 #include "eventsource.h"
 #include "singleton.h"
 #include "system.h"
+#include "systemscheduler.h"
 #include "exceptions.h"
 
 namespace mage
@@ -58,9 +63,33 @@ namespace mage
 			template<typename T>
 			T* getSystem(int p_executionslot) const;
 
+			// 0 : all systems run on main thread in slot order
+			void setWorkersCount(int p_count);
+
+			// slots of systems that must complete before p_executionslot runs
+			std::vector<int> getDependencies(int p_executionslot);
+
+			// any thread; applied at end of run(), after systems own buffers (in slot order), in submission order
+			void submitCommands(CommandBuffer&& p_commands);
+
 
 		private:
 			std::map<int, std::unique_ptr<core::System>> m_systems;
+
+			std::set<std::string>						m_published_timings; // profiler zones already registered in datacloud
+
+			SystemScheduler								m_scheduler;
+			bool										m_schedule_dirty{ true };
+			std::vector<Entitygraph*>					m_entitygraphs; // distinct graphs of systems, collected with schedule
+
+			std::mutex									m_submitted_commands_mutex;
+			std::vector<CommandBuffer>					m_submitted_commands;
+
+			void buildSchedule();
+			void applyCommands();
+			void commitEntities();
+
+			void publishTimings();
 		};
 
 
@@ -72,6 +101,7 @@ namespace mage
 			if (!place.second) {
 				_EXCEPTION("system already registered for this slot : " + std::to_string(p_executionslot))
 			}
+			m_schedule_dirty = true;
 
 			for (const auto& call : m_callbacks)
 			{
@@ -28,6 +28,67 @@
 using namespace mage::core;
 
 System::System(Entitygraph& p_entitygraph) :
-m_entitygraph(p_entitygraph)
+m_entitygraph(p_entitygraph),
+m_commands(p_entitygraph)
 {
 }
+
+bool System::isDeclared() const
+{
+	return m_accesses.size() > 0;
+}
+
+bool System::isMainThreadOnly() const
+{
+	return m_main_thread_only;
+}
+
+bool System::isExclusive() const
+{
+	return m_exclusive;
+}
+
+void System::declareAccess(int p_aspect, SystemAccess p_access, const std::string& p_component_id)
+{
+	auto& access{ m_accesses[std::make_pair(p_aspect, p_component_id)] };
+	if (SystemAccess::WRITE == p_access)
+	{
+		access = SystemAccess::WRITE;
+	}
+}
+
+void System::declareMainThreadOnly()
+{
+	m_main_thread_only = true;
+}
+
+void System::declareExclusive()
+{
+	m_exclusive = true;
+}
+
+bool System::conflictsWith(const System& p_other) const
+{
+	if (!isDeclared() || !p_other.isDeclared() || m_exclusive || p_other.m_exclusive)
+	{
+		return true;
+	}
+
+	for (const auto& a : m_accesses)
+	{
+		for (const auto& b : p_other.m_accesses)
+		{
+			if (a.first.first != b.first.first)
+			{
+				continue;
+			}
+
+			const bool same_data{ a.first.second.empty() || b.first.second.empty() || a.first.second == b.first.second };
+			if (same_data && (SystemAccess::WRITE == a.second || SystemAccess::WRITE == b.second))
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
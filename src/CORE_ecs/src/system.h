@@ -25,12 +25,20 @@
 
 #pragma once
 
+#include <map>
+#include <string>
+
+#include "commandbuffer.h"
+
 namespace mage
 {
 	namespace core
 	{
-		// fwd decl
-		class Entitygraph;
+		enum class SystemAccess
+		{
+			READ,
+			WRITE
+		};
 
 		class System
 		{
@@ -40,9 +48,38 @@ namespace mage
 			~System() = default;
 
 			virtual void run() = 0;
+
+			// data accesses declared by the system, used by SystemEngine scheduler to run independent systems concurrently
+			// a system that declares nothing is considered to touch everything : it never runs concurrently with another one
+			bool isDeclared() const;
+			bool isMainThreadOnly() const;
+			bool isExclusive() const;
+
+			bool conflictsWith(const System& p_other) const;
 		
 		protected:
 			Entitygraph&	m_entitygraph;
+
+			// deferred structural changes, applied by SystemEngine once all systems have run
+			CommandBuffer	m_commands;
+
+			// empty component id means the whole aspect
+			void declareAccess(int p_aspect, SystemAccess p_access, const std::string& p_component_id = "");
+
+			// run() (and callbacks it triggers) must execute on main thread
+			void declareMainThreadOnly();
+
+			// run() may change graph structure or dispatch application callbacks (which can) : never runs concurrently with another system
+			void declareExclusive();
+
+		private:
+			using AccessKey = std::pair<int, std::string>;
+
+			std::map<AccessKey, SystemAccess>	m_accesses;
+			bool								m_main_thread_only{ false };
+			bool								m_exclusive{ false };
+
+			friend class SystemEngine;
 		};
 	}
 }
@@ -0,0 +1,242 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#include <string>
+
+#include "systemscheduler.h"
+#include "system.h"
+#include "profiler.h"
+
+using namespace mage::core;
+
+SystemScheduler::~SystemScheduler()
+{
+	stopWorkers();
+}
+
+void SystemScheduler::setWorkersCount(int p_count)
+{
+	stopWorkers();
+
+	for (int i = 0; i < p_count; i++)
+	{
+		m_workers.emplace_back(&SystemScheduler::workerLoop, this, i);
+	}
+}
+
+int SystemScheduler::getWorkersCount() const
+{
+	return static_cast<int>(m_workers.size());
+}
+
+void SystemScheduler::stopWorkers()
+{
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_exit = true;
+	}
+	m_cv.notify_all();
+
+	for (auto& worker : m_workers)
+	{
+		worker.join();
+	}
+	m_workers.clear();
+	m_exit = false;
+}
+
+void SystemScheduler::build(const std::vector<std::pair<int, System*>>& p_systems)
+{
+	const auto profiler{ profiler::Profiler::getInstance() };
+
+	m_tasks.clear();
+	m_tasks.resize(p_systems.size());
+
+	for (size_t i = 0; i < p_systems.size(); i++)
+	{
+		Task& task{ m_tasks[i] };
+		task.slot = p_systems[i].first;
+		task.system = p_systems[i].second;
+		task.zone_name = profiler->intern("systemengine.slot_" + std::to_string(task.slot));
+
+		for (size_t j = 0; j < i; j++)
+		{
+			if (task.system->conflictsWith(*m_tasks[j].system))
+			{
+				m_tasks[j].successors.push_back(i);
+				task.nb_predecessors++;
+			}
+		}
+	}
+}
+
+std::vector<int> SystemScheduler::getDependencies(int p_slot) const
+{
+	std::vector<int> dependencies;
+	for (size_t i = 0; i < m_tasks.size(); i++)
+	{
+		if (m_tasks[i].slot != p_slot)
+		{
+			continue;
+		}
+		for (const auto& task : m_tasks)
+		{
+			for (const auto successor : task.successors)
+			{
+				if (successor == i)
+				{
+					dependencies.push_back(task.slot);
+				}
+			}
+		}
+	}
+	return dependencies;
+}
+
+void SystemScheduler::run()
+{
+	if (0 == m_workers.size())
+	{
+		// deterministic fallback : slot order, on main thread
+		for (auto& task : m_tasks)
+		{
+			const profiler::ScopedZone zone{ task.zone_name };
+			task.system->run();
+		}
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	m_error = nullptr;
+	m_remaining = m_tasks.size();
+	for (size_t i = 0; i < m_tasks.size(); i++)
+	{
+		m_tasks[i].pending = m_tasks[i].nb_predecessors;
+		if (0 == m_tasks[i].pending)
+		{
+			pushReady(i);
+		}
+	}
+	m_cv.notify_all();
+
+	while (m_remaining > 0)
+	{
+		m_cv.wait(lock, [this] { return m_ready_main.size() > 0 || m_ready.size() > 0 || 0 == m_remaining; });
+		if (0 == m_remaining)
+		{
+			break;
+		}
+
+		std::deque<size_t>& queue{ m_ready_main.size() > 0 ? m_ready_main : m_ready };
+		const size_t index{ queue.front() };
+		queue.pop_front();
+
+		const bool skip{ m_error != nullptr };
+		lock.unlock();
+		if (!skip)
+		{
+			execute(m_tasks[index]);
+		}
+		lock.lock();
+		complete(index);
+	}
+
+	if (m_error)
+	{
+		const auto error{ m_error };
+		m_error = nullptr;
+		std::rethrow_exception(error);
+	}
+}
+
+void SystemScheduler::workerLoop(int p_index)
+{
+	profiler::Profiler::getInstance()->setThreadName("system_worker_" + std::to_string(p_index));
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true)
+	{
+		m_cv.wait(lock, [this] { return m_ready.size() > 0 || m_exit; });
+		if (m_exit)
+		{
+			break;
+		}
+
+		const size_t index{ m_ready.front() };
+		m_ready.pop_front();
+
+		const bool skip{ m_error != nullptr };
+		lock.unlock();
+		if (!skip)
+		{
+			execute(m_tasks[index]);
+		}
+		lock.lock();
+		complete(index);
+	}
+}
+
+void SystemScheduler::execute(Task& p_task)
+{
+	try
+	{
+		const profiler::ScopedZone zone{ p_task.zone_name };
+		p_task.system->run();
+	}
+	catch (...)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (!m_error)
+		{
+			m_error = std::current_exception();
+		}
+	}
+}
+
+void SystemScheduler::complete(size_t p_task)
+{
+	m_remaining--;
+	for (const auto successor : m_tasks[p_task].successors)
+	{
+		if (0 == --m_tasks[successor].pending)
+		{
+			pushReady(successor);
+		}
+	}
+	m_cv.notify_all();
+}
+
+void SystemScheduler::pushReady(size_t p_task)
+{
+	if (m_tasks[p_task].system->isMainThreadOnly())
+	{
+		m_ready_main.push_back(p_task);
+	}
+	else
+	{
+		m_ready.push_back(p_task);
+	}
+}
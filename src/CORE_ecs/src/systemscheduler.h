@@ -0,0 +1,99 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mage
+{
+	namespace core
+	{
+		// fwd decl
+		class System;
+
+		// runs systems of a frame as a DAG : a system depends on every lower slot system it conflicts with (see System::conflictsWith)
+		// independent systems run concurrently on worker threads, main thread takes part and is the only one to run main-thread-only systems
+		// with no workers, systems run sequentially in slot order
+		class SystemScheduler
+		{
+		public:
+			SystemScheduler() = default;
+			~SystemScheduler();
+
+			SystemScheduler(const SystemScheduler&) = delete;
+			SystemScheduler& operator=(const SystemScheduler&) = delete;
+
+			void setWorkersCount(int p_count);
+			int	 getWorkersCount() const;
+
+			// p_systems ordered by execution slot
+			void build(const std::vector<std::pair<int, System*>>& p_systems);
+
+			// main thread, once per frame; rethrows first exception raised by a system
+			void run();
+
+			// slots of systems p_slot waits for
+			std::vector<int> getDependencies(int p_slot) const;
+
+		private:
+
+			struct Task
+			{
+				int					slot{ -1 };
+				System*				system{ nullptr };
+				const char*			zone_name{ nullptr };
+
+				std::vector<size_t>	successors;
+				int					nb_predecessors{ 0 };
+				int					pending{ 0 }; // m_mutex
+			};
+
+			std::vector<Task>			m_tasks;
+
+			std::vector<std::thread>	m_workers;
+
+			std::mutex					m_mutex;
+			std::condition_variable		m_cv;
+			std::deque<size_t>			m_ready;
+			std::deque<size_t>			m_ready_main;
+			size_t						m_remaining{ 0 };
+			bool						m_exit{ false };
+			std::exception_ptr			m_error;
+
+			void stopWorkers();
+			void workerLoop(int p_index);
+
+			void execute(Task& p_task);
+			void complete(size_t p_task); // m_mutex locked
+			void pushReady(size_t p_task); // m_mutex locked
+		};
+	}
+}
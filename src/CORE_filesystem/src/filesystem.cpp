@@ -73,3 +73,42 @@ std::pair<std::string, std::string> fileSystem::splitPath(const std::string& p_p
     return std::make_pair(folder, fn);
 }
 
+
+std::shared_ptr<void> fileSystem::mapFile(const std::string& p_path, size_t& p_size)
+{
+    const HANDLE file{ ::CreateFile(p_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+    if (INVALID_HANDLE_VALUE == file)
+    {
+        _EXCEPTION("Cannot open " + p_path);
+    }
+
+    LARGE_INTEGER size;
+    if (!::GetFileSizeEx(file, &size))
+    {
+        ::CloseHandle(file);
+        _EXCEPTION("Cannot get size of " + p_path);
+    }
+
+    p_size = static_cast<size_t>(size.QuadPart);
+    if (0 == p_size)
+    {
+        ::CloseHandle(file);
+        return nullptr;
+    }
+
+    const HANDLE mapping{ ::CreateFileMapping(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr) };
+    ::CloseHandle(file);
+    if (nullptr == mapping)
+    {
+        _EXCEPTION("Cannot map " + p_path);
+    }
+
+    void* view{ ::MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0) };
+    ::CloseHandle(mapping);
+    if (nullptr == view)
+    {
+        _EXCEPTION("Cannot map view of " + p_path);
+    }
+
+    return std::shared_ptr<void>(view, [](void* p_view) { ::UnmapViewOfFile(p_view); });
+}
@@ -46,6 +46,9 @@ namespace mage
             long fileSize(FILE* p_fp);
             std::pair<std::string, std::string> splitFilename(const std::string& p_filename);
             std::pair<std::string, std::string> splitPath(const std::string& p_path);
+
+            // read-only view on whole file content, unmapped when last reference is dropped
+            std::shared_ptr<void> mapFile(const std::string& p_path, size_t& p_size);
         }
 
         template<typename T>
@@ -54,36 +57,12 @@ namespace mage
         public:
 
             FileContent() = delete;
-            
-            FileContent(const FileContent& p_other)
-            {
-                if (p_other.isEmpty())
-                {
-                    return;
-                }
-
-                m_data.release();
-                m_data = std::make_unique<T[]>(p_other.m_dataSize);
-                memcpy((void*)m_data.get(), p_other.m_data.get(), p_other.m_dataSize * sizeof(T));
-                m_dataSize = p_other.m_dataSize;
-            }
-
-            FileContent(FileContent&&) = delete;
 
+            FileContent(const FileContent&) = default;
+            FileContent(FileContent&&) = default;
 
-            FileContent& operator=(const FileContent& p_other)
-            {
-                if (p_other.isEmpty())
-                {
-                    return *this;
-                }
-                m_data.release();
-                m_data = std::make_unique<T[]>(p_other.m_dataSize);
-                memcpy((void*)m_data.get(), p_other.m_data.get(), p_other.m_dataSize * sizeof(T));
-                m_dataSize = p_other.m_dataSize;
-
-                return *this;
-            }
+            FileContent& operator=(const FileContent&) = default;
+            FileContent& operator=(FileContent&&) = default;
 
             FileContent(const std::string& p_path) :
             m_path(p_path)
@@ -98,16 +77,12 @@ namespace mage
                 if (fp)
                 {
                     const auto fs{ fileSystem::fileSize(fp)};
-                 
-                    m_data.release();
-                    m_data = std::make_unique<T[]>(fs);
-                    
-                    auto dstPtr{ m_data.get() };
 
-                    ::fread((void*)dstPtr, sizeof(T), fs, fp);
+                    std::unique_ptr<T[]> data{ std::make_unique<T[]>(fs) };
+                    ::fread((void*)data.get(), sizeof(T), fs, fp);
                     ::fclose(fp);
 
-                    m_dataSize = fs;
+                    m_data = Buffer<T>::adopt(std::move(data), fs);
                 }
                 else
                 {
@@ -153,7 +128,7 @@ namespace mage
                 {
                     if (!isEmpty())
                     {
-                        ::fwrite(m_data.get(), m_dataSize, sizeof(T), fp);
+                        ::fwrite(m_data.getData(), m_data.getDataSize(), sizeof(T), fp);
                     }
                     ::fclose(fp);
                 }
@@ -163,14 +138,29 @@ namespace mage
                 }
             }
           
+            // map file in memory instead of reading it (pages are copy-on-write : file is never modified)
+            void map(void)
+            {
+                size_t size{ 0 };
+                const std::shared_ptr<void> view{ fileSystem::mapFile(m_path, size) };
+
+                m_data = Buffer<T>::adopt(static_cast<T*>(view.get()), size / sizeof(T), [view](T*) {});
+            }
+
             T* getData(void) const
             {
-                return m_data.get();
+                return m_data.getData();
             }
 
             size_t getDataSize(void) const
             {
-                return m_dataSize;
+                return m_data.getDataSize();
+            }
+
+            // content shared without copy
+            const Buffer<T>& getBuffer(void) const
+            {
+                return m_data;
             }
 
             std::string getPath() const
@@ -180,25 +170,24 @@ namespace mage
 
             bool isEmpty() const
             {
-                return (m_data.get() == nullptr);
+                return m_data.isEmpty();
             }
 
             void cloneDataTo(Buffer<T>& p_buffer)
             {
-                p_buffer.fill(m_data.get(), m_dataSize);
+                p_buffer = m_data;
             }
 
             void cloneDataFrom(const Buffer<T>& p_buffer)
             {
-                // TODO
+                m_data = p_buffer;
             }
 
 
         private:
 
             std::string             m_path;
-            std::unique_ptr<T[]>    m_data;
-            size_t                  m_dataSize{ 0 };
+            Buffer<T>               m_data;
 
         };
     }
@@ -27,6 +27,7 @@
 
 #include "logoutput.h"
 #include "logoutputfile.h"
+#include "logoutputasync.h"
 #include "exceptions.h"
 
 using namespace mage::core;
@@ -74,7 +75,14 @@ void logger::Configuration::applyConfiguration(const std::string& p_jsondata)
     {
         if ("file" == output.type)
         {
-            m_outputs[output.id] = std::make_unique<OutputFile>(output.path);
+            if (output.async)
+            {
+                m_outputs[output.id] = std::make_unique<OutputAsync>(std::make_unique<OutputFile>(output.path));
+            }
+            else
+            {
+                m_outputs[output.id] = std::make_unique<OutputFile>(output.path);
+            }
             const auto& of{ m_outputs.at(output.id) };
             of.get()->setFlushPeriod(0);
         }
@@ -122,4 +130,14 @@ void logger::Configuration::applyConfiguration(const std::string& p_jsondata)
             m_sinks_infos[logger.source] = std::make_tuple(nullptr, logger_state, logger_level, output);
         }
     }
-}
\ No newline at end of file
+}
+
+uint64_t logger::Configuration::getDroppedRecordsCount(void) const
+{
+    uint64_t count{ 0 };
+    for (const auto& e : m_outputs)
+    {
+        count += e.second->getDroppedCount();
+    }
+    return count;
+}
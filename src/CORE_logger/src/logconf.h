@@ -44,8 +44,9 @@ namespace mage
             std::string type;
             std::string id;
             std::string path;
+            bool        async{ false };
 
-            JS_OBJ(type, id, path);
+            JS_OBJ(type, id, path, async);
         };
 
         struct Logger
@@ -86,6 +87,9 @@ namespace mage
                 LONGLONG    getLastTick(void) const;
                 void        applyConfiguration(const std::string& p_jsondata);
 
+                // records lost by async outputs
+                uint64_t    getDroppedRecordsCount(void) const;
+
             private:
 
                 //Json<>::Callback	                                                m_cb;
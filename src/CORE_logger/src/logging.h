@@ -28,11 +28,14 @@
 #include <string>
 #include "logconf.h"
 
-#define _MAGE_TRACE( _logger, _message ) _logger.logIt( mage::core::logger::Sink::Level::LEVEL_TRACE, std::string(__FUNCTION__) + std::string( " " ) + _message );
-#define _MAGE_DEBUG( _logger, _message ) _logger.logIt( mage::core::logger::Sink::Level::LEVEL_DEBUG, std::string(__FUNCTION__) + std::string( " " ) + _message );
-#define _MAGE_WARN( _logger, _message )  _logger.logIt( mage::core::logger::Sink::Level::LEVEL_WARN, std::string(__FUNCTION__) + std::string( " " ) + _message );
-#define _MAGE_ERROR( _logger, _message ) _logger.logIt( mage::core::logger::Sink::Level::LEVEL_ERROR, std::string(__FUNCTION__) + std::string( " " ) + _message );
-#define _MAGE_FATAL( _logger, _message ) _logger.logIt( mage::core::logger::Sink::Level::LEVEL_FATAL, std::string(__FUNCTION__) + std::string( " " ) + _message );
+// level checked before message building : disabled traces cost only a test
+#define _MAGE_LOG( _logger, _level, _message ) do { auto& _mage_log_sink{ _logger }; if (_mage_log_sink.isEnabled(_level)) { _mage_log_sink.logIt(_level, std::string(__FUNCTION__) + std::string( " " ) + _message); } } while (0)
+
+#define _MAGE_TRACE( _logger, _message ) _MAGE_LOG( _logger, mage::core::logger::Sink::Level::LEVEL_TRACE, _message )
+#define _MAGE_DEBUG( _logger, _message ) _MAGE_LOG( _logger, mage::core::logger::Sink::Level::LEVEL_DEBUG, _message )
+#define _MAGE_WARN( _logger, _message )  _MAGE_LOG( _logger, mage::core::logger::Sink::Level::LEVEL_WARN, _message )
+#define _MAGE_ERROR( _logger, _message ) _MAGE_LOG( _logger, mage::core::logger::Sink::Level::LEVEL_ERROR, _message )
+#define _MAGE_FATAL( _logger, _message ) _MAGE_LOG( _logger, mage::core::logger::Sink::Level::LEVEL_FATAL, _message )
 
 std::string operator<< (const std::string& p_s1, const std::string& p_s2);
 std::string operator<< (const std::string& p_s1, const char* p_s2);
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <string>
+#include <cstdint>
 
 namespace mage
 {
@@ -36,10 +37,13 @@ namespace mage
             {
             public:
                 Output() = default;
-                ~Output() = default;
+                virtual ~Output() = default;
 
                 virtual void logIt(const std::string& p_trace) = 0;
                 virtual void setFlushPeriod(long p_period) = 0;
+
+                // records lost by this output (async outputs only)
+                virtual uint64_t getDroppedCount() const { return 0; };
             };
         }
     }
@@ -0,0 +1,149 @@
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#include <chrono>
+
+#include "logoutputasync.h"
+
+using namespace mage::core;
+
+logger::OutputAsync::OutputAsync( std::unique_ptr<Output> p_target ) :
+m_target( std::move( p_target ) ),
+m_cells( std::make_unique<Cell[]>( capacity ) )
+{
+    for( size_t i = 0; i < capacity; i++ )
+    {
+        m_cells[i].sequence.store( i, std::memory_order_relaxed );
+    }
+
+    m_writer = std::thread( &OutputAsync::writerLoop, this );
+}
+
+logger::OutputAsync::~OutputAsync( void )
+{
+    m_stop.store( true, std::memory_order_release );
+    m_writer.join();
+}
+
+void logger::OutputAsync::logIt( const std::string& p_trace )
+{
+    // bounded MPSC queue (D. Vyukov) : producers claim a cell by CAS on enqueue position
+    size_t pos{ m_enqueue_pos.load( std::memory_order_relaxed ) };
+    Cell* cell{ nullptr };
+
+    for( ;; )
+    {
+        cell = &m_cells[pos & ( capacity - 1 )];
+        const size_t seq{ cell->sequence.load( std::memory_order_acquire ) };
+        const auto diff{ static_cast<intptr_t>( seq ) - static_cast<intptr_t>( pos ) };
+
+        if( 0 == diff )
+        {
+            if( m_enqueue_pos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+            {
+                break;
+            }
+        }
+        else if( diff < 0 )
+        {
+            // full
+            m_dropped.fetch_add( 1, std::memory_order_relaxed );
+            return;
+        }
+        else
+        {
+            pos = m_enqueue_pos.load( std::memory_order_relaxed );
+        }
+    }
+
+    cell->trace = p_trace;
+    cell->sequence.store( pos + 1, std::memory_order_release );
+}
+
+bool logger::OutputAsync::pop( std::string& p_trace )
+{
+    Cell& cell{ m_cells[m_dequeue_pos & ( capacity - 1 )] };
+    const size_t seq{ cell.sequence.load( std::memory_order_acquire ) };
+
+    if( seq != m_dequeue_pos + 1 )
+    {
+        return false;
+    }
+
+    p_trace.swap( cell.trace );
+    cell.sequence.store( m_dequeue_pos + capacity, std::memory_order_release );
+    m_dequeue_pos++;
+
+    return true;
+}
+
+void logger::OutputAsync::writerLoop( void )
+{
+    std::string batch;
+    std::string trace;
+
+    for( ;; )
+    {
+        // read stop flag before draining : records pushed before stop request are written
+        const bool stop{ m_stop.load( std::memory_order_acquire ) };
+
+        size_t count{ 0 };
+        while( count < maxBatchRecords && pop( trace ) )
+        {
+            batch += trace;
+            count++;
+        }
+
+        if( count > 0 )
+        {
+            m_target->logIt( batch );
+            batch.clear();
+            m_written.fetch_add( count, std::memory_order_relaxed );
+        }
+        else if( stop )
+        {
+            break;
+        }
+        else
+        {
+            std::this_thread::sleep_for( std::chrono::milliseconds( idle_duration_ms ) );
+        }
+    }
+}
+
+void logger::OutputAsync::setFlushPeriod( long p_period )
+{
+    // target is flushed at most once per batch
+    m_target->setFlushPeriod( p_period );
+}
+
+uint64_t logger::OutputAsync::getDroppedCount( void ) const
+{
+    return m_dropped.load( std::memory_order_relaxed );
+}
+
+uint64_t logger::OutputAsync::getWrittenCount( void ) const
+{
+    return m_written.load( std::memory_order_relaxed );
+}
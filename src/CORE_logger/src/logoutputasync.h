@@ -0,0 +1,91 @@
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "logoutput.h"
+
+namespace mage
+{
+    namespace core
+    {
+        namespace logger
+        {
+            // wraps an output : records are pushed in a lock-free bounded MPSC ring
+            // and written by a dedicated thread, in batches
+            class OutputAsync : public Output
+            {
+            public:
+
+                static constexpr size_t capacity{ 8192 }; // must be a power of 2
+                static constexpr size_t maxBatchRecords{ 256 };
+
+                OutputAsync(std::unique_ptr<Output> p_target);
+
+                OutputAsync() = delete;
+                OutputAsync(const OutputAsync&) = delete;
+                OutputAsync(OutputAsync&&) = delete;
+                OutputAsync& operator=(const OutputAsync& t) = delete;
+
+                ~OutputAsync(void);
+
+                // never blocks : record is dropped if ring is full
+                void logIt(const std::string& p_trace);
+                void setFlushPeriod(long p_period);
+
+                uint64_t getDroppedCount() const;
+                uint64_t getWrittenCount() const;
+
+            private:
+
+                struct Cell
+                {
+                    std::atomic<size_t>                     sequence;
+                    std::string                             trace;
+                };
+
+                std::unique_ptr<Output>                     m_target;
+
+                std::unique_ptr<Cell[]>                     m_cells;
+                std::atomic<size_t>                         m_enqueue_pos{ 0 };
+                size_t                                      m_dequeue_pos{ 0 }; // writer thread only
+
+                std::atomic<uint64_t>                       m_dropped{ 0 };
+                std::atomic<uint64_t>                       m_written{ 0 };
+
+                std::atomic<bool>                           m_stop{ false };
+                std::thread                                 m_writer;
+
+                static constexpr unsigned int               idle_duration_ms{ 2 };
+
+                bool pop(std::string& p_trace);
+                void writerLoop();
+            };
+        }
+    }
+}
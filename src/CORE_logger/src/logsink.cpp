@@ -22,9 +22,7 @@
 */
 /* -*-LIC_END-*- */
 
-#include <sstream>
-#include <iomanip> // setprecision
-#include <unordered_map>
+#include <cstdio>
 
 #include "logsink.h"
 #include "logconf.h"
@@ -53,40 +51,28 @@ void logger::Sink::setState( bool p_state )
 
 void logger::Sink::logIt( Level p_level, const std::string& p_trace )
 {
-    if( p_level <= m_current_level && m_state && m_output )
+    if( isEnabled( p_level ) )
     {        
-        static const std::unordered_map<Level, std::string> lvl_to_string
-        {
-            { Level::LEVEL_FATAL, "FATAL"},
-            { Level::LEVEL_ERROR, "ERROR"},
-            { Level::LEVEL_WARN, "WARN"},
-            { Level::LEVEL_DEBUG, "DEBUG"},
-            { Level::LEVEL_TRACE, "TRACE"},
-
-        };
+        static const char* lvl_to_string[]{ "FATAL", "ERROR", "WARN", "DEBUG", "TRACE" };
 
-        const auto level{ lvl_to_string.at(p_level) };
-       
-        std::stringstream stream;
-        stream << std::hex << GetCurrentThreadId();
-        const std::string thread_id( std::string("[" ) + stream.str() + std::string("]"));
+        const char* level{ lvl_to_string[static_cast<int>(p_level)] };
 
-        std::string timestamp;
+        // timestamp and thread id
+        char header[64];
         if( m_conf )
         {
-            
             const auto timestamp_in_second{ m_conf->getLastTick() / 1000.0 };
-            constexpr auto precision{ 3 };
-            std::stringstream stream;
-            stream << std::fixed << std::setprecision(precision) << timestamp_in_second;
-            timestamp = stream.str();
+            snprintf( header, sizeof( header ), "%.3f [%lx] ", timestamp_in_second, static_cast<unsigned long>( GetCurrentThreadId() ) );
         }
         else
         {
-            timestamp = "??????????";            
+            snprintf( header, sizeof( header ), "?????????? [%lx] ", static_cast<unsigned long>( GetCurrentThreadId() ) );
         }
 
-        std::string final_trace = timestamp + std::string( " " ) + thread_id + std::string( " " ) + m_name + std::string( " " ) + level + std::string( " " ) + std::string( "[ " ) + p_trace + std::string( " ]" ) + std::string( "\n" );
+        std::string final_trace;
+        final_trace.reserve( sizeof( header ) + m_name.size() + p_trace.size() + 16 );
+        final_trace.append( header ).append( m_name ).append( " " ).append( level ).append( " [ " ).append( p_trace ).append( " ]\n" );
+
         m_output->logIt( final_trace );
     }
 }
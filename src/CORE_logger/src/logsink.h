@@ -58,6 +58,11 @@ namespace mage
                 void setCurrentLevel(Level p_level);
                 void setState(bool p_state);
 
+                bool isEnabled(Level p_level) const
+                {
+                    return p_level <= m_current_level && m_state && m_output;
+                }
+
                 void logIt(Level p_level, const std::string& p_trace);
 
                 void registerOutput(Output* p_output);
@@ -211,6 +211,7 @@ namespace mage
             using RGBColor          = Vector<unsigned char, 3>;
             using IntCoords2D       = Vector<int, 2>;
             using FloatCoords2D     = Vector<float, 2>;
+            using Float4Vector      = Vector<float, 4>;
             using Real4Vector       = Vector<>;
             using Real3Vector       = Vector<double, 3>;
             using Real2Vector       = Vector<double, 2>;
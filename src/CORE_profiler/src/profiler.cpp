@@ -0,0 +1,273 @@
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+
+#include "profiler.h"
+#include "exceptions.h"
+
+using namespace mage::core::profiler;
+
+static thread_local ThreadBuffer* t_buffer{ nullptr };
+
+static std::string json_escape(const std::string& p_str)
+{
+	std::string out;
+	for (const char c : p_str)
+	{
+		if ('"' == c || '\\' == c)
+		{
+			out += '\\';
+		}
+		out += c;
+	}
+	return out;
+}
+
+void Profiler::ZoneHistory::push(double p_ms)
+{
+	frames_ms[next] = p_ms;
+	next = (next + 1) % statsWindow;
+	count = std::min(count + 1, statsWindow);
+}
+
+ZoneStats Profiler::ZoneHistory::compute() const
+{
+	ZoneStats stats;
+	if (0 == count)
+	{
+		return stats;
+	}
+
+	std::array<double, statsWindow> sorted;
+	std::copy(frames_ms.begin(), frames_ms.begin() + count, sorted.begin());
+
+	double sum{ 0.0 };
+	stats.min_ms = std::numeric_limits<double>::max();
+	for (size_t i = 0; i < count; i++)
+	{
+		sum += sorted[i];
+		stats.min_ms = std::min(stats.min_ms, sorted[i]);
+	}
+	stats.avg_ms = sum / count;
+
+	// nearest-rank percentile
+	const size_t p99_rank{ (count * 99 + 99) / 100 - 1 };
+	std::nth_element(sorted.begin(), sorted.begin() + p99_rank, sorted.begin() + count);
+	stats.p99_ms = sorted[p99_rank];
+
+	stats.last_ms = frames_ms[(next + statsWindow - 1) % statsWindow];
+	stats.depth = depth;
+
+	return stats;
+}
+
+ThreadBuffer& Profiler::threadBuffer()
+{
+	if (t_buffer)
+	{
+		return *t_buffer;
+	}
+	return createThreadBuffer("");
+}
+
+void Profiler::setThreadName(const std::string& p_name)
+{
+	if (nullptr == t_buffer)
+	{
+		createThreadBuffer(p_name);
+	}
+}
+
+ThreadBuffer& Profiler::createThreadBuffer(const std::string& p_name)
+{
+	std::lock_guard<std::mutex> lock(m_buffers_mutex);
+
+	const int tid{ (int)m_buffers.size() };
+	const std::string name{ p_name.size() ? p_name : "thread " + std::to_string(tid) };
+
+	m_buffers.push_back(std::make_unique<ThreadBuffer>(tid, name));
+	t_buffer = m_buffers.back().get();
+
+	return *t_buffer;
+}
+
+const char* Profiler::intern(const std::string& p_name)
+{
+	std::lock_guard<std::mutex> lock(m_names_mutex);
+	return m_names.insert(p_name).first->c_str();
+}
+
+void Profiler::endFrame()
+{
+	const auto frame_end_ns{ now() };
+
+	for (auto& e : m_histories)
+	{
+		e.second.frame_ns = 0;
+		e.second.frame_calls = 0;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_buffers_mutex);
+
+		for (auto& buffer : m_buffers)
+		{
+			const int tid{ buffer->getTid() };
+
+			buffer->drain([&](const ZoneRecord& p_record)
+			{
+				ZoneHistory* history{ nullptr };
+
+				const auto it{ m_histories_by_name_ptr.find(p_record.name) };
+				if (m_histories_by_name_ptr.end() == it)
+				{
+					// same name may come from different literals
+					history = &m_histories[p_record.name];
+					history->depth = p_record.depth;
+					m_histories_by_name_ptr[p_record.name] = history;
+				}
+				else
+				{
+					history = it->second;
+				}
+
+				history->frame_ns += p_record.end_ns - p_record.start_ns;
+				history->frame_calls++;
+
+				if (m_capturing && m_capture.size() < captureMaxRecords)
+				{
+					m_capture.push_back({ tid, p_record });
+				}
+			});
+		}
+	}
+
+	for (auto& e : m_histories)
+	{
+		auto& history{ e.second };
+		if (history.frame_calls > 0)
+		{
+			history.push(history.frame_ns * 1e-6);
+
+			ZoneStats stats{ history.compute() };
+			stats.calls = history.frame_calls;
+			m_stats[e.first] = stats;
+		}
+		else if (m_stats.count(e.first))
+		{
+			m_stats.at(e.first).calls = 0;
+		}
+	}
+
+	if (m_last_frame_end_ns > 0)
+	{
+		m_frame_history.push((frame_end_ns - m_last_frame_end_ns) * 1e-6);
+	}
+	m_last_frame_end_ns = frame_end_ns;
+}
+
+const std::unordered_map<std::string, ZoneStats>& Profiler::getZonesStats() const
+{
+	return m_stats;
+}
+
+ZoneStats Profiler::getFrameStats() const
+{
+	return m_frame_history.compute();
+}
+
+uint64_t Profiler::getDroppedCount() const
+{
+	std::lock_guard<std::mutex> lock(m_buffers_mutex);
+
+	uint64_t count{ 0 };
+	for (const auto& buffer : m_buffers)
+	{
+		count += buffer->getDroppedCount();
+	}
+	return count;
+}
+
+void Profiler::startCapture()
+{
+	m_capture.clear();
+	m_capture_start_ns = now();
+	m_capturing = true;
+}
+
+void Profiler::stopCapture()
+{
+	m_capturing = false;
+}
+
+bool Profiler::isCapturing() const
+{
+	return m_capturing;
+}
+
+void Profiler::exportChromeTrace(const std::string& p_path) const
+{
+	std::ofstream out(p_path, std::ios::out | std::ios::trunc);
+	if (!out.is_open())
+	{
+		_EXCEPTION("cannot open profiler trace file " + p_path);
+	}
+
+	out << std::fixed << std::setprecision(3);
+	out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+
+	bool first{ true };
+	{
+		std::lock_guard<std::mutex> lock(m_buffers_mutex);
+		for (const auto& buffer : m_buffers)
+		{
+			out << (first ? "" : ",\n");
+			out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->getTid() << ",\"args\":{\"name\":\"" << json_escape(buffer->getName()) << "\"}}";
+			first = false;
+		}
+	}
+
+	for (const auto& e : m_capture)
+	{
+		const auto& record{ e.record };
+		if (record.start_ns < m_capture_start_ns)
+		{
+			continue;
+		}
+
+		// ts and dur in microseconds
+		const double ts{ (record.start_ns - m_capture_start_ns) * 1e-3 };
+		const double dur{ (record.end_ns - record.start_ns) * 1e-3 };
+
+		out << (first ? "" : ",\n");
+		out << "{\"name\":\"" << json_escape(record.name) << "\",\"cat\":\"mage\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.tid << ",\"ts\":" << ts << ",\"dur\":" << dur << "}";
+		first = false;
+	}
+
+	out << "\n]}\n";
+}
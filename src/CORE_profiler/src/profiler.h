@@ -0,0 +1,233 @@
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#pragma once
+
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "singleton.h"
+
+namespace mage
+{
+	namespace core
+	{
+		namespace profiler
+		{
+			inline int64_t now()
+			{
+				return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+			}
+
+			struct ZoneRecord
+			{
+				const char*		name{ nullptr };  // must outlive profiler : string literal or Profiler::intern()
+				int64_t			start_ns{ 0 };
+				int64_t			end_ns{ 0 };
+				int				depth{ 0 };
+			};
+
+			// stats of a zone over the last Profiler::statsWindow frames, in ms
+			struct ZoneStats
+			{
+				double			last_ms{ 0.0 };
+				double			min_ms{ 0.0 };
+				double			avg_ms{ 0.0 };
+				double			p99_ms{ 0.0 };
+				long			calls{ 0 }; // in last frame
+				int				depth{ 0 };
+			};
+
+			// lock-free single producer (owner thread) / single consumer (Profiler::endFrame) ring buffer
+			class ThreadBuffer
+			{
+			public:
+				static constexpr size_t capacity{ 8192 }; // must be a power of 2
+
+				ThreadBuffer(int p_tid, const std::string& p_name) :
+				m_tid(p_tid),
+				m_name(p_name)
+				{
+				}
+
+				void push(const ZoneRecord& p_record)
+				{
+					const auto head{ m_head.load(std::memory_order_relaxed) };
+					if (head - m_tail.load(std::memory_order_acquire) >= capacity)
+					{
+						m_dropped.fetch_add(1, std::memory_order_relaxed);
+						return;
+					}
+					m_records[head & (capacity - 1)] = p_record;
+					m_head.store(head + 1, std::memory_order_release);
+				}
+
+				template<typename F>
+				void drain(F p_func)
+				{
+					const auto head{ m_head.load(std::memory_order_acquire) };
+					auto tail{ m_tail.load(std::memory_order_relaxed) };
+					for (; tail != head; ++tail)
+					{
+						p_func(m_records[tail & (capacity - 1)]);
+					}
+					m_tail.store(tail, std::memory_order_release);
+				}
+
+				int getTid() const { return m_tid; };
+				const std::string& getName() const { return m_name; };
+				uint64_t getDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); };
+
+				int								depth{ 0 }; // current zones nesting, owner thread only
+
+			private:
+				const int						m_tid;
+				const std::string				m_name;
+
+				std::array<ZoneRecord, capacity>	m_records;
+				std::atomic<uint64_t>			m_head{ 0 };
+				std::atomic<uint64_t>			m_tail{ 0 };
+				std::atomic<uint64_t>			m_dropped{ 0 };
+			};
+
+			class Profiler : public property::Singleton<Profiler>
+			{
+			public:
+				static constexpr size_t statsWindow{ 240 }; // frames
+				static constexpr size_t captureMaxRecords{ 1 << 20 };
+
+				Profiler(void) = default;
+				~Profiler() = default;
+
+				// calling thread buffer, created on first call
+				ThreadBuffer&									threadBuffer();
+
+				// name calling thread in exported traces; to call before any zone opened in this thread
+				void											setThreadName(const std::string& p_name);
+
+				// stable copy of a dynamic zone name
+				const char*										intern(const std::string& p_name);
+
+				// main thread, once per frame : drain all threads buffers and update zones stats
+				void											endFrame();
+
+				const std::unordered_map<std::string, ZoneStats>& getZonesStats() const;
+				ZoneStats										getFrameStats() const;
+				uint64_t										getDroppedCount() const;
+
+				void											startCapture();
+				void											stopCapture();
+				bool											isCapturing() const;
+
+				// Chrome trace event format (chrome://tracing, Perfetto)
+				void											exportChromeTrace(const std::string& p_path) const;
+
+			private:
+
+				struct ZoneHistory
+				{
+					std::array<double, statsWindow>	frames_ms;
+					size_t							count{ 0 };
+					size_t							next{ 0 };
+
+					int64_t							frame_ns{ 0 };
+					long							frame_calls{ 0 };
+					int								depth{ 0 };
+
+					void push(double p_ms);
+					ZoneStats compute() const;
+				};
+
+				struct CapturedRecord
+				{
+					int			tid;
+					ZoneRecord	record;
+				};
+
+				ThreadBuffer&									createThreadBuffer(const std::string& p_name);
+
+				mutable std::mutex								m_buffers_mutex;
+				std::vector<std::unique_ptr<ThreadBuffer>>		m_buffers;
+
+				std::mutex										m_names_mutex;
+				std::unordered_set<std::string>					m_names;
+
+				// main thread only (endFrame)
+				std::unordered_map<const char*, ZoneHistory*>	m_histories_by_name_ptr;
+				std::unordered_map<std::string, ZoneHistory>	m_histories;
+				std::unordered_map<std::string, ZoneStats>		m_stats;
+
+				ZoneHistory										m_frame_history;
+				int64_t											m_last_frame_end_ns{ 0 };
+
+				bool											m_capturing{ false };
+				int64_t											m_capture_start_ns{ 0 };
+				std::vector<CapturedRecord>						m_capture;
+			};
+
+			class ScopedZone
+			{
+			public:
+				ScopedZone(const char* p_name) :
+				m_buffer(Profiler::getInstance()->threadBuffer())
+				{
+					m_record.name = p_name;
+					m_record.depth = m_buffer.depth++;
+					m_record.start_ns = now();
+				}
+
+				~ScopedZone()
+				{
+					m_record.end_ns = now();
+					m_buffer.depth--;
+					m_buffer.push(m_record);
+				}
+
+				ScopedZone(const ScopedZone&) = delete;
+				ScopedZone& operator=(const ScopedZone&) = delete;
+
+			private:
+				ThreadBuffer&	m_buffer;
+				ZoneRecord		m_record;
+			};
+		}
+	}
+}
+
+#define _MAGE_PROFILE_CAT_IMPL( _a, _b ) _a##_b
+#define _MAGE_PROFILE_CAT( _a, _b ) _MAGE_PROFILE_CAT_IMPL(_a, _b)
+
+#ifdef _MAGE_PROFILER_DISABLED
+#define _MAGE_PROFILE_ZONE( _name )
+#else
+#define _MAGE_PROFILE_ZONE( _name ) const mage::core::profiler::ScopedZone _MAGE_PROFILE_CAT(_mage_profile_zone_, __LINE__){ _name }
+#endif
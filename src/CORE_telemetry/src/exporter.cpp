@@ -0,0 +1,257 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#include <cstring>
+#include <limits>
+
+#include "exporter.h"
+#include "datacloud.h"
+#include "profiler.h"
+
+using namespace mage;
+using namespace mage::core::telemetry;
+
+namespace
+{
+	template<typename T>
+	std::function<double()> scalar_reader(const std::string& p_var_id)
+	{
+		const auto handle{ mage::rendering::Datacloud::getInstance()->getDataHandle<T>(p_var_id) };
+		return [handle]() { return static_cast<double>(handle.read()); };
+	}
+}
+
+Exporter::~Exporter()
+{
+	if (m_block)
+	{
+		mage::rendering::Datacloud::getInstance()->unregisterSubscriber(m_dc_subscriber);
+	}
+}
+
+bool Exporter::open(const std::string& p_name, const std::vector<std::string>& p_prefixes)
+{
+	if (m_block)
+	{
+		_EXCEPTION("telemetry exporter already opened: " + m_name);
+	}
+
+	if (!m_shared_memory.create(p_name, sizeof(SharedBlock)))
+	{
+		return false;
+	}
+
+	m_block = static_cast<SharedBlock*>(m_shared_memory.getData());
+	m_name = p_name;
+	m_prefixes = p_prefixes;
+
+	// fresh mapping is zero filled : only header to set
+	m_block->version = blockVersion;
+	m_block->channels_count.store(0, std::memory_order_relaxed);
+	m_block->frames_written.store(0, std::memory_order_relaxed);
+	m_block->events_written.store(0, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	m_block->magic = blockMagic;
+
+	const auto dataCloud{ mage::rendering::Datacloud::getInstance() };
+
+	for (const auto& e : dataCloud->getVarsIdsList())
+	{
+		bindVar(e.first, e.second);
+	}
+
+	m_dc_subscriber = dataCloud->registerSubscriber([&, this](rendering::DatacloudEvent p_event, const std::string& p_id, const std::string&)
+	{
+		if (rendering::DatacloudEvent::DATA_ADDED == p_event)
+		{
+			const auto& vars{ mage::rendering::Datacloud::getInstance()->getVarsIdsList() };
+			const auto it{ vars.find(p_id) };
+			if (it != vars.end())
+			{
+				bindVar(p_id, it->second);
+			}
+		}
+		else if (rendering::DatacloudEvent::DATA_UPDATED == p_event)
+		{
+			const auto it{ m_events_sources.find(p_id) };
+			if (it != m_events_sources.end())
+			{
+				pushEvent(p_id + ": " + it->second());
+			}
+		}
+		else if (rendering::DatacloudEvent::DATA_REMOVED == p_event)
+		{
+			// channel slots are kept (no reuse) but not read anymore
+			const auto it{ m_vars_channels.find(p_id) };
+			if (it != m_vars_channels.end())
+			{
+				for (const auto index : it->second)
+				{
+					m_channels[index] = []() { return std::numeric_limits<double>::quiet_NaN(); };
+				}
+				m_vars_channels.erase(it);
+			}
+			m_events_sources.erase(p_id);
+			m_bound_vars.erase(p_id);
+		}
+	});
+
+	return true;
+}
+
+bool Exporter::isOpen() const
+{
+	return nullptr != m_block;
+}
+
+const std::string& Exporter::getName() const
+{
+	return m_name;
+}
+
+bool Exporter::isExported(const std::string& p_var_id) const
+{
+	for (const auto& prefix : m_prefixes)
+	{
+		if (0 == p_var_id.compare(0, prefix.size(), prefix))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void Exporter::bindVar(const std::string& p_var_id, size_t p_type_id)
+{
+	if (!isExported(p_var_id) || m_bound_vars.count(p_var_id))
+	{
+		return;
+	}
+	m_bound_vars.insert(p_var_id);
+
+	if (typeid(long).hash_code() == p_type_id)
+	{
+		addChannel(p_var_id, p_var_id, scalar_reader<long>(p_var_id));
+	}
+	else if (typeid(int).hash_code() == p_type_id)
+	{
+		addChannel(p_var_id, p_var_id, scalar_reader<int>(p_var_id));
+	}
+	else if (typeid(size_t).hash_code() == p_type_id)
+	{
+		addChannel(p_var_id, p_var_id, scalar_reader<size_t>(p_var_id));
+	}
+	else if (typeid(float).hash_code() == p_type_id)
+	{
+		addChannel(p_var_id, p_var_id, scalar_reader<float>(p_var_id));
+	}
+	else if (typeid(double).hash_code() == p_type_id)
+	{
+		addChannel(p_var_id, p_var_id, scalar_reader<double>(p_var_id));
+	}
+	else if (typeid(core::profiler::ZoneStats).hash_code() == p_type_id)
+	{
+		const auto handle{ mage::rendering::Datacloud::getInstance()->getDataHandle<core::profiler::ZoneStats>(p_var_id) };
+
+		addChannel(p_var_id, p_var_id + ".last_ms", [handle]() { return handle.read().last_ms; });
+		addChannel(p_var_id, p_var_id + ".avg_ms", [handle]() { return handle.read().avg_ms; });
+		addChannel(p_var_id, p_var_id + ".p99_ms", [handle]() { return handle.read().p99_ms; });
+	}
+	else if (typeid(std::string).hash_code() == p_type_id)
+	{
+		const auto handle{ mage::rendering::Datacloud::getInstance()->getDataHandle<std::string>(p_var_id) };
+		m_events_sources[p_var_id] = [handle]() { return handle.read(); };
+	}
+}
+
+void Exporter::addChannel(const std::string& p_var_id, const std::string& p_name, const ChannelReader& p_reader)
+{
+	const auto index{ m_block->channels_count.load(std::memory_order_relaxed) };
+	if (index >= maxChannels)
+	{
+		return;
+	}
+
+	auto& name{ m_block->channels_names[index] };
+	std::strncpy(name, p_name.c_str(), channelNameSize - 1);
+	name[channelNameSize - 1] = 0;
+
+	m_block->channels_count.store(index + 1, std::memory_order_release);
+
+	m_vars_channels[p_var_id].push_back(m_channels.size());
+	m_channels.push_back(p_reader);
+}
+
+void Exporter::publish(uint64_t p_frame)
+{
+	if (!m_block)
+	{
+		return;
+	}
+
+	m_frame = p_frame;
+
+	const auto index{ m_frames_written };
+	auto& record{ m_block->frames[index & (framesRingSize - 1)] };
+
+	record.sequence.store(completeSequence(index) - 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	record.frame = p_frame;
+	record.timestamp_ns = core::profiler::now();
+	record.channels_count = static_cast<uint32_t>(m_channels.size());
+	for (size_t i = 0; i < m_channels.size(); i++)
+	{
+		record.values[i] = m_channels[i]();
+	}
+
+	record.sequence.store(completeSequence(index), std::memory_order_release);
+
+	m_frames_written++;
+	m_block->frames_written.store(m_frames_written, std::memory_order_release);
+}
+
+void Exporter::pushEvent(const std::string& p_text)
+{
+	if (!m_block)
+	{
+		return;
+	}
+
+	const auto index{ m_events_written };
+	auto& record{ m_block->events[index & (eventsRingSize - 1)] };
+
+	record.sequence.store(completeSequence(index) - 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	record.frame = m_frame;
+	std::strncpy(record.text, p_text.c_str(), eventTextSize - 1);
+	record.text[eventTextSize - 1] = 0;
+
+	record.sequence.store(completeSequence(index), std::memory_order_release);
+
+	m_events_written++;
+	m_block->events_written.store(m_events_written, std::memory_order_release);
+}
@@ -0,0 +1,90 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <unordered_map>
+#include <functional>
+
+#include "singleton.h"
+#include "sharedmemory.h"
+#include "telemetrylayout.h"
+
+namespace mage
+{
+	namespace core
+	{
+		namespace telemetry
+		{
+			// publish selected datacloud variables into a shared memory block, for out of process monitoring :
+			// numeric vars and profiler zones stats (mage.timings.*) become channels sampled once per frame,
+			// string vars updates (events, infos) are pushed in an events ring
+			class Exporter : public property::Singleton<Exporter>
+			{
+			public:
+				Exporter() = default;
+				~Exporter();
+
+				// create shared block; only datacloud vars whose id begins with one of p_prefixes are exported
+				bool				open(const std::string& p_name, const std::vector<std::string>& p_prefixes);
+				bool				isOpen() const;
+				const std::string&	getName() const;
+
+				// frame thread, once per frame
+				void				publish(uint64_t p_frame);
+
+				void				pushEvent(const std::string& p_text);
+
+			private:
+				using ChannelReader = std::function<double()>;
+				using EventReader = std::function<std::string()>;
+
+				SharedMemory										m_shared_memory;
+				SharedBlock*										m_block{ nullptr };
+				std::string											m_name;
+
+				std::vector<std::string>							m_prefixes;
+				std::unordered_set<std::string>						m_bound_vars;
+
+				std::vector<ChannelReader>							m_channels;
+				std::unordered_map<std::string, std::vector<size_t>>	m_vars_channels; // channels indexes for each bound var
+				std::unordered_map<std::string, EventReader>		m_events_sources;
+
+				uint64_t											m_frame{ 0 };
+				uint64_t											m_frames_written{ 0 };
+				uint64_t											m_events_written{ 0 };
+
+				size_t												m_dc_subscriber{ 0 }; // valid once opened
+
+				bool				isExported(const std::string& p_var_id) const;
+				void				bindVar(const std::string& p_var_id, size_t p_type_id);
+				void				addChannel(const std::string& p_var_id, const std::string& p_name, const ChannelReader& p_reader);
+			};
+		}
+	}
+}
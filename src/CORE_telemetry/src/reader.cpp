@@ -0,0 +1,162 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#include <algorithm>
+#include <cstring>
+
+#include "reader.h"
+
+using namespace mage::core::telemetry;
+
+bool Reader::open(const std::string& p_name)
+{
+	m_block = nullptr;
+
+	if (!m_shared_memory.open(p_name, sizeof(SharedBlock)))
+	{
+		return false;
+	}
+
+	const auto block{ static_cast<const SharedBlock*>(m_shared_memory.getData()) };
+	if (blockMagic != block->magic || blockVersion != block->version)
+	{
+		m_shared_memory.close();
+		return false;
+	}
+
+	m_block = block;
+	return true;
+}
+
+bool Reader::isOpen() const
+{
+	return nullptr != m_block;
+}
+
+std::vector<std::string> Reader::getChannelsNames() const
+{
+	std::vector<std::string> names;
+	if (m_block)
+	{
+		const auto count{ m_block->channels_count.load(std::memory_order_acquire) };
+		for (uint32_t i = 0; i < count; i++)
+		{
+			names.emplace_back(m_block->channels_names[i], strnlen(m_block->channels_names[i], channelNameSize));
+		}
+	}
+	return names;
+}
+
+size_t Reader::readFrames(uint64_t& p_next, const FrameCallback& p_callback) const
+{
+	if (!m_block)
+	{
+		return 0;
+	}
+
+	const auto written{ m_block->frames_written.load(std::memory_order_acquire) };
+	if (written - p_next > framesRingSize)
+	{
+		// too late, oldest records are lost
+		p_next = written - framesRingSize;
+	}
+
+	double values[maxChannels];
+	size_t nb_read{ 0 };
+
+	for (uint64_t index = p_next; index < written; index++)
+	{
+		const auto& record{ m_block->frames[index & (framesRingSize - 1)] };
+
+		const auto sequence{ record.sequence.load(std::memory_order_acquire) };
+		if (completeSequence(index) != sequence)
+		{
+			continue;
+		}
+
+		// may be torn : bounded before copy, checked with sequence below
+		const auto count{ std::min<uint32_t>(record.channels_count, maxChannels) };
+		const auto frame{ record.frame };
+		const auto timestamp{ record.timestamp_ns };
+		std::memcpy(values, record.values, count * sizeof(double));
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (record.sequence.load(std::memory_order_relaxed) != sequence)
+		{
+			// overwritten while copying
+			continue;
+		}
+
+		p_callback(frame, timestamp, values, count);
+		nb_read++;
+	}
+
+	p_next = written;
+	return nb_read;
+}
+
+size_t Reader::readEvents(uint64_t& p_next, const EventCallback& p_callback) const
+{
+	if (!m_block)
+	{
+		return 0;
+	}
+
+	const auto written{ m_block->events_written.load(std::memory_order_acquire) };
+	if (written - p_next > eventsRingSize)
+	{
+		p_next = written - eventsRingSize;
+	}
+
+	char text[eventTextSize];
+	size_t nb_read{ 0 };
+
+	for (uint64_t index = p_next; index < written; index++)
+	{
+		const auto& record{ m_block->events[index & (eventsRingSize - 1)] };
+
+		const auto sequence{ record.sequence.load(std::memory_order_acquire) };
+		if (completeSequence(index) != sequence)
+		{
+			continue;
+		}
+
+		const auto frame{ record.frame };
+		std::memcpy(text, record.text, eventTextSize);
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (record.sequence.load(std::memory_order_relaxed) != sequence)
+		{
+			continue;
+		}
+
+		text[eventTextSize - 1] = 0;
+		p_callback(frame, std::string(text));
+		nb_read++;
+	}
+
+	p_next = written;
+	return nb_read;
+}
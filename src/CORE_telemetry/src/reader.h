@@ -0,0 +1,66 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+
+#include "sharedmemory.h"
+#include "telemetrylayout.h"
+
+namespace mage
+{
+	namespace core
+	{
+		namespace telemetry
+		{
+			// out of process access to an Exporter shared block; never blocks the exporting process
+			class Reader
+			{
+			public:
+				using FrameCallback = std::function<void(uint64_t p_frame, int64_t p_timestamp_ns, const double* p_values, size_t p_count)>;
+				using EventCallback = std::function<void(uint64_t p_frame, const std::string& p_text)>;
+
+				Reader() = default;
+				~Reader() = default;
+
+				bool						open(const std::string& p_name);
+				bool						isOpen() const;
+
+				std::vector<std::string>	getChannelsNames() const;
+
+				// records written since p_next, which is updated; records overwritten before being read are skipped
+				size_t						readFrames(uint64_t& p_next, const FrameCallback& p_callback) const;
+				size_t						readEvents(uint64_t& p_next, const EventCallback& p_callback) const;
+
+			private:
+				SharedMemory				m_shared_memory;
+				const SharedBlock*			m_block{ nullptr };
+			};
+		}
+	}
+}
@@ -0,0 +1,94 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#include <Windows.h>
+
+#include "sharedmemory.h"
+
+using namespace mage::core::telemetry;
+
+SharedMemory::~SharedMemory()
+{
+	close();
+}
+
+bool SharedMemory::create(const std::string& p_name, size_t p_size)
+{
+	close();
+
+	const auto size{ static_cast<unsigned long long>(p_size) };
+	m_handle = ::CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<DWORD>(size >> 32), static_cast<DWORD>(size & 0xffffffff), p_name.c_str());
+	if (!m_handle)
+	{
+		return false;
+	}
+
+	m_data = ::MapViewOfFile(m_handle, FILE_MAP_ALL_ACCESS, 0, 0, p_size);
+	if (!m_data)
+	{
+		close();
+		return false;
+	}
+	return true;
+}
+
+bool SharedMemory::open(const std::string& p_name, size_t p_size)
+{
+	close();
+
+	m_handle = ::OpenFileMappingA(FILE_MAP_READ, FALSE, p_name.c_str());
+	if (!m_handle)
+	{
+		return false;
+	}
+
+	m_data = ::MapViewOfFile(m_handle, FILE_MAP_READ, 0, 0, p_size);
+	if (!m_data)
+	{
+		close();
+		return false;
+	}
+	return true;
+}
+
+void SharedMemory::close()
+{
+	if (m_data)
+	{
+		::UnmapViewOfFile(m_data);
+		m_data = nullptr;
+	}
+
+	if (m_handle)
+	{
+		::CloseHandle(m_handle);
+		m_handle = nullptr;
+	}
+}
+
+void* SharedMemory::getData() const
+{
+	return m_data;
+}
@@ -0,0 +1,59 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#pragma once
+
+#include <string>
+
+namespace mage
+{
+	namespace core
+	{
+		namespace telemetry
+		{
+			// named memory mapping, shared between processes
+			class SharedMemory
+			{
+			public:
+				SharedMemory() = default;
+				SharedMemory(const SharedMemory&) = delete;
+				SharedMemory(SharedMemory&&) = delete;
+				SharedMemory& operator=(const SharedMemory&) = delete;
+
+				~SharedMemory();
+
+				bool	create(const std::string& p_name, size_t p_size);
+				bool	open(const std::string& p_name, size_t p_size);
+				void	close();
+
+				void*	getData() const;
+
+			private:
+				void*	m_handle{ nullptr };
+				void*	m_data{ nullptr };
+			};
+		}
+	}
+}
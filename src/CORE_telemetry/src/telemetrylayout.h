@@ -0,0 +1,90 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace mage
+{
+	namespace core
+	{
+		namespace telemetry
+		{
+			// shared memory block written by Exporter (one writer : the engine frame thread) and read by any number of Reader
+			// frames and events rings records are protected by a sequence number (seqlock) : odd while being written,
+			// 2 * (index + 1) once complete. Readers never block the writer, they retry or drop overwritten records
+
+			static constexpr uint32_t	blockMagic			{ 0x4C45544D }; // "MTEL"
+			static constexpr uint32_t	blockVersion		{ 2 };
+
+			static constexpr int		maxChannels			{ 256 };
+			static constexpr int		channelNameSize		{ 64 };
+			static constexpr int		framesRingSize		{ 256 }; // must be a power of 2
+			static constexpr int		eventsRingSize		{ 64 };  // must be a power of 2
+			static constexpr int		eventTextSize		{ 120 };
+
+			static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared memory atomics must be lock free");
+
+			struct FrameRecord
+			{
+				std::atomic<uint64_t>	sequence;
+				uint64_t				frame;
+				int64_t					timestamp_ns;
+				uint32_t				channels_count; // channels bound when record was published
+				double					values[maxChannels];
+			};
+
+			struct EventRecord
+			{
+				std::atomic<uint64_t>	sequence;
+				uint64_t				frame;
+				char					text[eventTextSize];
+			};
+
+			struct SharedBlock
+			{
+				uint32_t				magic;
+				uint32_t				version;
+
+				// names are written before count is incremented : readers see only complete names
+				std::atomic<uint32_t>	channels_count;
+				char					channels_names[maxChannels][channelNameSize];
+
+				std::atomic<uint64_t>	frames_written;
+				std::atomic<uint64_t>	events_written;
+
+				FrameRecord				frames[framesRingSize];
+				EventRecord				events[eventsRingSize];
+			};
+
+			inline uint64_t completeSequence(uint64_t p_index)
+			{
+				return 2 * (p_index + 1);
+			}
+		}
+	}
+}
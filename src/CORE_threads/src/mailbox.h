@@ -26,6 +26,8 @@
 
 #include <list>
 #include <mutex>
+#include <condition_variable>
+#include <chrono>
 #include <type_traits>
 
 namespace mage
@@ -52,6 +54,15 @@ namespace mage
 				m_mutex.lock();
 				m_messages.push_front(p_object);
 				m_mutex.unlock();
+
+				m_cond.notify_one();
+			}
+
+			// block until at least one message is available or timeout expired; return true if mailbox is not empty
+			bool wait(std::chrono::milliseconds p_timeout)
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				return m_cond.wait_for(lock, p_timeout, [this] { return m_messages.size() > 0; });
 			}
 
 			// works only with COPY of associated type (we refuse here any reference on an external object which lifecycle is unknown by definition)
@@ -143,8 +154,9 @@ namespace mage
 			}
 
 		private:
-			std::list<T>	    m_messages;
-			mutable std::mutex	m_mutex;
+			std::list<T>	            m_messages;
+			mutable std::mutex	        m_mutex;
+			std::condition_variable     m_cond;
 		};
 	}
 }
@@ -28,6 +28,7 @@
 #include <chrono>
 
 #include "runner.h"
+#include "profiler.h"
 
 using namespace mage;
 using namespace mage::core;
@@ -35,6 +36,8 @@ using namespace mage::property;
 
 void Runner::mainloop()
 {
+	profiler::Profiler::getInstance()->setThreadName("runner");
+
 	m_cont = true;
 
 	do
@@ -58,7 +61,10 @@ void Runner::mainloop()
 					m_busy = true;
 					m_state_mutex.unlock();
 
-					current->execute(this);
+					{
+						_MAGE_PROFILE_ZONE(profiler::Profiler::getInstance()->intern("runner." + task_action));
+						current->execute(this);
+					}
 
 					const TaskReport report{ RunnerEvent::TASK_DONE, task_target, task_action };
 					mb_out->push(report);
@@ -72,8 +78,8 @@ void Runner::mainloop()
 		}
 		else
 		{
-			// idle for a little time...
-			std::this_thread::sleep_for(std::chrono::milliseconds(idle_duration_ms));
+			// idle until a task is pushed : no more polling
+			mb_in->wait(std::chrono::milliseconds(idle_duration_ms));
 		}
 
 	} while (m_cont);	
@@ -90,8 +96,16 @@ bool Runner::isBusy()
 	return state_copy;
 }
 
+bool Runner::hasPendingTasks()
+{
+	return isBusy() || m_mailbox_in.getBoxSize() > 0 || m_mailbox_out.getBoxSize() > 0;
+}
+
 void Runner::startup(void)
 {	
+	// profiler singleton must exist before runner thread use it
+	profiler::Profiler::getInstance();
+
 	m_thread = std::make_unique<std::thread>(&Runner::mainloop, this);
 };
 
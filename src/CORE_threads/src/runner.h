@@ -73,6 +73,9 @@ namespace mage
 
 			bool isBusy();
 
+			// task running or waiting in mailboxes, or reports not yet dispatched
+			bool hasPendingTasks();
+
 		private:
 
 			void mainloop();
@@ -81,9 +84,9 @@ namespace mage
 			bool											m_cont;
 
 			std::mutex										m_state_mutex;
-			bool											m_busy;
+			bool											m_busy{ false };
 
-			static constexpr unsigned int idle_duration_ms{ 50 };
+			static constexpr unsigned int idle_duration_ms{ 1000 }; // max idle wait, runner is woken up as soon as a task is pushed
 			friend struct RunnerKiller;
 		};
 
@@ -74,6 +74,8 @@ namespace mage
                 step(p_step),
                 direction(p_direction),
                 value(p_initial_value),
+                previous_value(p_initial_value),
+                interpolated_value(p_initial_value),
                 boundaries(p_boundaries),
                 boundaries_management(p_boundariesManagement)
             {
@@ -82,6 +84,10 @@ namespace mage
             double                  value{ 0.0 };
             double                  step{ 0.0 };
 
+            // with fixed timestep : value before last simulation step, and value to use for rendering
+            double                  previous_value{ 0.0 };
+            double                  interpolated_value{ 0.0 };
+
             State                   state{ State::ON };
 
             Direction               direction{ Direction::INC };
@@ -0,0 +1,211 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#define _USE_MATH_DEFINES
+
+#include <cmath>
+
+#include "syncvariablesstore.h"
+
+using namespace mage::core;
+
+namespace
+{
+    constexpr double twoPi{ 2.0 * M_PI };
+
+    using StepFunc = void(*)(double*, double*, double*, const double*, const double*, const double*, const double*, size_t, double);
+
+    // same rules as TimeControl::manageVariable, without branches on the variable descriptor :
+    // boundaries set to NAN are never reached since any comparison with NAN is false
+    template<bool Angle, SyncVariable::BoundariesManagement Management>
+    void step_group(double* p_value, double* p_previous, double* p_direction, const double* p_step, const double* p_active,
+                    const double* p_min, const double* p_max, size_t p_count, double p_scale)
+    {
+        for (size_t i = 0; i < p_count; i++)
+        {
+            const double current{ p_value[i] };
+            const double dir{ p_direction[i] };
+            const double moving{ dir * p_active[i] };
+            const double delta{ p_step[i] * p_scale };
+
+            double v{ current + delta * moving };
+
+            if constexpr (Angle)
+            {
+                // fmod(v, 2pi), and back to positive range when decreasing from a non positive angle
+                const double wrapped{ v - std::trunc(v / twoPi) * twoPi + ((moving < 0.0 && current <= 0.0) ? twoPi : 0.0) };
+                v = (0.0 != moving) ? wrapped : current;
+            }
+
+            const bool hit_max{ moving > 0.0 && v > p_max[i] };
+            const bool hit_min{ moving < 0.0 && v < p_min[i] };
+
+            if constexpr (SyncVariable::BoundariesManagement::STOP == Management)
+            {
+                v = hit_max ? p_max[i] : (hit_min ? p_min[i] : v);
+                p_direction[i] = (hit_max || hit_min) ? 0.0 : dir;
+            }
+            else if constexpr (SyncVariable::BoundariesManagement::MIRROR == Management)
+            {
+                v = hit_max ? p_max[i] : (hit_min ? p_min[i] : v);
+                p_direction[i] = hit_max ? -1.0 : (hit_min ? 1.0 : dir);
+            }
+            else
+            {
+                v = hit_max ? p_min[i] : (hit_min ? p_max[i] : v);
+            }
+
+            // wrap or boundaries reached : no interpolation over this discontinuity
+            p_previous[i] = (std::abs(v - current) > std::abs(delta) * 1.5) ? v : current;
+            p_value[i] = v;
+        }
+    }
+
+    // indexed by type * 3 + boundaries management
+    const StepFunc stepFuncs[]
+    {
+        step_group<true, SyncVariable::BoundariesManagement::STOP>,
+        step_group<true, SyncVariable::BoundariesManagement::MIRROR>,
+        step_group<true, SyncVariable::BoundariesManagement::WRAP>,
+        step_group<false, SyncVariable::BoundariesManagement::STOP>,
+        step_group<false, SyncVariable::BoundariesManagement::MIRROR>,
+        step_group<false, SyncVariable::BoundariesManagement::WRAP>
+    };
+}
+
+void SyncVariablesStore::Group::clear()
+{
+    variables.clear();
+    value.clear();
+    previous.clear();
+    interpolated.clear();
+    step.clear();
+    direction.clear();
+    active.clear();
+    min.clear();
+    max.clear();
+}
+
+void SyncVariablesStore::clear()
+{
+    for (auto& group : m_groups)
+    {
+        group.clear();
+    }
+    m_size = 0;
+}
+
+void SyncVariablesStore::add(SyncVariable* p_variable)
+{
+    const int type_index{ SyncVariable::Type::ANGLE == p_variable->type ? 0 : 1 };
+    auto& group{ m_groups[type_index * nbBoundariesManagements + static_cast<int>(p_variable->boundaries_management)] };
+
+    double direction{ 0.0 };
+    if (SyncVariable::Direction::INC == p_variable->direction)
+    {
+        direction = 1.0;
+    }
+    else if (SyncVariable::Direction::DEC == p_variable->direction)
+    {
+        direction = -1.0;
+    }
+
+    group.variables.push_back(p_variable);
+    group.value.push_back(p_variable->value);
+    group.previous.push_back(p_variable->previous_value);
+    group.interpolated.push_back(p_variable->interpolated_value);
+    group.step.push_back(p_variable->step);
+    group.direction.push_back(direction);
+    group.active.push_back(SyncVariable::State::ON == p_variable->state ? 1.0 : 0.0);
+    group.min.push_back(p_variable->boundaries.min);
+    group.max.push_back(p_variable->boundaries.max);
+
+    m_size++;
+}
+
+void SyncVariablesStore::step(double p_scale)
+{
+    for (size_t i = 0; i < m_groups.size(); i++)
+    {
+        auto& group{ m_groups[i] };
+        if (group.variables.empty())
+        {
+            continue;
+        }
+
+        stepFuncs[i](group.value.data(), group.previous.data(), group.direction.data(), group.step.data(), group.active.data(),
+                        group.min.data(), group.max.data(), group.variables.size(), p_scale);
+    }
+}
+
+void SyncVariablesStore::interpolate(double p_alpha)
+{
+    for (auto& group : m_groups)
+    {
+        const size_t count{ group.variables.size() };
+        const double* value{ group.value.data() };
+        const double* previous{ group.previous.data() };
+        double* interpolated{ group.interpolated.data() };
+
+        for (size_t i = 0; i < count; i++)
+        {
+            interpolated[i] = previous[i] + (value[i] - previous[i]) * p_alpha;
+        }
+    }
+}
+
+void SyncVariablesStore::writeBack()
+{
+    for (auto& group : m_groups)
+    {
+        for (size_t i = 0; i < group.variables.size(); i++)
+        {
+            auto variable{ group.variables[i] };
+
+            variable->value = group.value[i];
+            variable->previous_value = group.previous[i];
+            variable->interpolated_value = group.interpolated[i];
+
+            const double direction{ group.direction[i] };
+            if (direction > 0.0)
+            {
+                variable->direction = SyncVariable::Direction::INC;
+            }
+            else if (direction < 0.0)
+            {
+                variable->direction = SyncVariable::Direction::DEC;
+            }
+            else
+            {
+                variable->direction = SyncVariable::Direction::ZERO;
+            }
+        }
+    }
+}
+
+size_t SyncVariablesStore::size() const
+{
+    return m_size;
+}
@@ -0,0 +1,86 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#pragma once
+
+#include <vector>
+#include <array>
+
+#include "syncvariable.h"
+
+namespace mage
+{
+    namespace core
+    {
+        // SoA batch of sync variables, grouped by type and boundaries management so that each group is advanced
+        // by one branchless loop.
+        // SyncVariable components remain the reference state : variables are gathered at frame start (add()) and
+        // results written back at the end (writeBack()); buffers are kept between frames, so no allocation once warmed up
+        class SyncVariablesStore
+        {
+        public:
+
+            SyncVariablesStore() = default;
+            ~SyncVariablesStore() = default;
+
+            void    clear();
+            void    add(SyncVariable* p_variable);
+
+            // one simulation step for all variables; p_scale : speed to step conversion (time slice * time factor)
+            void    step(double p_scale);
+
+            // rendering value : blend between the 2 last simulation states
+            void    interpolate(double p_alpha);
+
+            void    writeBack();
+
+            size_t  size() const;
+
+        private:
+
+            struct Group
+            {
+                std::vector<SyncVariable*>  variables;
+
+                std::vector<double>         value;
+                std::vector<double>         previous;
+                std::vector<double>         interpolated;
+                std::vector<double>         step;
+                std::vector<double>         direction;  // +1.0 INC, -1.0 DEC, 0.0 ZERO
+                std::vector<double>         active;     // 1.0 ON, 0.0 OFF
+                std::vector<double>         min;
+                std::vector<double>         max;
+
+                void clear();
+            };
+
+            static constexpr int            nbTypes{ 2 };
+            static constexpr int            nbBoundariesManagements{ 3 };
+
+            std::array<Group, nbTypes * nbBoundariesManagements>    m_groups;
+            size_t                                                  m_size{ 0 };
+        };
+    }
+}
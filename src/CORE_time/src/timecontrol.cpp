@@ -24,6 +24,8 @@
 /* -*-LIC_END-*- */
 
 #include <time.h>
+#include <algorithm>
+#include <cmath>
 #include "timecontrol.h"
 #include "datacloud.h"
 #include "syncvariable.h"
@@ -113,6 +115,26 @@ void TimeControl::update(void)
 {
 	m_tm.update();
 
+    if (m_fixed_timestep > 0.0 && m_tm.isReady())
+    {
+        m_accumulator += m_tm.getFrameDeltaSeconds();
+
+        m_fixed_steps_count = static_cast<int>(m_accumulator / m_fixed_timestep);
+        if (m_fixed_steps_count > maxFixedStepsPerFrame)
+        {
+            // too late, give up on the remaining time instead of spiraling
+            m_fixed_steps_count = maxFixedStepsPerFrame;
+            m_accumulator = m_fixed_steps_count * m_fixed_timestep;
+        }
+        m_accumulator -= m_fixed_steps_count * m_fixed_timestep;
+        m_interpolation_factor = m_accumulator / m_fixed_timestep;
+    }
+    else
+    {
+        m_fixed_steps_count = 1;
+        m_interpolation_factor = 1.0;
+    }
+
     const auto dataCloud{ mage::rendering::Datacloud::getInstance() };
 
     // put current formated date/time in component string[0]
@@ -136,6 +158,50 @@ bool TimeControl::isReady(void) const
 	return m_tm.isReady();
 }
 
+double TimeControl::getFrameDeltaSeconds(void) const
+{
+    return m_tm.getFrameDeltaSeconds();
+}
+
+void TimeControl::setFixedTimestep(double p_step_seconds)
+{
+    m_fixed_timestep = std::max(p_step_seconds, 0.0);
+    m_accumulator = 0.0;
+}
+
+double TimeControl::getFixedTimestep(void) const
+{
+    return m_fixed_timestep;
+}
+
+int TimeControl::getFixedStepsCount(void) const
+{
+    return m_fixed_steps_count;
+}
+
+double TimeControl::getInterpolationFactor(void) const
+{
+    return m_interpolation_factor;
+}
+
+void TimeControl::runSimulationSteps(const std::function<void()>& p_step)
+{
+    if (m_fixed_timestep > 0.0)
+    {
+        m_tm.setIntegrationDelta(m_fixed_timestep);
+        for (int i = 0; i < m_fixed_steps_count; i++)
+        {
+            p_step();
+        }
+        // back to frame delta for per-frame conversions (animators...)
+        m_tm.setIntegrationDelta(m_tm.getFrameDeltaSeconds());
+    }
+    else
+    {
+        p_step();
+    }
+}
+
 void TimeControl::angleSpeedInc(double* p_angle, double p_angleSpeed)
 {
     if (m_tm.isReady())
@@ -182,7 +248,7 @@ void TimeControl::manageVariable(SyncVariable& p_variable)
         {
             angleSpeedInc(&p_variable.value, p_variable.step);
 
-            if (p_variable.boundaries.max != NAN)
+            if (!std::isnan(p_variable.boundaries.max))
             {
                 if (p_variable.value > p_variable.boundaries.max)
                 {
@@ -212,7 +278,7 @@ void TimeControl::manageVariable(SyncVariable& p_variable)
         {
             angleSpeedDec(&p_variable.value, p_variable.step);
 
-            if (p_variable.boundaries.min != NAN)
+            if (!std::isnan(p_variable.boundaries.min))
             {
                 if (p_variable.value < p_variable.boundaries.min)
                 {
@@ -245,7 +311,7 @@ void TimeControl::manageVariable(SyncVariable& p_variable)
         {
             translationSpeedInc(&p_variable.value, p_variable.step);
 
-            if (p_variable.boundaries.max != NAN)
+            if (!std::isnan(p_variable.boundaries.max))
             {
                 if (p_variable.value > p_variable.boundaries.max)
                 {
@@ -275,7 +341,7 @@ void TimeControl::manageVariable(SyncVariable& p_variable)
         {
             translationSpeedDec(&p_variable.value, p_variable.step);
 
-            if (p_variable.boundaries.min != NAN)
+            if (!std::isnan(p_variable.boundaries.min))
             {
                 if (p_variable.value < p_variable.boundaries.min)
                 {
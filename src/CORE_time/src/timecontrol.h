@@ -26,6 +26,7 @@
 #pragma once
 
 #include <string>
+#include <functional>
 #include "singleton.h"
 #include "timemanager.h"
 
@@ -102,8 +103,22 @@ namespace mage
 
             long    getFPS() const;
 
+            // real time, not affected by time factor
+            double  getFrameDeltaSeconds() const;
+
+            // fixed timestep simulation; 0.0 (default) means one variable step per frame
+            void    setFixedTimestep(double p_step_seconds);
+            double  getFixedTimestep() const;
+            int     getFixedStepsCount() const;
+            double  getInterpolationFactor() const;
+
+            // call p_step once per pending fixed step (or once per frame if no fixed timestep)
+            void    runSimulationSteps(const std::function<void()>& p_step);
+
             TimeMark buildTimeMark();
 
+            static constexpr int    maxFixedStepsPerFrame       { 8 };
+
         private:
 
             static const int        m_base_timestep             { 8 };
@@ -125,6 +140,11 @@ namespace mage
 
             int                     m_world_nbsteps             { m_base_timestep };
 
+            double                  m_fixed_timestep            { 0.0 };
+            double                  m_accumulator               { 0.0 };
+            int                     m_fixed_steps_count         { 0 };
+            double                  m_interpolation_factor      { 1.0 };
+
             TimeManager             m_tm;
 
             TimerDescr              m_timer;
@@ -24,7 +24,8 @@
 
 #define _USE_MATH_DEFINES
 
-#include <windows.h>
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <numbers>
 
@@ -76,11 +77,29 @@ void TimeManager::reset(void)
     m_frame_count = 0;
     m_ready = false;
     m_last_deltatime = 0;
+
+    m_origin_ns = -1;
+    m_last_frame_ns = 0;
+    m_frame_delta_ns = 0;
+    m_integration_delta = 0.0;
 }
 
 void TimeManager::update(void)
 {
-    const auto current_tick{ ::GetTickCount() };
+    const long long now_ns{ std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count() };
+
+    if (-1 == m_origin_ns)
+    {
+        m_origin_ns = now_ns;
+        m_last_frame_ns = now_ns;
+    }
+
+    m_frame_delta_ns = std::min(now_ns - m_last_frame_ns, maxFrameDeltaNs);
+    m_last_frame_ns = now_ns;
+    m_integration_delta = m_frame_delta_ns * 1e-9;
+
+    // ms ticks since first update, 0 reserved for 'not started yet'
+    const long current_tick{ static_cast<long>((now_ns - m_origin_ns) / 1000000) + 1 };
 
     if (m_last_tick)
     {
@@ -134,7 +153,6 @@ void TimeManager::update(void)
     }
 }
 
-
 bool TimeManager::isReady(void) const
 {
     return m_ready;
@@ -155,13 +173,33 @@ long TimeManager::getFPS(void) const
     return m_fps;
 }
 
+long long TimeManager::getFrameDeltaNs(void) const
+{
+    return m_frame_delta_ns;
+}
+
+double TimeManager::getFrameDeltaSeconds(void) const
+{
+    return m_frame_delta_ns * 1e-9;
+}
+
+void TimeManager::setIntegrationDelta(double p_seconds)
+{
+    m_integration_delta = p_seconds;
+}
+
+double TimeManager::getIntegrationDelta(void) const
+{
+    return m_integration_delta;
+}
+
 double TimeManager::convertUnitPerSecFramePerSec(double p_speed)
 {
     if (!m_ready)
     {
         return 0.0;
     }
-    return (p_speed / m_fps);
+    return (p_speed * m_integration_delta);
 }
 
 void TimeManager::angleSpeedInc(double* p_angle, double p_angleSpeed)
@@ -169,8 +207,8 @@ void TimeManager::angleSpeedInc(double* p_angle, double p_angleSpeed)
     if (!m_ready) return;
 
     // on veut, a partir de la vitesse en degres/s fixee, trouver
-    // la vitesse en degres / frame -> on fait donc (deg/sec)/(frame/sec) 
-    const double angleSpeedDegPerFrame{ p_angleSpeed / m_fps };
+    // la vitesse en degres / frame -> on fait donc (deg/sec)*(sec/frame)
+    const double angleSpeedDegPerFrame{ p_angleSpeed * m_integration_delta };
     double angle{ *p_angle };
 
     angle += angleSpeedDegPerFrame;
@@ -184,8 +222,8 @@ void TimeManager::angleSpeedDec(double* p_angle, double p_angleSpeed)
     if (!m_ready) return;
 
     // on veut, a partir de la vitesse en degres/s fixee, trouver
-    // la vitesse en degres / frame -> on fait donc (deg/sec)/(frame/sec) 
-    const double angleSpeedDegPerFrame{ p_angleSpeed / m_fps };
+    // la vitesse en degres / frame -> on fait donc (deg/sec)*(sec/frame)
+    const double angleSpeedDegPerFrame{ p_angleSpeed * m_integration_delta };
     double angle{ *p_angle };
 
     angle -= angleSpeedDegPerFrame;
@@ -204,8 +242,8 @@ void TimeManager::translationSpeedInc(double* p_translation, double p_speed)
     if (!m_ready) return;
 
     // on veut, a partir de la vitesse en unites/s fixee, trouver
-    // la vitesse en unite / frame -> on fait donc (unit/sec)/(frame/sec)
-    const double translationSpeedUnitPerFrame{ p_speed / m_fps };
+    // la vitesse en unite / frame -> on fait donc (unit/sec)*(sec/frame)
+    const double translationSpeedUnitPerFrame{ p_speed * m_integration_delta };
     *p_translation += translationSpeedUnitPerFrame;
 }
 
@@ -214,8 +252,8 @@ void TimeManager::translationSpeedDec(double* p_translation, double p_speed)
     if (!m_ready) return;
 
     // on veut, a partir de la vitesse en unites/s fixee, trouver
-    // la vitesse en unite / frame -> on fait donc (unit/sec)/(frame/sec)
-    const double translationSpeedUnitPerFrame{ p_speed / m_fps };
+    // la vitesse en unite / frame -> on fait donc (unit/sec)*(sec/frame)
+    const double translationSpeedUnitPerFrame{ p_speed * m_integration_delta };
     *p_translation -= translationSpeedUnitPerFrame;
 }
 
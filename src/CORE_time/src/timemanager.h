@@ -81,8 +81,17 @@ namespace mage
             long    getCurrentTick() const;
             long    getFPS() const;
 
+            long long getFrameDeltaNs() const;
+            double  getFrameDeltaSeconds() const;
+
+            // time slice used by speed conversions; reset to frame delta on each update()
+            void    setIntegrationDelta(double p_seconds);
+            double  getIntegrationDelta() const;
+
             void    registerTimer(TimerDescr* p_timer);
 
+            static constexpr long long  maxFrameDeltaNs{ 250000000 }; // clamp after a stall (debugger, window drag...)
+
         private:
             long                        m_last_tick{ 0 };
             long                        m_frame_count{ 0 };
@@ -91,6 +100,11 @@ namespace mage
             long                        m_last_deltatime{ 0 };
             long                        m_current_tick{ 0 };
 
+            long long                   m_origin_ns{ -1 };
+            long long                   m_last_frame_ns{ 0 };
+            long long                   m_frame_delta_ns{ 0 };
+            double                      m_integration_delta{ 0.0 };
+
             std::set<TimerDescr*>        m_timers;
 
         };
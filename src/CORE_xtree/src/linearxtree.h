@@ -0,0 +1,380 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#pragma once
+
+#include <array>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+
+#include "exceptions.h"
+
+namespace mage
+{
+	namespace core
+	{
+		// sparse linear xtree (quadtree : Dim = 2, octree : Dim = 3), covering a cube [min, min + side_length[
+		// 
+		// a node is identified by its locational code : (1 << (Dim * depth)) | morton(cell integer coords at this depth)
+		// -> root code is 1, parent code is code >> Dim, child i code is (code << Dim) | i
+		// 
+		// only nodes holding data are stored; point location, parent/children and neighbours are computed from codes,
+		// so memory and init time depend on occupied cells, not on tree depth
+		template <size_t Dim, typename NodeData>
+		class LinearXTree
+		{
+		public:
+
+			static_assert(2 == Dim || 3 == Dim, "LinearXTree : only quadtree and octree supported");
+
+			using Code = uint64_t;
+			using Position = std::array<double, Dim>;
+			using Coords = std::array<uint32_t, Dim>;
+
+			static constexpr size_t		Dimension{ Dim };
+			static constexpr int		ChildCount{ 1 << Dim };
+
+			static constexpr Code		invalidCode{ 0 };
+			static constexpr Code		rootCode{ 1 };
+			static constexpr size_t		maxDepth{ 2 == Dim ? 31 : 21 }; // code bits : 1 + Dim * depth <= 64
+
+			LinearXTree() = default;
+			~LinearXTree() = default;
+
+			// remove all nodes
+			void configure(const Position& p_min, double p_side_length, size_t p_depth)
+			{
+				if (p_depth > maxDepth)
+				{
+					_EXCEPTION("LinearXTree : depth too high : " + std::to_string(p_depth));
+				}
+				if (p_side_length <= 0.0)
+				{
+					_EXCEPTION("LinearXTree : invalid side length");
+				}
+
+				m_min = p_min;
+				m_side_length = p_side_length;
+				m_depth = p_depth;
+				m_nodes.clear();
+			}
+
+			size_t getDepth() const
+			{
+				return m_depth;
+			}
+
+			double getSideLength() const
+			{
+				return m_side_length;
+			}
+
+			const Position& getMin() const
+			{
+				return m_min;
+			}
+
+			////////////////////////////////////////////////////////////
+			// codes arithmetic
+
+			static Code encode(const Coords& p_coords, size_t p_depth)
+			{
+				Code morton{ 0 };
+				for (size_t i = 0; i < Dim; i++)
+				{
+					morton |= spread(p_coords[i]) << i;
+				}
+				return (Code{ 1 } << (Dim * p_depth)) | morton;
+			}
+
+			static Coords decode(Code p_code)
+			{
+				const size_t depth{ depthOf(p_code) };
+				const Code morton{ p_code & ((Code{ 1 } << (Dim * depth)) - 1) };
+
+				Coords coords;
+				for (size_t i = 0; i < Dim; i++)
+				{
+					coords[i] = compact(morton >> i);
+				}
+				return coords;
+			}
+
+			static size_t depthOf(Code p_code)
+			{
+				size_t msb{ 0 };
+				while (p_code >>= 1)
+				{
+					msb++;
+				}
+				return msb / Dim;
+			}
+
+			// invalidCode for root
+			static Code parentOf(Code p_code)
+			{
+				return p_code >> Dim;
+			}
+
+			static Code childOf(Code p_code, unsigned int p_index)
+			{
+				return (p_code << Dim) | p_index;
+			}
+
+			// same depth neighbour, p_step cells along p_axis; invalidCode if outside tree
+			static Code neighbourOf(Code p_code, size_t p_axis, int p_step)
+			{
+				const size_t depth{ depthOf(p_code) };
+				Coords coords{ decode(p_code) };
+
+				const int64_t c{ static_cast<int64_t>(coords[p_axis]) + p_step };
+				if (c < 0 || c >= (int64_t{ 1 } << depth))
+				{
+					return invalidCode;
+				}
+				coords[p_axis] = static_cast<uint32_t>(c);
+				return encode(coords, depth);
+			}
+
+			////////////////////////////////////////////////////////////
+			// geometry
+
+			// code of the p_depth cell containing p_position, invalidCode if outside tree
+			Code locate(const Position& p_position, size_t p_depth) const
+			{
+				const uint32_t cells{ uint32_t{ 1 } << p_depth };
+
+				Coords coords;
+				for (size_t i = 0; i < Dim; i++)
+				{
+					const double t{ (p_position[i] - m_min[i]) / m_side_length };
+					if (t < 0.0 || t >= 1.0)
+					{
+						return invalidCode;
+					}
+					coords[i] = std::min(static_cast<uint32_t>(t * cells), cells - 1);
+				}
+				return encode(coords, p_depth);
+			}
+
+			// leaf cell
+			Code locate(const Position& p_position) const
+			{
+				return locate(p_position, m_depth);
+			}
+
+			bool contains(Code p_code, const Position& p_position) const
+			{
+				return locate(p_position, depthOf(p_code)) == p_code;
+			}
+
+			// first depth where p_size / cell side > p_ratio (cell large enough for object), leaf depth at most
+			size_t depthForSize(double p_size, double p_ratio) const
+			{
+				size_t depth{ 0 };
+				double cell_side{ m_side_length };
+				while (depth < m_depth && p_size / cell_side <= p_ratio)
+				{
+					cell_side /= 2.0;
+					depth++;
+				}
+				return depth;
+			}
+
+			double cellSideLength(Code p_code) const
+			{
+				return m_side_length / static_cast<double>(Code{ 1 } << depthOf(p_code));
+			}
+
+			Position cellMin(Code p_code) const
+			{
+				const double side{ cellSideLength(p_code) };
+				const Coords coords{ decode(p_code) };
+
+				Position min;
+				for (size_t i = 0; i < Dim; i++)
+				{
+					min[i] = m_min[i] + coords[i] * side;
+				}
+				return min;
+			}
+
+			////////////////////////////////////////////////////////////
+			// nodes
+
+			// created if missing
+			NodeData& nodeAccess(Code p_code)
+			{
+				return m_nodes[p_code];
+			}
+
+			NodeData* findNode(Code p_code)
+			{
+				const auto it{ m_nodes.find(p_code) };
+				return it != m_nodes.end() ? &it->second : nullptr;
+			}
+
+			const NodeData* findNode(Code p_code) const
+			{
+				const auto it{ m_nodes.find(p_code) };
+				return it != m_nodes.end() ? &it->second : nullptr;
+			}
+
+			void removeNode(Code p_code)
+			{
+				m_nodes.erase(p_code);
+			}
+
+			size_t getNodesCount() const
+			{
+				return m_nodes.size();
+			}
+
+			// all existing nodes, no specific order
+			template<typename Func>
+			void forEachNode(const Func& p_func) const
+			{
+				for (const auto& e : m_nodes)
+				{
+					p_func(e.first, e.second);
+				}
+			}
+
+			// existing nodes at p_code depth, p_radius cells away at most (manhattan distance); p_code node included
+			template<typename Func>
+			void forEachNodeAround(Code p_code, int p_radius, const Func& p_func) const
+			{
+				if (invalidCode == p_code)
+				{
+					return;
+				}
+
+				const size_t depth{ depthOf(p_code) };
+				const Coords center{ decode(p_code) };
+				Coords coords{ center };
+
+				visit_around(coords, center, 0, p_radius, depth, p_func);
+			}
+
+		private:
+
+			Position							m_min{};
+			double								m_side_length{ 1.0 };
+			size_t								m_depth{ 0 };
+
+			std::unordered_map<Code, NodeData>	m_nodes;
+
+			template<typename Func>
+			void visit_around(Coords& p_coords, const Coords& p_center, size_t p_axis, int p_budget, size_t p_depth, const Func& p_func) const
+			{
+				const int64_t cells{ int64_t{ 1 } << p_depth };
+
+				for (int offset = -p_budget; offset <= p_budget; offset++)
+				{
+					const int64_t c{ static_cast<int64_t>(p_center[p_axis]) + offset };
+					if (c < 0 || c >= cells)
+					{
+						continue;
+					}
+					p_coords[p_axis] = static_cast<uint32_t>(c);
+
+					if (p_axis + 1 < Dim)
+					{
+						visit_around(p_coords, p_center, p_axis + 1, p_budget - std::abs(offset), p_depth, p_func);
+					}
+					else
+					{
+						const Code code{ encode(p_coords, p_depth) };
+						const auto it{ m_nodes.find(code) };
+						if (it != m_nodes.end())
+						{
+							p_func(code, it->second);
+						}
+					}
+				}
+				p_coords[p_axis] = p_center[p_axis];
+			}
+
+			// insert (Dim - 1) zero bits between each bit of p_value
+			static Code spread(uint32_t p_value)
+			{
+				Code x{ p_value };
+				if constexpr (2 == Dim)
+				{
+					x = (x | (x << 16)) & 0x0000FFFF0000FFFF;
+					x = (x | (x << 8)) & 0x00FF00FF00FF00FF;
+					x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0F;
+					x = (x | (x << 2)) & 0x3333333333333333;
+					x = (x | (x << 1)) & 0x5555555555555555;
+				}
+				else
+				{
+					x &= 0x1FFFFF;
+					x = (x | (x << 32)) & 0x001F00000000FFFF;
+					x = (x | (x << 16)) & 0x001F0000FF0000FF;
+					x = (x | (x << 8)) & 0x100F00F00F00F00F;
+					x = (x | (x << 4)) & 0x10C30C30C30C30C3;
+					x = (x | (x << 2)) & 0x1249249249249249;
+				}
+				return x;
+			}
+
+			// spread() inverse
+			static uint32_t compact(Code p_value)
+			{
+				Code x{ p_value };
+				if constexpr (2 == Dim)
+				{
+					x &= 0x5555555555555555;
+					x = (x | (x >> 1)) & 0x3333333333333333;
+					x = (x | (x >> 2)) & 0x0F0F0F0F0F0F0F0F;
+					x = (x | (x >> 4)) & 0x00FF00FF00FF00FF;
+					x = (x | (x >> 8)) & 0x0000FFFF0000FFFF;
+					x = (x | (x >> 16)) & 0x00000000FFFFFFFF;
+				}
+				else
+				{
+					x &= 0x1249249249249249;
+					x = (x | (x >> 2)) & 0x10C30C30C30C30C3;
+					x = (x | (x >> 4)) & 0x100F00F00F00F00F;
+					x = (x | (x >> 8)) & 0x001F0000FF0000FF;
+					x = (x | (x >> 16)) & 0x001F00000000FFFF;
+					x = (x | (x >> 32)) & 0x00000000001FFFFF;
+				}
+				return static_cast<uint32_t>(x);
+			}
+		};
+
+		template <typename NodeData>
+		using LinearQuadTree = LinearXTree<2, NodeData>;
+
+		template <typename NodeData>
+		using LinearOctree = LinearXTree<3, NodeData>;
+
+	} // core
+} // mage
@@ -27,6 +27,9 @@
 #include "componentcontainer.h"
 #include "eventsource.h"
 #include <shared_mutex>
+#include <mutex>
+#include <memory>
+#include <algorithm>
 
 namespace mage
 {
@@ -41,22 +44,113 @@ namespace mage
 
         class Datacloud : public property::Singleton<Datacloud>, public mage::property::EventSource<DatacloudEvent, const std::string&, const std::string&>
         {
+        private:
+
+            struct SlotBase
+            {
+                virtual ~SlotBase() = default;
+                virtual void commit() = 0;
+
+                std::string id;
+                std::string tid;
+                bool        dirty{ false };
+            };
+
+            template<typename T>
+            struct Slot : public SlotBase
+            {
+                Slot(core::Component<T>* p_live) :
+                live(p_live),
+                snapshot(p_live->getPurpose())
+                {
+                }
+
+                void commit() override
+                {
+                    snapshot = live->getPurpose();
+                }
+
+                core::Component<T>* live{ nullptr };
+                T                   snapshot;
+            };
+
         public:
+
+            // typed access to a datacloud variable, resolved once : no lookup and no lock on read
+            // read() returns the value published by the last commitFrame() call, handle must be used from the frame thread
+            // handle becomes invalid when the variable is removed (slot released by the next commitFrame() call) : check isValid() before read()
+            template<typename T>
+            class DataHandle
+            {
+            public:
+                DataHandle() = default;
+
+                const T& read() const
+                {
+                    return m_slot->snapshot;
+                }
+
+                bool isValid() const
+                {
+                    return nullptr != m_slot && !m_alive.expired();
+                }
+
+            private:
+                Slot<T>*                    m_slot{ nullptr };
+                std::weak_ptr<SlotBase>     m_alive;
+
+                friend class Datacloud;
+            };
+
             Datacloud(void) = default;
             ~Datacloud() = default;
 
             template<typename T, class... Args>
-            void registerData(const std::string& p_id, Args&&... p_args)
+            DataHandle<T> registerData(const std::string& p_id, Args&&... p_args)
             {
                 std::unique_lock<std::shared_mutex> lock(m_mutex);
 
                 m_component_container.addComponent<T, Args...>(p_id, (std::forward<Args>(p_args))...);
 
-                const std::string tid{ typeid(T).name() };
-                for (const auto& call : m_callbacks)
+                auto slot{ std::make_shared<Slot<T>>(m_component_container.getComponent<T>(p_id)) };
+                slot->id = p_id;
+                slot->tid = typeid(T).name();
+
+                DataHandle<T> handle;
+                handle.m_slot = slot.get();
+                handle.m_alive = slot;
+
+                push_event(DatacloudEvent::DATA_ADDED, slot.get());
+                m_slots[p_id] = std::move(slot);
+                m_updates_count++;
+
+                return handle;
+            }
+
+            template<typename T>
+            DataHandle<T> getDataHandle(const std::string& p_id) const
+            {
+                std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+                if (0 == m_slots.count(p_id))
+                {
+                    _EXCEPTION("unknown data in datacloud: " + p_id);
+                }
+                if (m_component_container.getComponentsIdList().at(p_id) != typeid(T).hash_code())
                 {
-                    call(DatacloudEvent::DATA_ADDED, p_id, tid);
+                    _EXCEPTION("data type mismatch in datacloud: " + p_id);
                 }
+
+                DataHandle<T> handle;
+                handle.m_slot = static_cast<Slot<T>*>(m_slots.at(p_id).get());
+                handle.m_alive = m_slots.at(p_id);
+                return handle;
+            }
+
+            bool hasData(const std::string& p_id) const
+            {
+                std::shared_lock<std::shared_mutex> lock(m_mutex);
+                return m_slots.count(p_id) > 0;
             }
 
             template<typename T>
@@ -72,6 +166,12 @@ namespace mage
                 return comp->getPurpose();
             }
 
+            template<typename T>
+            const T& readDataValue(const DataHandle<T>& p_handle) const
+            {
+                return p_handle.read();
+            }
+
             template<typename T>
             void updateDataValue(const std::string& p_id, T value)
             {
@@ -82,15 +182,20 @@ namespace mage
                 {
                     _EXCEPTION("unknown data in datacloud: " + p_id);
                 }
-                auto& purpose{ comp->getPurpose() };
-                purpose = value;
+                comp->getPurpose() = value;
 
-                const std::string tid{ typeid(T).name() };
-                for (const auto& call : m_callbacks)
-                {
-                    call(DatacloudEvent::DATA_UPDATED, p_id, tid);
-                }
+                mark_dirty(m_slots.at(p_id).get());
+                m_updates_count++;
+            }
 
+            template<typename T>
+            void updateDataValue(const DataHandle<T>& p_handle, T value)
+            {
+                std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+                p_handle.m_slot->live->getPurpose() = value;
+                mark_dirty(p_handle.m_slot);
+                m_updates_count++;
             }
 
             template<typename T>
@@ -100,11 +205,54 @@ namespace mage
 
                 m_component_container.removeComponent<T>(p_id);
 
-                const std::string tid{ typeid(T).name() };
-                for (const auto& call : m_callbacks)
+                const auto it{ m_slots.find(p_id) };
+                const auto slot{ it->second.get() };
+                m_dirty_slots.erase(std::remove(m_dirty_slots.begin(), m_dirty_slots.end(), slot), m_dirty_slots.end());
+
+                // slot kept alive until events are dispatched : records refer to slot id and type (DATA_ADDED one included)
+                push_event(DatacloudEvent::DATA_REMOVED, slot);
+                m_removed_slots.push_back(std::move(it->second));
+                m_slots.erase(it);
+                m_updates_count++;
+            }
+
+            // frame boundary : publish updated values to handles snapshots, then dispatch events collected during the frame
+            // events are compact records (no id/type strings copies), queues storage is reused from frame to frame
+            void commitFrame()
+            {
+                {
+                    std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+                    for (const auto slot : m_dirty_slots)
+                    {
+                        slot->commit();
+                        slot->dirty = false;
+                        m_pending_events.push_back({ DatacloudEvent::DATA_UPDATED, slot });
+                    }
+                    m_dirty_slots.clear();
+
+                    m_dispatched_events.swap(m_pending_events);
+                    m_frame_committed = true;
+                    m_dispatched_removed_slots.swap(m_removed_slots);
+                }
+
+                // callbacks dispatched outside lock : they can read datacloud
+                for (const auto& e : m_dispatched_events)
                 {
-                    call(DatacloudEvent::DATA_REMOVED, p_id, tid);
+                    for (const auto& call : m_callbacks)
+                    {
+                        call(e.type, e.slot->id, e.slot->tid);
+                    }
                 }
+                m_dispatched_events.clear();
+                m_dispatched_removed_slots.clear();
+            }
+
+            // incremented on each add/update/remove : compare two readings to detect changes
+            size_t getUpdatesCount() const
+            {
+                std::shared_lock<std::shared_mutex> lock(m_mutex);
+                return m_updates_count;
             }
 
             const std::unordered_map<std::string, size_t>& getVarsIdsList() const
@@ -115,8 +263,49 @@ namespace mage
             }
 
         private:
-            core::ComponentContainer m_component_container;
-            mutable std::shared_mutex m_mutex;
+            core::ComponentContainer                                            m_component_container;
+            mutable std::shared_mutex                                           m_mutex;
+
+            // events kept until commitFrame() : if never called (no frame loop), newest ones are dropped beyond this count
+            static constexpr size_t                                             maxPendingEvents{ 4096 };
+            bool                                                                m_frame_committed{ false };
+
+            std::unordered_map<std::string, std::shared_ptr<SlotBase>>          m_slots;
+            std::vector<SlotBase*>                                              m_dirty_slots;
+
+            struct EventRecord
+            {
+                DatacloudEvent  type;
+                SlotBase*       slot{ nullptr };
+            };
+
+            std::vector<EventRecord>                                            m_pending_events;
+            std::vector<std::shared_ptr<SlotBase>>                              m_removed_slots;
+
+            // commitFrame() dispatch side, accessed from frame thread only
+            std::vector<EventRecord>                                            m_dispatched_events;
+            std::vector<std::shared_ptr<SlotBase>>                              m_dispatched_removed_slots;
+
+            size_t                                                              m_updates_count{ 0 };
+
+            void push_event(DatacloudEvent p_event, SlotBase* p_slot)
+            {
+                if (!m_frame_committed && m_pending_events.size() >= maxPendingEvents)
+                {
+                    // oldest records kept : subscribers still get first DATA_ADDED events
+                    return;
+                }
+                m_pending_events.push_back({ p_event, p_slot });
+            }
+
+            void mark_dirty(SlotBase* p_slot)
+            {
+                if (!p_slot->dirty)
+                {
+                    p_slot->dirty = true;
+                    m_dirty_slots.push_back(p_slot);
+                }
+            }
         };
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,78 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#include <unordered_map>
+
+#include "headlessrendergraphbackend.h"
+#include "exceptions.h"
+
+using namespace mage;
+using namespace mage::rendering;
+
+void HeadlessRendergraphBackend::execute(const RendergraphCompiler& p_compiler, const RendergraphCompiler::Result& p_result)
+{
+    std::unordered_map<std::string, const RendergraphCompiler::PassDescr*> passes;
+    for (const auto& pass : p_compiler.getPasses())
+    {
+        passes[pass.id] = &pass;
+    }
+
+    m_pooled_contents.assign(p_result.pool.size(), "");
+    m_executed_passes.clear();
+
+    for (const auto& pass_id : p_result.passes_order)
+    {
+        const auto& pass{ *passes.at(pass_id) };
+
+        for (const auto& input : pass.inputs)
+        {
+            const auto& content{ m_pooled_contents.at(p_result.targets_allocation.at(input)) };
+
+            // empty : not written yet during this frame
+            if (!content.empty() && content != input)
+            {
+                _EXCEPTION("Pass " + pass.id + " reads target " + input + " overwritten by " + content);
+            }
+        }
+
+        if (!pass.output.empty())
+        {
+            m_pooled_contents.at(p_result.targets_allocation.at(pass.output)) = pass.output;
+        }
+
+        m_executed_passes.push_back(pass.id);
+    }
+    m_frames_count++;
+}
+
+const std::vector<std::string>& HeadlessRendergraphBackend::getExecutedPasses() const
+{
+    return m_executed_passes;
+}
+
+size_t HeadlessRendergraphBackend::getFramesCount() const
+{
+    return m_frames_count;
+}
@@ -0,0 +1,57 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#pragma once
+#include <string>
+#include <vector>
+
+#include "rendergraphcompiler.h"
+
+namespace mage
+{
+    namespace rendering
+    {
+        // runs a compiled rendergraph without any renderer
+        // each pooled target holds id of last target written in it : reading a target already overwritten by an aliased one throws
+        class HeadlessRendergraphBackend
+        {
+        public:
+
+            HeadlessRendergraphBackend() = default;
+            ~HeadlessRendergraphBackend() = default;
+
+            void                                execute(const RendergraphCompiler& p_compiler, const RendergraphCompiler::Result& p_result);
+
+            const std::vector<std::string>&     getExecutedPasses() const;
+            size_t                              getFramesCount() const;
+
+        private:
+
+            std::vector<std::string>            m_pooled_contents;
+            std::vector<std::string>            m_executed_passes; // during last frame
+            size_t                              m_frames_count{ 0 };
+        };
+    }
+}
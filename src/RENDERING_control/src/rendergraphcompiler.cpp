@@ -0,0 +1,360 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#include <algorithm>
+#include <functional>
+
+#include "rendergraphcompiler.h"
+#include "exceptions.h"
+
+using namespace mage;
+using namespace mage::rendering;
+
+void RendergraphCompiler::addTarget(const TargetDescr& p_target)
+{
+    if (m_targets_index.count(p_target.id))
+    {
+        _EXCEPTION("Rendergraph target already declared : " + p_target.id);
+    }
+    m_targets_index[p_target.id] = m_targets.size();
+    m_targets.push_back(p_target);
+}
+
+void RendergraphCompiler::addPass(const PassDescr& p_pass)
+{
+    m_passes.push_back(p_pass);
+}
+
+void RendergraphCompiler::clear()
+{
+    m_targets.clear();
+    m_passes.clear();
+    m_targets_index.clear();
+}
+
+const std::vector<RendergraphCompiler::TargetDescr>& RendergraphCompiler::getTargets() const
+{
+    return m_targets;
+}
+
+const std::vector<RendergraphCompiler::PassDescr>& RendergraphCompiler::getPasses() const
+{
+    return m_passes;
+}
+
+size_t RendergraphCompiler::textureBytes(Texture::Format p_format, int p_width, int p_height)
+{
+    size_t texel_size{ 0 };
+    switch (p_format)
+    {
+        case Texture::Format::TEXTURE_RGB:              texel_size = 4; break;
+        case Texture::Format::TEXTURE_FLOAT:            texel_size = 2; break;
+        case Texture::Format::TEXTURE_FLOAT32:          texel_size = 4; break;
+        case Texture::Format::TEXTURE_FLOATVECTOR:      texel_size = 8; break;
+        case Texture::Format::TEXTURE_FLOATVECTOR32:    texel_size = 16; break;
+    }
+    return texel_size * static_cast<size_t>(p_width) * static_cast<size_t>(p_height);
+}
+
+RendergraphCompiler::Result RendergraphCompiler::compile() const
+{
+    Result result;
+
+    const size_t nb_passes{ m_passes.size() };
+
+    ///////// producers of each target
+
+    std::unordered_map<std::string, std::vector<size_t>> producers;
+
+    for (size_t i = 0; i < nb_passes; i++)
+    {
+        const auto& pass{ m_passes[i] };
+
+        for (const auto& input : pass.inputs)
+        {
+            if (!m_targets_index.count(input))
+            {
+                _EXCEPTION("Rendergraph pass " + pass.id + " reads unknown target " + input);
+            }
+        }
+
+        if (!pass.output.empty())
+        {
+            if (!m_targets_index.count(pass.output))
+            {
+                _EXCEPTION("Rendergraph pass " + pass.id + " writes unknown target " + pass.output);
+            }
+            producers[pass.output].push_back(i);
+        }
+    }
+
+    ///////// culling : keep only passes contributing to screen or to persistent targets
+
+    std::vector<bool> live(nb_passes, false);
+    std::vector<size_t> to_visit;
+
+    for (size_t i = 0; i < nb_passes; i++)
+    {
+        const auto& pass{ m_passes[i] };
+        if (pass.enabled && (pass.output.empty() || m_targets[m_targets_index.at(pass.output)].persistent))
+        {
+            live[i] = true;
+            to_visit.push_back(i);
+        }
+    }
+
+    while (!to_visit.empty())
+    {
+        const size_t current{ to_visit.back() };
+        to_visit.pop_back();
+
+        for (const auto& input : m_passes[current].inputs)
+        {
+            if (!producers.count(input))
+            {
+                continue;
+            }
+
+            for (const size_t producer : producers.at(input))
+            {
+                if (!live[producer] && m_passes[producer].enabled)
+                {
+                    live[producer] = true;
+                    to_visit.push_back(producer);
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < nb_passes; i++)
+    {
+        if (!live[i])
+        {
+            result.culled_passes.push_back(m_passes[i].id);
+        }
+    }
+
+    ///////// order : depth first from roots, so that each target is produced just before being consumed
+
+    enum class Visit
+    {
+        NONE,
+        RUNNING,
+        DONE
+    };
+
+    std::vector<Visit> visits(nb_passes, Visit::NONE);
+    std::vector<size_t> order;
+
+    const std::function<void(size_t)> visit
+    {
+        [&](size_t p_pass)
+        {
+            if (Visit::DONE == visits[p_pass])
+            {
+                return;
+            }
+            if (Visit::RUNNING == visits[p_pass])
+            {
+                _EXCEPTION("Rendergraph has a dependency cycle through pass " + m_passes[p_pass].id);
+            }
+
+            visits[p_pass] = Visit::RUNNING;
+
+            for (const auto& input : m_passes[p_pass].inputs)
+            {
+                if (!producers.count(input))
+                {
+                    continue;
+                }
+
+                for (const size_t producer : producers.at(input))
+                {
+                    if (producer != p_pass && live[producer])
+                    {
+                        visit(producer);
+                    }
+                }
+            }
+
+            visits[p_pass] = Visit::DONE;
+            order.push_back(p_pass);
+        }
+    };
+
+    for (size_t i = 0; i < nb_passes; i++)
+    {
+        if (live[i])
+        {
+            visit(i);
+        }
+    }
+
+    for (const size_t i : order)
+    {
+        result.passes_order.push_back(m_passes[i].id);
+    }
+
+    ///////// targets lifetimes, in positions in order
+
+    struct Lifetime
+    {
+        size_t first{ 0 };
+        size_t last{ 0 };
+        bool   used{ false };
+    };
+
+    std::vector<Lifetime> lifetimes(m_targets.size());
+
+    const auto use_target
+    {
+        [&](const std::string& p_target, size_t p_position)
+        {
+            auto& lifetime{ lifetimes[m_targets_index.at(p_target)] };
+            if (!lifetime.used)
+            {
+                lifetime.first = p_position;
+                lifetime.last = p_position;
+                lifetime.used = true;
+            }
+            else
+            {
+                lifetime.first = std::min(lifetime.first, p_position);
+                lifetime.last = std::max(lifetime.last, p_position);
+            }
+        }
+    };
+
+    for (size_t position = 0; position < order.size(); position++)
+    {
+        const auto& pass{ m_passes[order[position]] };
+
+        for (const auto& input : pass.inputs)
+        {
+            use_target(input, position);
+        }
+        if (!pass.output.empty())
+        {
+            use_target(pass.output, position);
+        }
+    }
+
+    ///////// pooling : greedy allocation by first use
+
+    std::vector<size_t> used_targets;
+    for (size_t i = 0; i < m_targets.size(); i++)
+    {
+        result.declared_bytes += textureBytes(m_targets[i].format, m_targets[i].width, m_targets[i].height);
+
+        if (lifetimes[i].used)
+        {
+            used_targets.push_back(i);
+        }
+    }
+
+    std::stable_sort(used_targets.begin(), used_targets.end(), [&](size_t p_a, size_t p_b) { return lifetimes[p_a].first < lifetimes[p_b].first; });
+
+    std::vector<size_t> pool_last_use;
+    std::vector<bool> pool_persistent;
+
+    for (const size_t i : used_targets)
+    {
+        const auto& target{ m_targets[i] };
+        const auto& lifetime{ lifetimes[i] };
+
+        size_t slot{ result.pool.size() };
+
+        if (!target.persistent)
+        {
+            for (size_t j = 0; j < result.pool.size(); j++)
+            {
+                const auto& pooled{ result.pool[j] };
+
+                if (!pool_persistent[j] && pool_last_use[j] < lifetime.first &&
+                    pooled.format == target.format && pooled.width == target.width && pooled.height == target.height)
+                {
+                    slot = j;
+                    break;
+                }
+            }
+        }
+
+        if (result.pool.size() == slot)
+        {
+            PooledTarget pooled;
+            pooled.format = target.format;
+            pooled.width = target.width;
+            pooled.height = target.height;
+
+            result.pool.push_back(pooled);
+            pool_last_use.push_back(0);
+            pool_persistent.push_back(target.persistent);
+
+            result.allocated_bytes += textureBytes(target.format, target.width, target.height);
+        }
+
+        result.pool[slot].targets.push_back(target.id);
+        pool_last_use[slot] = lifetime.last;
+        result.targets_allocation[target.id] = slot;
+    }
+
+    return result;
+}
+
+std::string RendergraphCompiler::Result::report() const
+{
+    std::string report{ "rendergraph : " + std::to_string(passes_order.size()) + " passes, " + std::to_string(culled_passes.size()) + " culled\n" };
+
+    report += "order :";
+    for (const auto& pass : passes_order)
+    {
+        report += " " + pass;
+    }
+    report += "\n";
+
+    if (culled_passes.size() > 0)
+    {
+        report += "culled :";
+        for (const auto& pass : culled_passes)
+        {
+            report += " " + pass;
+        }
+        report += "\n";
+    }
+
+    report += "targets : " + std::to_string(declared_bytes) + " bytes declared, " + std::to_string(allocated_bytes) + " bytes allocated in " +
+                std::to_string(pool.size()) + " pooled targets, " + std::to_string(declared_bytes - allocated_bytes) + " bytes saved\n";
+
+    for (size_t i = 0; i < pool.size(); i++)
+    {
+        report += "pooled target " + std::to_string(i) + " (" + std::to_string(pool[i].width) + "x" + std::to_string(pool[i].height) + ") :";
+        for (const auto& target : pool[i].targets)
+        {
+            report += " " + target;
+        }
+        report += "\n";
+    }
+    return report;
+}
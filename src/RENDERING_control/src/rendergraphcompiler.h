@@ -0,0 +1,117 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "texture.h"
+
+namespace mage
+{
+    namespace rendering
+    {
+        // rendergraph compile step, independant from any renderer :
+        // 
+        //  > passes dependencies deduced from targets written and read
+        //  > passes whose output is never consumed are culled
+        //  > transient targets with same format and dims and disjoint lifetimes share the same pooled target
+        class RendergraphCompiler
+        {
+        public:
+
+            struct TargetDescr
+            {
+                std::string             id;
+                Texture::Format         format{ Texture::Format::TEXTURE_RGB };
+                int                     width{ 0 };
+                int                     height{ 0 };
+                bool                    persistent{ false }; // read outside of rendergraph (scene entities, CPU...) : never culled nor aliased
+
+                bool operator==(const TargetDescr& p_other) const
+                {
+                    return id == p_other.id && format == p_other.format && width == p_other.width && height == p_other.height && persistent == p_other.persistent;
+                }
+            };
+
+            struct PassDescr
+            {
+                std::string                 id;
+                std::vector<std::string>    inputs;     // targets read
+                std::string                 output;     // target written, empty for screen
+                bool                        enabled{ true };
+
+                bool operator==(const PassDescr& p_other) const
+                {
+                    return id == p_other.id && inputs == p_other.inputs && output == p_other.output && enabled == p_other.enabled;
+                }
+            };
+
+            struct PooledTarget
+            {
+                Texture::Format             format{ Texture::Format::TEXTURE_RGB };
+                int                         width{ 0 };
+                int                         height{ 0 };
+                std::vector<std::string>    targets;    // targets aliased on this one, in first use order
+            };
+
+            struct Result
+            {
+                std::vector<std::string>                    passes_order;       // passes to render, in this order
+                std::vector<std::string>                    culled_passes;
+
+                std::unordered_map<std::string, size_t>     targets_allocation; // target id -> index in pool
+                std::vector<PooledTarget>                   pool;
+
+                size_t                                      declared_bytes{ 0 };    // one dedicated texture per declared target
+                size_t                                      allocated_bytes{ 0 };   // pooled textures
+
+                std::string report() const;
+            };
+
+            RendergraphCompiler() = default;
+            ~RendergraphCompiler() = default;
+
+            void                                addTarget(const TargetDescr& p_target);
+            void                                addPass(const PassDescr& p_pass);
+            void                                clear();
+
+            const std::vector<TargetDescr>&     getTargets() const;
+            const std::vector<PassDescr>&       getPasses() const;
+
+            Result                              compile() const;
+
+            static size_t                       textureBytes(Texture::Format p_format, int p_width, int p_height);
+
+        private:
+
+            std::vector<TargetDescr>                    m_targets;
+            std::vector<PassDescr>                      m_passes;
+
+            std::unordered_map<std::string, size_t>     m_targets_index;
+        };
+    }
+}
@@ -98,7 +98,7 @@ void Queue::pushText(const Queue::Text& p_text)
 	m_texts.push_back(p_text);
 }
 
-Queue::QueueNodes Queue::getQueueNodes() const
+const Queue::QueueNodes& Queue::getQueueNodes() const
 {
 	return m_queueNodes;
 }
@@ -133,6 +133,11 @@ std::string	Queue::getTargetTextureUID() const
 	return m_targetTextureUID;
 }
 
+bool Queue::isCulled() const
+{
+	return m_culled;
+}
+
 void Queue::setTargetStage(size_t p_stage)
 {
 	m_targetStage = p_stage;
@@ -34,8 +34,11 @@
 #include "tvector.h"
 #include "matrix.h"
 #include "renderstate.h"
+#include "renderstateblock.h"
 #include "shader.h"
 #include "texture.h"
+#include "datacloud.h"
+#include "entityhandle.h"
 
 namespace mage
 {
@@ -84,6 +87,7 @@ namespace mage
 
 
 			std::string owner_entity_id; // to be completed by queue system
+			core::EntityHandle owner_entity; // to be completed by queue system
 
 			bool				draw{ true };
 
@@ -102,15 +106,24 @@ namespace mage
 			bool* projected_z_neg{ nullptr };
 
 			// shaders generic params to apply
-			// dataCloud variable id/shader argument
-			std::vector<std::pair<std::string, mage::Shader::GenericArgument>>	vshaders_map_cnx; // computed from vshaders_map and the queue current vshader
-			std::vector<std::pair<std::string, mage::Shader::GenericArgument>>	pshaders_map_cnx; // computed from pshaders_map and the queue current pshader
+			struct ShaderArgConnection
+			{
+				std::string										datacloud_id;
+				mage::Shader::GenericArgument					argument;
+
+				// resolved at connection time if dataCloud variable already exists
+				Datacloud::DataHandle<core::maths::Real4Vector>	real4vector;
+			};
+
+			std::vector<ShaderArgConnection>	vshaders_map_cnx; // computed from vshaders_map and the queue current vshader
+			std::vector<ShaderArgConnection>	pshaders_map_cnx; // computed from pshaders_map and the queue current pshader
 
 			// shaders vector arrays to apply
 			const std::vector<mage::Shader::VectorArrayArgument>* vshaders_vector_array{ nullptr };
 			const std::vector<mage::Shader::VectorArrayArgument>* pshaders_vector_array{ nullptr };
 
 			std::string owner_entity_id;
+			core::EntityHandle owner_entity;
 
 			bool* draw{ nullptr };
 		};
@@ -180,17 +193,20 @@ namespace mage
 				// renderstates set
 				std::vector<RenderState>								description;
 
+				// same set, compiled once at registration
+				RenderStateBlock										block;
+
 				// key = triangleMeshe D3D11 id
 				//std::unordered_map<std::string, TriangleMeshePayload>	trianglemeshes_list;
 
 				// key = lineMeshe D3D11 id
 				//std::unordered_map<std::string, LineMeshePayload>		linemeshes_list;
 
-				// key = QueueTrianglesDrawingControl unique id
-				std::unordered_map<std::string, QueueTrianglesDrawingControl>	triangles_dc_list;
+				// key = QueueTrianglesDrawingControl owner entity
+				std::unordered_map<core::EntityHandle, QueueTrianglesDrawingControl>	triangles_dc_list;
 
-				// key = QueueLinesDrawingControl unique id
-				std::unordered_map<std::string, QueueLinesDrawingControl>		lines_dc_list;
+				// key = QueueLinesDrawingControl owner entity
+				std::unordered_map<core::EntityHandle, QueueLinesDrawingControl>		lines_dc_list;
 
 				
 
@@ -200,8 +216,8 @@ namespace mage
 			{ 
 				std::vector<std::string> shaders_ids; // ALWAYS 2 entries for now (vertex shader, pixel shader)
 
-				// key = renderstate set strings dump concatenation (RenderState::toString())
-				std::unordered_map<std::string, RenderStatePayload> list;
+				// key = renderstate set hash (RenderStateBlock::computeHash())
+				std::unordered_map<RenderStateBlock::Hash, RenderStatePayload> list;
 			};
 
 			struct RenderingOrderChannel
@@ -234,7 +250,7 @@ namespace mage
 
 			void						pushText(const Text& p_text);
 			
-			QueueNodes					getQueueNodes() const;
+			const QueueNodes&			getQueueNodes() const;
 			void						setQueueNodes(const QueueNodes& p_nodes);
 
 			void						setMainView(const std::string& p_entityId);
@@ -246,6 +262,8 @@ namespace mage
 			
 			std::string					getTargetTextureUID() const;
 
+			bool						isCulled() const;
+
 			void						setTargetStage(size_t p_stage);
 
 			void						resetStates();
@@ -273,6 +291,8 @@ namespace mage
 			size_t							m_targetStage{ 0 };
 
 			std::string						m_targetTextureUID; // for BUFFER_RENDERING
+
+			bool							m_culled{ false }; // output not consumed in rendergraph (see RendergraphCompiler) : not rendered
 	
 			void							setState(State p_newstate);
 
@@ -63,12 +63,12 @@ RenderState::Operation RenderState::getOperation(void) const
     return m_operation;
 }
 
-std::string RenderState::getArg(void) const
+const std::string& RenderState::getArg(void) const
 {
     return m_arg;
 }
 
-std::vector<std::string> RenderState::getExtendedArgs(void) const
+const std::vector<std::string>& RenderState::getExtendedArgs(void) const
 {
     return m_extendedargs;
 }
@@ -63,8 +63,8 @@ namespace mage
             std::string toString(void) const;
 
             Operation getOperation(void) const;
-            std::string getArg(void) const;
-            std::vector<std::string> getExtendedArgs(void) const;
+            const std::string& getArg(void) const;
+            const std::vector<std::string>& getExtendedArgs(void) const;
 
         private:
             std::string                             m_arg;         //argument operation renderstate, sous forme de chaine ascii
@@ -0,0 +1,254 @@
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#include <unordered_map>
+#include "renderstateblock.h"
+#include "exceptions.h"
+
+using namespace mage::rendering;
+
+static constexpr uint64_t fnvOffsetBasis{ 14695981039346656037ULL };
+static constexpr uint64_t fnvPrime{ 1099511628211ULL };
+
+static void hash_bytes(uint64_t& p_hash, const char* p_bytes, size_t p_length)
+{
+    for (size_t i = 0; i < p_length; i++)
+    {
+        p_hash ^= static_cast<uint8_t>(p_bytes[i]);
+        p_hash *= fnvPrime;
+    }
+}
+
+static void hash_string(uint64_t& p_hash, const std::string& p_str)
+{
+    hash_bytes(p_hash, p_str.c_str(), p_str.size() + 1); // include terminal 0 as separator
+}
+
+static RenderStateBlock::Sampler compile_sampler(const std::string& p_arg)
+{
+    static const std::unordered_map<std::string, RenderStateBlock::Sampler> translate =
+    {
+        { "none",               RenderStateBlock::Sampler::NONE                 },
+        { "point",              RenderStateBlock::Sampler::POINT                },
+        { "linear",             RenderStateBlock::Sampler::LINEAR               },
+        { "anisotropic",        RenderStateBlock::Sampler::ANISOTROPIC          },
+        { "point_uvwrap",       RenderStateBlock::Sampler::POINT_UVWRAP         },
+        { "linear_uvwrap",      RenderStateBlock::Sampler::LINEAR_UVWRAP        },
+        { "anisotropic_uvwrap", RenderStateBlock::Sampler::ANISOTROPIC_UVWRAP   }
+    };
+
+    if (!translate.count(p_arg))
+    {
+        _EXCEPTION("unknown texture filter type : " + p_arg)
+    }
+    return translate.at(p_arg);
+}
+
+static void compile_samplers(const RenderState& p_renderstate, RenderStateBlock::Samplers& p_samplers)
+{
+    if ("extended" == p_renderstate.getArg())
+    {
+        const auto& args_list{ p_renderstate.getExtendedArgs() };
+        if (args_list.size() > RenderStateBlock::maxSamplersStages)
+        {
+            _EXCEPTION("too many extended texture filter types : " + std::to_string(args_list.size()))
+        }
+
+        p_samplers.extended = true;
+        p_samplers.nbStages = 0;
+        for (const auto& e : args_list)
+        {
+            p_samplers.stages[p_samplers.nbStages++] = compile_sampler(e);
+        }
+    }
+    else
+    {
+        p_samplers.extended = false;
+        p_samplers.global = compile_sampler(p_renderstate.getArg());
+    }
+}
+
+static RenderStateBlock::BlendFactor compile_blendfactor(const std::string& p_arg)
+{
+    static const std::unordered_map<std::string, RenderStateBlock::BlendFactor> translate =
+    {
+        { "zero",           RenderStateBlock::BlendFactor::ZERO         },
+        { "one",            RenderStateBlock::BlendFactor::ONE          },
+        { "srccolor",       RenderStateBlock::BlendFactor::SRCCOLOR     },
+        { "invsrccolor",    RenderStateBlock::BlendFactor::INVSRCCOLOR  },
+        { "srcalpha",       RenderStateBlock::BlendFactor::SRCALPHA     },
+        { "invsrcalpha",    RenderStateBlock::BlendFactor::INVSRCALPHA  },
+        { "destalpha",      RenderStateBlock::BlendFactor::DESTALPHA    },
+        { "invdestalpha",   RenderStateBlock::BlendFactor::INVDESTALPHA },
+        { "destcolor",      RenderStateBlock::BlendFactor::DESTCOLOR    },
+        { "invdestcolor",   RenderStateBlock::BlendFactor::INVDESTCOLOR }
+    };
+
+    const auto it{ translate.find(p_arg) };
+    return (it != translate.end() ? it->second : RenderStateBlock::BlendFactor::UNSET);
+}
+
+static RenderStateBlock::BlendOp compile_blendop(const std::string& p_arg)
+{
+    static const std::unordered_map<std::string, RenderStateBlock::BlendOp> translate =
+    {
+        { "add",    RenderStateBlock::BlendOp::ADD      },
+        { "sub",    RenderStateBlock::BlendOp::SUB      },
+        { "revsub", RenderStateBlock::BlendOp::REVSUB   },
+        { "min",    RenderStateBlock::BlendOp::MIN      },
+        { "max",    RenderStateBlock::BlendOp::MAX      }
+    };
+
+    const auto it{ translate.find(p_arg) };
+    return (it != translate.end() ? it->second : RenderStateBlock::BlendOp::UNSET);
+}
+
+RenderStateBlock::RenderStateBlock(const std::vector<RenderState>& p_description) :
+hash(computeHash(p_description))
+{
+    for (const auto& rs : p_description)
+    {
+        const auto& arg{ rs.getArg() };
+
+        switch (rs.getOperation())
+        {
+            case RenderState::Operation::ENABLEZBUFFER:
+
+                zbuffer = ("true" == arg ? Toggle::ENABLED : Toggle::DISABLED);
+                break;
+
+            case RenderState::Operation::SETCULLING:
+
+                if ("none" == arg)
+                {
+                    culling = Culling::NONE;
+                }
+                else if ("cw" == arg)
+                {
+                    culling = Culling::CW;
+                }
+                else
+                {
+                    culling = Culling::CCW;
+                }
+                break;
+
+            case RenderState::Operation::SETFILLMODE:
+
+                if ("line" == arg)
+                {
+                    fillmode = FillMode::LINE;
+                }
+                else if ("solid" == arg)
+                {
+                    fillmode = FillMode::SOLID;
+                }
+                break;
+
+            case RenderState::Operation::SETTEXTUREFILTERTYPE:
+
+                compile_samplers(rs, psSamplers);
+                break;
+
+            case RenderState::Operation::SETVERTEXTEXTUREFILTERTYPE:
+
+                compile_samplers(rs, vsSamplers);
+                break;
+
+            case RenderState::Operation::ALPHABLENDENABLE:
+
+                if ("true" == arg)
+                {
+                    alphablend = Toggle::ENABLED;
+                }
+                else if ("false" == arg)
+                {
+                    alphablend = Toggle::DISABLED;
+                }
+                break;
+
+            case RenderState::Operation::ALPHABLENDOP:
+
+                alphablendOp = compile_blendop(arg);
+                break;
+
+            case RenderState::Operation::ALPHABLENDFUNC:
+
+                alphablendFunc = ("always" == arg ? BlendFunc::ALWAYS : BlendFunc::OTHER);
+                break;
+
+            case RenderState::Operation::ALPHABLENDSRC:
+
+                alphablendSrc = compile_blendfactor(arg);
+                break;
+
+            case RenderState::Operation::ALPHABLENDDEST:
+
+                alphablendDest = compile_blendfactor(arg);
+                break;
+
+            case RenderState::Operation::NONE:
+            default:
+
+                break;
+        }
+    }
+}
+
+RenderStateBlock::Hash RenderStateBlock::computeHash(const std::vector<RenderState>& p_description)
+{
+    uint64_t hash{ fnvOffsetBasis };
+
+    for (const auto& rs : p_description)
+    {
+        const auto operation{ static_cast<int>(rs.getOperation()) };
+        hash_bytes(hash, reinterpret_cast<const char*>(&operation), sizeof(operation));
+        hash_string(hash, rs.getArg());
+
+        for (const auto& e : rs.getExtendedArgs())
+        {
+            hash_string(hash, e);
+        }
+    }
+    return hash;
+}
+
+bool RenderStateBlock::sameDescription(const std::vector<RenderState>& p_a, const std::vector<RenderState>& p_b)
+{
+    if (p_a.size() != p_b.size())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < p_a.size(); i++)
+    {
+        if (p_a[i].getOperation() != p_b[i].getOperation() ||
+            p_a[i].getArg() != p_b[i].getArg() ||
+            p_a[i].getExtendedArgs() != p_b[i].getExtendedArgs())
+        {
+            return false;
+        }
+    }
+    return true;
+}
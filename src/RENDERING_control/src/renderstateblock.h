@@ -0,0 +1,146 @@
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "renderstate.h"
+
+namespace mage
+{
+    namespace rendering
+    {
+        // RenderState list compiled once in a binary form : no more string parsing at draw time
+        // fields left to UNSET keep the current renderer state, as with the original RenderState list
+        struct RenderStateBlock
+        {
+            using Hash = uint64_t;
+
+            static constexpr int maxSamplersStages{ 16 };
+
+            enum class Toggle : uint8_t
+            {
+                UNSET,
+                DISABLED,
+                ENABLED
+            };
+
+            enum class Culling : uint8_t
+            {
+                UNSET,
+                NONE,
+                CW,
+                CCW
+            };
+
+            enum class FillMode : uint8_t
+            {
+                UNSET,
+                SOLID,
+                LINE
+            };
+
+            enum class Sampler : uint8_t
+            {
+                UNSET,
+                NONE,
+                POINT,
+                LINEAR,
+                ANISOTROPIC,
+                POINT_UVWRAP,
+                LINEAR_UVWRAP,
+                ANISOTROPIC_UVWRAP
+            };
+
+            enum class BlendOp : uint8_t
+            {
+                UNSET,
+                ADD,
+                SUB,
+                REVSUB,
+                MIN,
+                MAX
+            };
+
+            enum class BlendFunc : uint8_t
+            {
+                UNSET,
+                ALWAYS,
+                OTHER
+            };
+
+            enum class BlendFactor : uint8_t
+            {
+                UNSET,
+                ZERO,
+                ONE,
+                SRCCOLOR,
+                INVSRCCOLOR,
+                SRCALPHA,
+                INVSRCALPHA,
+                DESTALPHA,
+                INVDESTALPHA,
+                DESTCOLOR,
+                INVDESTCOLOR
+            };
+
+            struct Samplers
+            {
+                bool        extended{ false };
+                Sampler     global{ Sampler::UNSET };
+
+                // used only when extended == true
+                Sampler     stages[maxSamplersStages]{};
+                int         nbStages{ 0 };
+            };
+
+            RenderStateBlock(void) = default;
+            explicit RenderStateBlock(const std::vector<RenderState>& p_description);
+            ~RenderStateBlock() = default;
+
+            // same value for identical lists, computed without building any intermediate string
+            static Hash computeHash(const std::vector<RenderState>& p_description);
+
+            // hash is not collision-free : check this before sharing a block between two lists
+            static bool sameDescription(const std::vector<RenderState>& p_a, const std::vector<RenderState>& p_b);
+
+            Hash            hash{ 0 };
+
+            Toggle          zbuffer{ Toggle::UNSET };
+            Culling         culling{ Culling::UNSET };
+            FillMode        fillmode{ FillMode::UNSET };
+
+            Samplers        psSamplers;
+            Samplers        vsSamplers;
+
+            Toggle          alphablend{ Toggle::UNSET };
+            BlendOp         alphablendOp{ BlendOp::UNSET };
+            BlendFunc       alphablendFunc{ BlendFunc::UNSET };
+            BlendFactor     alphablendSrc{ BlendFactor::UNSET };
+            BlendFactor     alphablendDest{ BlendFactor::UNSET };
+        };
+    }
+}
@@ -23,7 +23,6 @@
 /* -*-LIC_END-*- */
 
 #include <vector>
-#include <chrono>
 #include <string>
 #include <unordered_map>
 #include <map>
@@ -37,6 +36,7 @@
 
 #include "animations.h"
 #include "animationssystem.h"
+#include "profiler.h"
 #include "scenenode.h"
 #include "entity.h"
 #include "entitygraph.h"
@@ -57,9 +57,11 @@ using namespace mage::core;
 
 AnimationsSystem::AnimationsSystem(Entitygraph& p_entitygraph) : System(p_entitygraph)
 {
-	const auto dataCloud{ mage::rendering::Datacloud::getInstance() };
-	dataCloud->registerData<std::string>("mage.timings.animationssystem");
-
+	declareAccess(core::timeAspect::id, core::SystemAccess::READ);
+	declareAccess(core::animationsAspect::id, core::SystemAccess::WRITE);
+	declareAccess(core::resourcesAspect::id, core::SystemAccess::WRITE); // vertex shaders bones args
+	// ANIMATION_START/ANIMATION_END application callbacks
+	declareExclusive();
 }
 
 static void send_bones_to_shaders(TriangleMeshe& p_meshe, /*Shader& p_vertex_shader*/ std::vector<std::pair<std::string, Shader>*>& p_vshaders_refs, int p_animationbones_array_arg_index)
@@ -121,14 +123,12 @@ static void send_bones_to_shaders(TriangleMeshe& p_meshe, /*Shader& p_vertex_sha
 		{
 			for (size_t col = 0; col < 3; col++)
 			{
-				core::maths::Real4Vector columns;
-
-				columns[0] = animationBones.at(i).final_transformation(0, col);
-				columns[1] = animationBones.at(i).final_transformation(1, col);
-				columns[2] = animationBones.at(i).final_transformation(2, col);
-				columns[3] = animationBones.at(i).final_transformation(3, col);
+				auto& columns{ dest_array.array[dest_vector_index++] };
 
-				dest_array.array[dest_vector_index++] = columns;
+				columns[0] = static_cast<float>(animationBones.at(i).final_transformation(0, col));
+				columns[1] = static_cast<float>(animationBones.at(i).final_transformation(1, col));
+				columns[2] = static_cast<float>(animationBones.at(i).final_transformation(2, col));
+				columns[3] = static_cast<float>(animationBones.at(i).final_transformation(3, col));
 			}
 		}
 	}
@@ -316,7 +316,7 @@ bool AnimationsSystem::animation_step(core::TimeMark& p_tmk, const AnimationKeys
 
 void AnimationsSystem::run()
 {
-	const auto start_time{ std::chrono::high_resolution_clock::now() };
+	_MAGE_PROFILE_ZONE("animationssystem");
 
 	auto entities_with_anim{ m_entitygraph.getEntitiesListForAspect(core::animationsAspect::id) };
 	for (Entity* entity : entities_with_anim)
@@ -553,10 +553,4 @@ void AnimationsSystem::run()
 		}
 
 	}
-
-	const auto end_time{ std::chrono::high_resolution_clock::now() };
-	const auto duration{ std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time) };
-	const auto dataCloud{ mage::rendering::Datacloud::getInstance() };
-	dataCloud->updateDataValue<std::string>("mage.timings.animationssystem", std::to_string(duration.count()) + " ms");
-
 }
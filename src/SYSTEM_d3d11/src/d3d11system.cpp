@@ -26,10 +26,10 @@
 #pragma warning( disable : 4005 4838 )
 
 #include <utility>
-#include <chrono>
 #include <string>
 
 #include "d3d11system.h"
+#include "profiler.h"
 
 #include "logsink.h"
 #include "logconf.h"
@@ -73,9 +73,18 @@ static const auto d3dimpl{ D3D11SystemImpl::getInstance() };
 D3D11System::D3D11System(Entitygraph& p_entitygraph, int p_renderingqueuesystem_slot) : System(p_entitygraph),
 m_renderingqueuesystem_slot(p_renderingqueuesystem_slot)
 {
+	declareAccess(core::cameraAspect::id, core::SystemAccess::READ);
+	declareAccess(core::worldAspect::id, core::SystemAccess::READ);
+	declareAccess(core::resourcesAspect::id, core::SystemAccess::WRITE);
+	declareAccess(core::renderingAspect::id, core::SystemAccess::WRITE);
+	declareMainThreadOnly();
+	// D3D11_WINDOW_READY handlers build application scenegraph
+	declareExclusive();
+
 	const auto dataCloud{ mage::rendering::Datacloud::getInstance() };
-	dataCloud->registerData<std::string>("mage.timings.d3d11system");
-	
+	m_shaderargs_uploaded_bytes = dataCloud->registerData<long>("mage.d3d11system.shaderargs_uploaded_bytes");
+	m_instances_uploaded_bytes = dataCloud->registerData<long>("mage.d3d11system.instances_uploaded_bytes");
+
 	m_shadercompilation_invocation_cb = [&, this](const std::string& p_includePath,
 		const mage::core::FileContent<const char>& p_src,		
 		int p_shaderType,
@@ -423,10 +432,10 @@ void D3D11System::renderQueue(const rendering::Queue& p_renderingQueue) const
 	}
 	
 	{
-		auto qnodes{ p_renderingQueue.getQueueNodes() };
+		const auto& qnodes{ p_renderingQueue.getQueueNodes() };
 		for (const auto& qnode : qnodes)
 		{
-			const rendering::Queue::RenderingOrderChannel rendering_channel{ qnode.second };
+			const rendering::Queue::RenderingOrderChannel& rendering_channel{ qnode.second };
 
 			for (const auto& shadersInfo : rendering_channel.list)
 			{
@@ -438,21 +447,7 @@ void D3D11System::renderQueue(const rendering::Queue& p_renderingQueue) const
 
 				for (const auto& renderStatesInfo : shaderPayload.list)
 				{
-					const auto renderStates{ renderStatesInfo.second.description };
-					for (const auto& renderState : renderStates)
-					{
-						d3dimpl->setDepthStenciState(renderState);
-						d3dimpl->setPSSamplers(renderState);
-						d3dimpl->setVSSamplers(renderState);
-
-						// prepare updates
-						d3dimpl->prepareRenderState(renderState);
-						d3dimpl->prepareBlendState(renderState);
-					}
-
-					// apply updates
-					d3dimpl->setCacheRS();
-					d3dimpl->setCacheBlendstate();
+					d3dimpl->applyRenderStateBlock(renderStatesInfo.second.block);
 
 					///////////// TriangleMeshes BEGIN
 
@@ -464,7 +459,7 @@ void D3D11System::renderQueue(const rendering::Queue& p_renderingQueue) const
 
 					for (const auto& triangleMesheInfo : renderStatesInfo.second.triangles_dc_list)
 					{
-						const mage::rendering::QueueTrianglesDrawingControl tdc{ triangleMesheInfo.second };
+						const mage::rendering::QueueTrianglesDrawingControl& tdc{ triangleMesheInfo.second };
 
 						if (*tdc.draw)
 						{
@@ -488,55 +483,53 @@ void D3D11System::renderQueue(const rendering::Queue& p_renderingQueue) const
 
 							for (const auto& e : tdc.vshaders_map_cnx)
 							{
-								const auto& datacloud_data_id{ e.first };
-								const auto& shader_param{ e.second };
+								const auto& shader_param{ e.argument };
 
 								if ("Real4Vector" == shader_param.argument_type)
 								{
-									const maths::Real4Vector rvector{ { dataCloud->readDataValue<maths::Real4Vector>(datacloud_data_id) } };
-									d3dimpl->setVertexshaderConstantsVec(shader_param.shader_register, rvector);
+									if (e.real4vector.isValid())
+									{
+										d3dimpl->setVertexshaderConstantsVec(shader_param.shader_register, e.real4vector.read());
+									}
+									else
+									{
+										const maths::Real4Vector rvector{ { dataCloud->readDataValue<maths::Real4Vector>(e.datacloud_id) } };
+										d3dimpl->setVertexshaderConstantsVec(shader_param.shader_register, rvector);
+									}
 								}
 							}
 
 							for (const auto& e : tdc.pshaders_map_cnx)
 							{
-								const auto& datacloud_data_id{ e.first };
-								const auto& shader_param{ e.second };
+								const auto& shader_param{ e.argument };
 
 								if ("Real4Vector" == shader_param.argument_type)
 								{
-									const maths::Real4Vector rvector{ { dataCloud->readDataValue<maths::Real4Vector>(datacloud_data_id) } };
-									d3dimpl->setPixelshaderConstantsVec(shader_param.shader_register, rvector);
+									if (e.real4vector.isValid())
+									{
+										d3dimpl->setPixelshaderConstantsVec(shader_param.shader_register, e.real4vector.read());
+									}
+									else
+									{
+										const maths::Real4Vector rvector{ { dataCloud->readDataValue<maths::Real4Vector>(e.datacloud_id) } };
+										d3dimpl->setPixelshaderConstantsVec(shader_param.shader_register, rvector);
+									}
 								}
 							}
 
 							if (tdc.vshaders_vector_array)
 							{
-								for (int i = 0; i < tdc.vshaders_vector_array->size(); i++)
+								for (const auto& arg : *tdc.vshaders_vector_array)
 								{
-									const mage::Shader::VectorArrayArgument& arg{ tdc.vshaders_vector_array->at(i) };
-									int curr_register{ arg.start_shader_register };
-
-									for (int j = 0; j < arg.array.size(); j++)
-									{
-										d3dimpl->setVertexshaderConstantsVec(curr_register, arg.array[j]);
-										curr_register++;
-									}
+									d3dimpl->setVertexshaderConstantsVecArray(arg.start_shader_register, arg.array);
 								}
 							}
 
 							if (tdc.pshaders_vector_array)
 							{
-								for (int i = 0; i < tdc.pshaders_vector_array->size(); i++)
+								for (const auto& arg : *tdc.pshaders_vector_array)
 								{
-									const mage::Shader::VectorArrayArgument& arg{ tdc.pshaders_vector_array->at(i) };
-									int curr_register{ arg.start_shader_register };
-
-									for (int j = 0; j < arg.array.size(); j++)
-									{
-										d3dimpl->setPixelshaderConstantsVec(curr_register, arg.array[j]);
-										curr_register++;
-									}
+									d3dimpl->setPixelshaderConstantsVecArray(arg.start_shader_register, arg.array);
 								}
 							}
 
@@ -544,10 +537,17 @@ void D3D11System::renderQueue(const rendering::Queue& p_renderingQueue) const
 
 							if (!(*tdc.projected_z_neg))
 							{
-								d3dimpl->updateMesheTransformersForPrimitive<D3D11SystemImpl::Primitives::TRIANGLES>(tdc.meshe_id, tdc.worlds, current_mainview_view, current_mainview_proj, current_secondaryiew_view, current_secondaryview_proj);
-								d3dimpl->bindShadersConstantBuffers(current_mainview_view, current_mainview_proj, current_secondaryiew_view, current_secondaryview_proj);
+								if (d3dimpl->updateInstancesTransformers(tdc.worlds, current_mainview_view, current_mainview_proj, current_secondaryiew_view, current_secondaryview_proj))
+								{
+									d3dimpl->bindShadersConstantBuffers(current_mainview_view, current_mainview_proj, current_secondaryiew_view, current_secondaryview_proj);
 
-								d3dimpl->drawIndexedInstancedTriangles(tdc.worlds.size());
+									d3dimpl->drawIndexedInstancedTriangles(tdc.worlds.size());
+								}
+								else
+								{
+									// instance data not uploaded : don't draw with stale transformations
+									_MAGE_WARN(d3dimpl->logger(), "instances transformations update failed, triangles draw skipped for " + tdc.owner_entity_id);
+								}
 							}
 						}
 					}
@@ -563,7 +563,7 @@ void D3D11System::renderQueue(const rendering::Queue& p_renderingQueue) const
 
 					for (const auto& lineMesheInfo : renderStatesInfo.second.lines_dc_list)
 					{						
-						const mage::rendering::QueueLinesDrawingControl ldc{ lineMesheInfo.second };
+						const mage::rendering::QueueLinesDrawingControl& ldc{ lineMesheInfo.second };
 
 						if (*(ldc.draw))
 						{
@@ -573,33 +573,51 @@ void D3D11System::renderQueue(const rendering::Queue& p_renderingQueue) const
 
 							for (const auto& e : ldc.vshaders_map_cnx)
 							{
-								const auto& datacloud_data_id{ e.first };
-								const auto& shader_param{ e.second };
+								const auto& shader_param{ e.argument };
 
 								if ("Real4Vector" == shader_param.argument_type)
 								{
-									const maths::Real4Vector rvector{ { dataCloud->readDataValue<maths::Real4Vector>(datacloud_data_id) } };
-									d3dimpl->setVertexshaderConstantsVec(shader_param.shader_register, rvector);
+									if (e.real4vector.isValid())
+									{
+										d3dimpl->setVertexshaderConstantsVec(shader_param.shader_register, e.real4vector.read());
+									}
+									else
+									{
+										const maths::Real4Vector rvector{ { dataCloud->readDataValue<maths::Real4Vector>(e.datacloud_id) } };
+										d3dimpl->setVertexshaderConstantsVec(shader_param.shader_register, rvector);
+									}
 								}
 							}
 
 							for (const auto& e : ldc.pshaders_map_cnx)
 							{
-								const auto& datacloud_data_id{ e.first };
-								const auto& shader_param{ e.second };
+								const auto& shader_param{ e.argument };
 
 								if ("Real4Vector" == shader_param.argument_type)
 								{
-									const maths::Real4Vector rvector{ { dataCloud->readDataValue<maths::Real4Vector>(datacloud_data_id) } };
-									d3dimpl->setPixelshaderConstantsVec(shader_param.shader_register, rvector);
+									if (e.real4vector.isValid())
+									{
+										d3dimpl->setPixelshaderConstantsVec(shader_param.shader_register, e.real4vector.read());
+									}
+									else
+									{
+										const maths::Real4Vector rvector{ { dataCloud->readDataValue<maths::Real4Vector>(e.datacloud_id) } };
+										d3dimpl->setPixelshaderConstantsVec(shader_param.shader_register, rvector);
+									}
 								}
 							}
 
 							/////////////////////////
 
-							d3dimpl->updateMesheTransformersForPrimitive<D3D11SystemImpl::Primitives::LINES>(ldc.meshe_id, ldc.worlds, current_mainview_view, current_mainview_proj, current_secondaryiew_view, current_secondaryview_proj);
-							d3dimpl->bindShadersConstantBuffers(current_mainview_view, current_mainview_proj, current_secondaryiew_view, current_secondaryview_proj);
-							d3dimpl->drawIndexedInstancedLines(ldc.worlds.size());
+							if (d3dimpl->updateInstancesTransformers(ldc.worlds, current_mainview_view, current_mainview_proj, current_secondaryiew_view, current_secondaryview_proj))
+							{
+								d3dimpl->bindShadersConstantBuffers(current_mainview_view, current_mainview_proj, current_secondaryiew_view, current_secondaryview_proj);
+								d3dimpl->drawIndexedInstancedLines(ldc.worlds.size());
+							}
+							else
+							{
+								_MAGE_WARN(d3dimpl->logger(), "instances transformations update failed, lines draw skipped for " + ldc.owner_entity_id);
+							}
 						}
 					}
 
@@ -635,7 +653,7 @@ void D3D11System::renderQueue(const rendering::Queue& p_renderingQueue) const
 
 void D3D11System::run()
 {
-	const auto start_time{ std::chrono::high_resolution_clock::now() };
+	_MAGE_PROFILE_ZONE("d3d11system");
 
 	if (!m_initialized)
 	{
@@ -755,11 +773,26 @@ void D3D11System::run()
 		manageInitialization();
 	}
 
+	// instances transformations shared by all queues during this frame
+	d3dimpl->beginFrameInstances();
+
 	for (rendering::Queue* rendering_queue : m_queues)
 	{
+		if (rendering_queue->isCulled())
+		{
+			// output not consumed (see RenderingQueueSystem::compileRendergraph())
+			rendering_queue->m_texts.clear();
+			continue;
+		}
 		renderQueue(*rendering_queue);
 		rendering_queue->m_texts.clear();
 	}
+
+	const auto dataCloud{ mage::rendering::Datacloud::getInstance() };
+	dataCloud->updateDataValue(m_shaderargs_uploaded_bytes, static_cast<long>(d3dimpl->getShaderArgsUploadedBytes()));
+	d3dimpl->resetShaderArgsUploadedBytes();
+	dataCloud->updateDataValue(m_instances_uploaded_bytes, static_cast<long>(d3dimpl->getInstancesUploadedBytes()));
+	d3dimpl->resetInstancesUploadedBytes();
 		
 
 	if (m_initialized)
@@ -768,11 +801,11 @@ void D3D11System::run()
 	}
 
 	m_runner.dispatchEvents();
+}
 
-	const auto end_time{ std::chrono::high_resolution_clock::now() };
-	const auto duration{ std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time) };
-	const auto dataCloud{ mage::rendering::Datacloud::getInstance() };
-	dataCloud->updateDataValue<std::string>("mage.timings.d3d11system", std::to_string(duration.count()) + " ms");
+bool D3D11System::hasPendingWork()
+{
+	return m_runner.hasPendingTasks();
 }
 
 void D3D11System::killRunner()
@@ -30,6 +30,7 @@
 #include "textures_service.h"
 #include "runner.h"
 #include "eventsource.h"
+#include "datacloud.h"
 
 
 
@@ -76,6 +77,9 @@ namespace mage
         void run();
         void killRunner();
 
+        // gpu resources creation still running or waiting in runner
+        bool hasPendingWork();
+
         auto getShaderCompilationInvocationCallback() const
         {
             return m_shadercompilation_invocation_cb;
@@ -97,6 +101,9 @@ namespace mage
 
         std::vector<rendering::Queue*>                          m_queues; // /!\ /!\ /!\ queue MUST BE ordered here in correct rendering order : from leaf to root of rendergraph part of entity graph
 
+        rendering::Datacloud::DataHandle<long>                  m_shaderargs_uploaded_bytes; // shader constants bytes sent to GPU during last frame
+        rendering::Datacloud::DataHandle<long>                  m_instances_uploaded_bytes; // instances transformations bytes sent to GPU during last frame
+
         void    manageInitialization();       
 
         void    handleShaderCreation(Shader& p_shaderInfos, int p_shaderType);
@@ -59,6 +59,7 @@
 #include "trianglemeshe.h"
 #include "texture.h"
 #include "renderstate.h"
+#include "renderstateblock.h"
 
 #include "tvector.h"
 #include "matrix.h"
@@ -192,18 +193,13 @@ public:
     void destroyTexture(const std::string& p_resource_uid);
 
    
-    void prepareRenderState(const mage::rendering::RenderState& p_renderstate); // update struct
-    bool setCacheRS(bool p_force = false); // apply
+    void applyRenderStateBlock(const mage::rendering::RenderStateBlock& p_block); // no-op if same block as previous call
 
-    void prepareBlendState(const mage::rendering::RenderState& p_renderstate); // update struct    
+    bool setCacheRS(bool p_force = false); // apply
     bool setCacheBlendstate(bool p_force = false); // apply
 
-    void setDepthStenciState(const mage::rendering::RenderState& p_renderstate);
     void forceCurrentDepthStenciState();    
 
-    void setPSSamplers(const mage::rendering::RenderState& p_renderstate);
-    void setVSSamplers(const mage::rendering::RenderState& p_renderstate);
-
     void forceCurrentPSSamplers();
     void forceCurrentVSSamplers();
 
@@ -218,6 +214,11 @@ public:
     void setPixelshaderConstantsVec(int p_startreg, const mage::core::maths::Real4Vector& p_vec);
     void setVertexshaderConstantsMat(int p_startreg, const mage::core::maths::Matrix& p_mat);
     void setPixelshaderConstantsMat(int p_startreg, const mage::core::maths::Matrix& p_mat);
+    void setVertexshaderConstantsVecArray(int p_startreg, const std::vector<mage::core::maths::Float4Vector>& p_array);
+    void setPixelshaderConstantsVecArray(int p_startreg, const std::vector<mage::core::maths::Float4Vector>& p_array);
+
+    size_t getShaderArgsUploadedBytes() const;
+    void resetShaderArgsUploadedBytes();
 
     DirectX::XMFLOAT4X4 convertMatrixToXMFloat44(const mage::core::maths::Matrix& p_mat);
 
@@ -257,7 +258,7 @@ public:
 
 private:
 
-    static constexpr int nbMaxTransformersInstances{ 1500 };
+    static constexpr int nbFrameInstancesInit{ 4096 }; // initial capacity of frame instances buffer, grows if needed
 
     struct FontRenderingData
     {
@@ -279,12 +280,29 @@ private:
         ID3D11BlendState*           bs_state { nullptr };
     };
 
+    struct SamplersState
+    {
+        bool                                        extended { false };
+        mage::rendering::RenderStateBlock::Sampler  global   { mage::rendering::RenderStateBlock::Sampler::NONE };
+        mage::rendering::RenderStateBlock::Sampler  stages[nbTextureStages]{};
+        int                                         nbStages { 0 };
+    };
+
     struct ShaderArg
     {
         DirectX::XMFLOAT4           vector[512];
         DirectX::XMFLOAT4X4         matrix[512];
     };
 
+    // shader constants modified since last GPU upload
+    struct ShaderArgUpload
+    {
+        size_t                      dirty_begin     { sizeof(ShaderArg) };
+        size_t                      dirty_end       { 0 };
+        size_t                      upload_size     { 0 }; // highest byte ever written in ShaderArg
+        size_t                      uploaded_size   { 0 }; // upload_size at last upload
+    };
+
     struct VertexShadersData
     {
         ID3D11VertexShader*         vertex_shader   { nullptr };
@@ -301,20 +319,29 @@ private:
         ID3D11Buffer* vertex_buffer             { nullptr };
         ID3D11Buffer* index_buffer              { nullptr };
 
-        ID3D11Buffer* transforms_buffer         { nullptr };
-        size_t        transforms_buffer_size    { 0 };
-        
         size_t        nb_vertices               { 0 };
         size_t        nb_primitives             { 0 };
     };
 
-    using RSCache =                 std::unordered_map<std::string, RSCacheEntry>;
-    using BSCache =                 std::unordered_map<std::string, BSCacheEntry>;
+    // key = hash of D3D11 desc
+    using RSCache =                 std::unordered_map<uint64_t, RSCacheEntry>;
+    using BSCache =                 std::unordered_map<uint64_t, BSCacheEntry>;
 
     using VShaderList =             std::unordered_map<std::string, VertexShadersData>;
     using PShaderList =             std::unordered_map<std::string, PixelShadersData>;
 
     using MesheList =               std::unordered_map<std::string, MesheData>;
+
+    // frame instances buffer range already filled for a worlds list seen from a views set
+    struct InstancesRange
+    {
+        std::vector<const mage::core::maths::Matrix*>   worlds;
+        mage::core::maths::Matrix                       views[4];
+        size_t                                          start{ 0 };
+    };
+
+    // key = hash of worlds pointers and views
+    using InstancesRanges =         std::unordered_multimap<uint64_t, InstancesRange>;
     using TextureList =             std::unordered_map<std::string, TextureData>;
 
 
@@ -361,6 +388,24 @@ private:
     ShaderArg                                           m_vertexshader_args;
     ShaderArg                                           m_pixelshader_args;
 
+    ShaderArgUpload                                     m_vertexshader_args_upload;
+    ShaderArgUpload                                     m_pixelshader_args_upload;
+
+    size_t                                              m_shaderArgsUploadedBytes{ 0 };
+
+    // instances transformations of whole frame, shared by all queues/passes : see updateInstancesTransformers()
+    ID3D11Buffer*                                       m_frameInstancesBuffer{ nullptr };
+    size_t                                              m_frameInstancesCapacity{ 0 };
+    size_t                                              m_frameInstancesCount{ 0 };     // instances written since beginFrameInstances()
+    size_t                                              m_currentInstancesStart{ 0 };   // first instance for next draw
+    InstancesRanges                                     m_frameInstancesRanges;
+    std::vector<d3d11transformers>                      m_frameInstancesStaging;
+    size_t                                              m_instancesUploadedBytes{ 0 };
+
+    // last views matrices received by bindShadersConstantBuffers()
+    mage::core::maths::Matrix                           m_shaderArgsViews[4];
+    bool                                                m_shaderArgsViewsSet{ false };
+
 
     D3D11_VIEWPORT                                      m_mainScreenViewport;
 
@@ -378,21 +423,15 @@ private:
 
     ////////////////////////////////////////////////////////
 
-    std::string                                         m_currentRenderStateMD5;
-    std::string                                         m_currentBlendStateMD5;
-    std::string                                         m_currentDepthStencilState;
-
-    std::string                                         m_currentPSSampler;
+    mage::rendering::RenderStateBlock::Hash             m_currentRenderStateBlock{ 0 };
+    bool                                                m_renderStateBlockBound{ false };
 
-    bool                                                m_PSExtendedSamplers;
-    std::string                                         m_currentPSExtendedSamplers[nbTextureStages];
-    int                                                 m_currentPSExtendedSamplersLength;
+    uint64_t                                            m_currentRenderStateHash{ 0 };
+    uint64_t                                            m_currentBlendStateHash{ 0 };
+    mage::rendering::RenderStateBlock::Toggle           m_currentDepthStencilState{ mage::rendering::RenderStateBlock::Toggle::UNSET };
 
-    std::string                                         m_currentVSSampler;
-
-    bool                                                m_VSExtendedSamplers;
-    std::string                                         m_currentVSExtendedSamplers[nbTextureStages];
-    int                                                 m_currentVSExtendedSamplersLength;
+    SamplersState                                       m_currentPSSamplers;
+    SamplersState                                       m_currentVSSamplers;
 
     // current texture name for each stage
     std::string                                         m_currentTextures[nbTextureStages];
@@ -415,6 +454,20 @@ private:
     bool createDepthStencilBuffer(ID3D11Device* p_lpd3ddevice, int p_width, int p_height, DXGI_FORMAT p_format, ID3D11Texture2D** p_texture2D, ID3D11DepthStencilView** p_view);
 
     bool createTransformersInstancesBuffer(int p_size, ID3D11Buffer** p_outbuffer);
+    bool growFrameInstancesBuffer(size_t p_instances_count);
+
+    void prepareRenderState(const mage::rendering::RenderStateBlock& p_block); // update struct
+    void prepareBlendState(const mage::rendering::RenderStateBlock& p_block); // update struct
+
+    void setDepthStenciState(mage::rendering::RenderStateBlock::Toggle p_zbuffer);
+
+    ID3D11SamplerState* getSamplerState(mage::rendering::RenderStateBlock::Sampler p_sampler) const;
+    void bindSampler(bool p_vertexStage, int p_stage, mage::rendering::RenderStateBlock::Sampler p_sampler);
+    void setSamplers(const mage::rendering::RenderStateBlock::Samplers& p_samplers, SamplersState& p_current, bool p_vertexStage);
+    void forceSamplers(const SamplersState& p_current, bool p_vertexStage);
+
+    void writeShaderArgs(ShaderArg& p_args, ShaderArgUpload& p_upload, size_t p_offset, const void* p_data, size_t p_size);
+    void uploadShaderArgs(ID3D11Buffer* p_buffer, const ShaderArg& p_args, ShaderArgUpload& p_upload);
 
     HRESULT compileShaderFromMem(void* p_data, int p_size, LPCTSTR szFileName, LPCSTR szEntryPoint, LPCSTR szShaderModel, ID3D10Include* p_include, ID3DBlob** ppBlobOut, ID3DBlob** ppBlobErrOut);
 
@@ -426,40 +479,14 @@ private:
 
 public:
 
-    enum class Primitives
-    {
-        LINES,
-        TRIANGLES
-    };
+    // start a new frame : previous instances ranges are discarded
+    void beginFrameInstances();
 
-    bool updateMesheTransformers(MesheData& p_meshe_data, 
-        const std::vector<const mage::core::maths::Matrix*>& p_worlds,
+    // fill frame instances buffer for these worlds and views, unless already done during this frame by another queue/pass
+    bool updateInstancesTransformers(const std::vector<const mage::core::maths::Matrix*>& p_worlds,
         const mage::core::maths::Matrix& p_view, const mage::core::maths::Matrix& p_proj,
         const mage::core::maths::Matrix& p_view2, const mage::core::maths::Matrix& p_proj2);
 
-
-    template<Primitives p>
-    bool updateMesheTransformersForPrimitive(const std::string& p_meshe_id,
-        const std::vector<const mage::core::maths::Matrix*>& p_worlds,
-        const mage::core::maths::Matrix& p_view, const mage::core::maths::Matrix& p_proj,
-        const mage::core::maths::Matrix& p_view2, const mage::core::maths::Matrix& p_proj2)
-    {
-        // ICI
-        MesheList* ml;
-
-        if constexpr (Primitives::LINES == p)
-        {
-            ml = &m_lines;
-        }
-        else // TRIANGLES
-        {
-            ml = &m_triangles;
-        }
-
-        if (!ml->count(p_meshe_id))
-        {
-            _EXCEPTION("unknown meshes :" + p_meshe_id)
-        }
-        return updateMesheTransformers(ml->at(p_meshe_id), p_worlds, p_view, p_proj, p_view2, p_proj2);
-    }
+    size_t getInstancesUploadedBytes() const;
+    void resetInstancesUploadedBytes();
 };
\ No newline at end of file
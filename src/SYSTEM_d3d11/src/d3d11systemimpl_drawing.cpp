@@ -30,71 +30,84 @@ using namespace mage::core::maths;
 using namespace mage::transform;
 
 
+static bool same_matrix(const Matrix& p_a, const Matrix& p_b)
+{
+    return 0 == memcmp(p_a.getArray(), p_b.getArray(), 16 * sizeof(double));
+}
+
 void D3D11SystemImpl::bindShadersConstantBuffers(const mage::core::maths::Matrix& p_view,
                                                     const mage::core::maths::Matrix& p_proj,
                                                     const mage::core::maths::Matrix& p_secondary_view,
                                                     const mage::core::maths::Matrix& p_secondary_proj)
 {
-    auto view{ p_view };
-    view.transpose();
+    const bool viewsChanged{ !m_shaderArgsViewsSet ||
+                                !same_matrix(p_view, m_shaderArgsViews[0]) ||
+                                !same_matrix(p_proj, m_shaderArgsViews[1]) ||
+                                !same_matrix(p_secondary_view, m_shaderArgsViews[2]) ||
+                                !same_matrix(p_secondary_proj, m_shaderArgsViews[3]) };
 
-    setVertexshaderConstantsMat(12, view);
-    setPixelshaderConstantsMat(12, view);
+    if (viewsChanged)
+    {
+        m_shaderArgsViews[0] = p_view;
+        m_shaderArgsViews[1] = p_proj;
+        m_shaderArgsViews[2] = p_secondary_view;
+        m_shaderArgsViews[3] = p_secondary_proj;
+        m_shaderArgsViewsSet = true;
 
-    //////////////////////////////////////////////////////////////////////
+        auto view{ p_view };
+        view.transpose();
 
-    auto cam{ p_view };
-    cam.inverse();
-    cam.transpose();
+        setVertexshaderConstantsMat(12, view);
+        setPixelshaderConstantsMat(12, view);
 
-    setVertexshaderConstantsMat(16, cam);
-    setPixelshaderConstantsMat(16, cam);
+        //////////////////////////////////////////////////////////////////////
 
-    auto proj{ p_proj };
+        auto cam{ p_view };
+        cam.inverse();
+        cam.transpose();
 
-    proj.transpose();
-    setVertexshaderConstantsMat(20, proj);
-    setPixelshaderConstantsMat(20, proj);
+        setVertexshaderConstantsMat(16, cam);
+        setPixelshaderConstantsMat(16, cam);
 
-    //////////////////////////////////////////////////////////////////////
-    // for secondary view
-    //////////////////////////////////////////////////////////////////////
+        auto proj{ p_proj };
 
+        proj.transpose();
+        setVertexshaderConstantsMat(20, proj);
+        setPixelshaderConstantsMat(20, proj);
 
-    auto secondary_view{ p_secondary_view };
-    secondary_view.transpose();
+        //////////////////////////////////////////////////////////////////////
+        // for secondary view
+        //////////////////////////////////////////////////////////////////////
 
-    setPixelshaderConstantsMat(32, secondary_view);
-    setVertexshaderConstantsMat(32, secondary_view);
 
+        auto secondary_view{ p_secondary_view };
+        secondary_view.transpose();
 
-    auto secondary_cam{ p_secondary_view };
-    secondary_cam.inverse();
+        setPixelshaderConstantsMat(32, secondary_view);
+        setVertexshaderConstantsMat(32, secondary_view);
 
-    secondary_cam.transpose();
 
-    setPixelshaderConstantsMat(36, secondary_cam);
-    setVertexshaderConstantsMat(36, secondary_cam);
+        auto secondary_cam{ p_secondary_view };
+        secondary_cam.inverse();
 
-    auto secondary_proj{ p_secondary_proj };
+        secondary_cam.transpose();
 
-    secondary_proj.transpose();
+        setPixelshaderConstantsMat(36, secondary_cam);
+        setVertexshaderConstantsMat(36, secondary_cam);
 
-    setPixelshaderConstantsMat(40, secondary_proj);
-    setVertexshaderConstantsMat(40, secondary_proj);
+        auto secondary_proj{ p_secondary_proj };
 
-    ///////////////////////////////////////////////////////////////////////
-    // update des shaders constants buffers...
+        secondary_proj.transpose();
 
-    D3D11_MAPPED_SUBRESOURCE mapped = {};
+        setPixelshaderConstantsMat(40, secondary_proj);
+        setVertexshaderConstantsMat(40, secondary_proj);
+    }
 
-    auto hRes = m_lpd3ddevcontext->Map(m_vertexShaderArgsBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
-    memcpy(mapped.pData, &m_vertexshader_args, sizeof(m_vertexshader_args));
-    m_lpd3ddevcontext->Unmap(m_vertexShaderArgsBuffer, 0);
+    ///////////////////////////////////////////////////////////////////////
+    // update des shaders constants buffers, only if something changed since last draw
 
-    hRes = m_lpd3ddevcontext->Map(m_pixelShaderArgsBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
-    memcpy(mapped.pData, &m_pixelshader_args, sizeof(m_pixelshader_args));
-    m_lpd3ddevcontext->Unmap(m_pixelShaderArgsBuffer, 0);
+    uploadShaderArgs(m_vertexShaderArgsBuffer, m_vertexshader_args, m_vertexshader_args_upload);
+    uploadShaderArgs(m_pixelShaderArgsBuffer, m_pixelshader_args, m_pixelshader_args_upload);
 
     ///////////////
 
@@ -104,12 +117,12 @@ void D3D11SystemImpl::bindShadersConstantBuffers(const mage::core::maths::Matrix
 
 void D3D11SystemImpl::drawIndexedInstancedLines(int p_instances_count)
 {
-    m_lpd3ddevcontext->DrawIndexedInstanced(m_next_nblines * 2, p_instances_count, 0, 0, 0);
+    m_lpd3ddevcontext->DrawIndexedInstanced(m_next_nblines * 2, p_instances_count, 0, 0, static_cast<UINT>(m_currentInstancesStart));
 }
 
 void D3D11SystemImpl::drawIndexedInstancedTriangles(int p_instances_count)
 {
-    m_lpd3ddevcontext->DrawIndexedInstanced(m_next_nbtriangles * 3, p_instances_count, 0, 0, 0);
+    m_lpd3ddevcontext->DrawIndexedInstanced(m_next_nbtriangles * 3, p_instances_count, 0, 0, static_cast<UINT>(m_currentInstancesStart));
 }
 
 void D3D11SystemImpl::beginScreen()
@@ -35,7 +35,7 @@ bool D3D11SystemImpl::init(mage::core::Entity* p_mainWindow)
 {
 	DECLARE_D3D11ASSERT_VARS
 
-	_MAGE_DEBUG(m_localLogger, std::string("init D3D startup"))
+	_MAGE_DEBUG(m_localLogger, std::string("init D3D startup"));
 
 	DXGI_SWAP_CHAIN_DESC swap_chain;
 	ZeroMemory(&swap_chain, sizeof(swap_chain));
@@ -70,7 +70,7 @@ bool D3D11SystemImpl::init(mage::core::Entity* p_mainWindow)
 		characteristics_v_width = 1.0;
 		characteristics_v_height = characteristics_v_width * fullscreen_height / fullscreen_width;
 
-		_MAGE_TRACE(m_localLogger, std::string("full screen resol : ") + std::to_string(fullscreen_width) + "x" + std::to_string(fullscreen_height))
+		_MAGE_TRACE(m_localLogger, std::string("full screen resol : ") + std::to_string(fullscreen_width) + "x" + std::to_string(fullscreen_height));
 
 		swap_chain.BufferDesc.Format = fullscreen_format;
 		swap_chain.BufferDesc.RefreshRate.Numerator = fullscreen_refresh_rate_num;
@@ -103,7 +103,7 @@ bool D3D11SystemImpl::init(mage::core::Entity* p_mainWindow)
 	_MAGE_TRACE(m_localLogger, std::string("renderer characteristics : width_resol = ") + std::to_string(characteristics_width_resol) +
 		std::string(" height_resol = ") + std::to_string(characteristics_height_resol) +
 		std::string(" v_width = ") + std::to_string(characteristics_v_width) +
-		std::string(" v_height = ") + std::to_string(characteristics_v_height))
+		std::string(" v_height = ") + std::to_string(characteristics_v_height));
 
 
 	// complete main window entity with renderer characteristics
@@ -170,12 +170,12 @@ bool D3D11SystemImpl::init(mage::core::Entity* p_mainWindow)
 		{
 			driver_descr = e.second;
 
-			_MAGE_TRACE(m_localLogger, "D3D11CreateDeviceAndSwapChain is OK for " + driver_descr)
+			_MAGE_TRACE(m_localLogger, "D3D11CreateDeviceAndSwapChain is OK for " + driver_descr);
 			break;
 		}
 		else
 		{
-			_MAGE_WARN(m_localLogger, "D3D11CreateDeviceAndSwapChain is KO for " + driver_descr + ", switching to next")
+			_MAGE_WARN(m_localLogger, "D3D11CreateDeviceAndSwapChain is KO for " + driver_descr + ", switching to next");
 		}
 	}
 
@@ -397,10 +397,8 @@ bool D3D11SystemImpl::init(mage::core::Entity* p_mainWindow)
 		lpd3ddevcontext->VSSetSamplers(i, 1, ss_array);
 		lpd3ddevcontext->PSSetSamplers(i, 1, ss_array);
 	}
-	m_PSExtendedSamplers = false;
-	m_VSExtendedSamplers = false;
-	m_currentPSSampler = "none";
-	m_currentVSSampler = "none";
+	m_currentPSSamplers = SamplersState();
+	m_currentVSSamplers = SamplersState();
 
 	////////////////////////////////////////////////////////////////////////////
 
@@ -517,7 +515,7 @@ bool D3D11SystemImpl::init(mage::core::Entity* p_mainWindow)
 	D3D11_CHECK(CoInitializeEx);
 	
 
-	_MAGE_DEBUG(m_localLogger, std::string("init D3D SUCCESS"))
+	_MAGE_DEBUG(m_localLogger, std::string("init D3D SUCCESS"));
 
 	m_initialized = true;
 	return true;
@@ -23,6 +23,7 @@
 /* -*-LIC_END-*- */
 
 #include <vector>
+#include <algorithm>
 #include <omp.h>
 
 #include "d3d11systemimpl.h"
@@ -33,6 +34,17 @@
 
 #include "matrixchain.h"
 
+static constexpr uint64_t fnvOffsetBasis{ 14695981039346656037ULL };
+static constexpr uint64_t fnvPrime{ 1099511628211ULL };
+
+static void hash_bytes(uint64_t& p_hash, const char* p_bytes, size_t p_length)
+{
+    for (size_t i = 0; i < p_length; i++)
+    {
+        p_hash ^= static_cast<uint8_t>(p_bytes[i]);
+        p_hash *= fnvPrime;
+    }
+}
 
 bool D3D11SystemImpl::createLineMeshe(const mage::LineMeshe& p_lm)
 {
@@ -55,7 +67,6 @@ bool D3D11SystemImpl::createLineMeshe(const mage::LineMeshe& p_lm)
 
         ID3D11Buffer* vertex_buffer{ nullptr };
         ID3D11Buffer* index_buffer{ nullptr };
-        ID3D11Buffer* transformer_buffer{ nullptr };
 
         {
             // vertex buffer creation
@@ -132,13 +143,7 @@ bool D3D11SystemImpl::createLineMeshe(const mage::LineMeshe& p_lm)
             delete[] t;
         }
 
-        // TRANSFORMERS buffer creationZ
-        if (!createTransformersInstancesBuffer(nbMaxTransformersInstances, &transformer_buffer))
-        {
-            return false;
-        }
-
-        m_lines[resource_uid] = { vertex_buffer, index_buffer, transformer_buffer, nbMaxTransformersInstances, nb_vertices, nb_lines };
+        m_lines[resource_uid] = { vertex_buffer, index_buffer, nb_vertices, nb_lines };
     }
 
     _MAGE_DEBUG(m_localLogger, "Line meshe loading SUCCESS : " + resource_uid);
@@ -158,7 +163,7 @@ void D3D11SystemImpl::setLineMeshe(const std::string& p_md5)
 
         UINT strides[2] = { sizeof(d3d11vertex), sizeof(d3d11transformers) };
         UINT offsets[2] = { 0, 0 };
-        ID3D11Buffer* buffers[2] = { lmData.vertex_buffer, lmData.transforms_buffer };
+        ID3D11Buffer* buffers[2] = { lmData.vertex_buffer, m_frameInstancesBuffer };
         m_lpd3ddevcontext->IASetVertexBuffers(0, 2, buffers, strides, offsets);
 
         m_lpd3ddevcontext->IASetIndexBuffer(lmData.index_buffer, DXGI_FORMAT_R32_UINT, 0);
@@ -207,7 +212,6 @@ bool D3D11SystemImpl::createTriangleMeshe(const mage::TriangleMeshe& p_tm)
 
         ID3D11Buffer* vertex_buffer{ nullptr };
         ID3D11Buffer* index_buffer{ nullptr };
-        ID3D11Buffer* transformer_buffer{ nullptr };
 
         {
             // vertex buffer creation
@@ -297,13 +301,7 @@ bool D3D11SystemImpl::createTriangleMeshe(const mage::TriangleMeshe& p_tm)
             delete[] t;
         }
 
-        // TRANSFORMERS buffer creation
-        if (!createTransformersInstancesBuffer(nbMaxTransformersInstances, &transformer_buffer))
-        {
-            return false;
-        }
-
-        m_triangles[resource_uid] = { vertex_buffer, index_buffer, transformer_buffer, nbMaxTransformersInstances, nb_vertices, nb_triangles };
+        m_triangles[resource_uid] = { vertex_buffer, index_buffer, nb_vertices, nb_triangles };
     }
 
     _MAGE_DEBUG(m_localLogger, "Triangle meshe loading SUCCESS : " + resource_uid);
@@ -324,7 +322,7 @@ void D3D11SystemImpl::setTriangleMeshe(const std::string& p_resource_uid)
 
         UINT strides[2] = { sizeof(d3d11vertex), sizeof(d3d11transformers) };
         UINT offsets[2] = { 0, 0 };
-        ID3D11Buffer* buffers[2] = { tmData.vertex_buffer, tmData.transforms_buffer };
+        ID3D11Buffer* buffers[2] = { tmData.vertex_buffer, m_frameInstancesBuffer };
         m_lpd3ddevcontext->IASetVertexBuffers(0, 2, buffers, strides, offsets);
 
 
@@ -363,7 +361,7 @@ void D3D11SystemImpl::forceCurrentMeshe()
 
         UINT strides[2] = { sizeof(d3d11vertex), sizeof(d3d11transformers) };
         UINT offsets[2] = { 0, 0 };
-        ID3D11Buffer* buffers[2] = { tmData.vertex_buffer, tmData.transforms_buffer };
+        ID3D11Buffer* buffers[2] = { tmData.vertex_buffer, m_frameInstancesBuffer };
         m_lpd3ddevcontext->IASetVertexBuffers(0, 2, buffers, strides, offsets);
 
         m_lpd3ddevcontext->IASetIndexBuffer(tmData.index_buffer, DXGI_FORMAT_R32_UINT, 0);
@@ -377,7 +375,7 @@ void D3D11SystemImpl::forceCurrentMeshe()
 
         UINT strides[2] = { sizeof(d3d11vertex), sizeof(d3d11transformers) };
         UINT offsets[2] = { 0, 0 };
-        ID3D11Buffer* buffers[2] = { lmData.vertex_buffer, lmData.transforms_buffer };
+        ID3D11Buffer* buffers[2] = { lmData.vertex_buffer, m_frameInstancesBuffer };
         m_lpd3ddevcontext->IASetVertexBuffers(0, 2, buffers, strides, offsets);
 
         m_lpd3ddevcontext->IASetIndexBuffer(lmData.index_buffer, DXGI_FORMAT_R32_UINT, 0);
@@ -387,84 +385,157 @@ void D3D11SystemImpl::forceCurrentMeshe()
     }
 }
 
-bool D3D11SystemImpl::updateMesheTransformers(MesheData& p_meshe_data, const std::vector<const mage::core::maths::Matrix*>& p_worlds,
+void D3D11SystemImpl::beginFrameInstances()
+{
+    m_frameInstancesCount = 0;
+    m_currentInstancesStart = 0;
+    m_frameInstancesRanges.clear();
+}
+
+bool D3D11SystemImpl::growFrameInstancesBuffer(size_t p_instances_count)
+{
+    size_t capacity{ std::max<size_t>(m_frameInstancesCapacity, nbFrameInstancesInit) };
+    while (capacity < p_instances_count)
+    {
+        capacity *= 2;
+    }
+
+    ID3D11Buffer* buffer{ nullptr };
+    if (!createTransformersInstancesBuffer(static_cast<int>(capacity), &buffer))
+    {
+        return false;
+    }
+
+    if (m_frameInstancesBuffer != nullptr)
+    {
+        // draws already submitted keep their reference on previous buffer
+        m_frameInstancesBuffer->Release();
+    }
+
+    m_frameInstancesBuffer = buffer;
+    m_frameInstancesCapacity = capacity;
+
+    // ranges of previous buffer are lost
+    beginFrameInstances();
+
+    const UINT stride{ sizeof(d3d11transformers) };
+    const UINT offset{ 0 };
+    m_lpd3ddevcontext->IASetVertexBuffers(1, 1, &m_frameInstancesBuffer, &stride, &offset);
+
+    return true;
+}
+
+bool D3D11SystemImpl::updateInstancesTransformers(const std::vector<const mage::core::maths::Matrix*>& p_worlds,
     const mage::core::maths::Matrix& p_view, const mage::core::maths::Matrix& p_proj,
     const mage::core::maths::Matrix& p_view2, const mage::core::maths::Matrix& p_proj2)
 {
-
     DECLARE_D3D11ASSERT_VARS
 
-    mage::core::maths::Matrix inv;
-    inv.identity();
-    inv(2, 2) = -1.0;
-    const auto final_view{ p_view * inv };
-    const auto final_view2{ p_view2 * inv };
+    const mage::core::maths::Matrix* views[4]{ &p_view, &p_proj, &p_view2, &p_proj2 };
 
-    std::vector<d3d11transformers> instances(p_worlds.size());
+    // same worlds seen from same views in an other queue/pass during this frame : reuse its range
 
-    //////////////////////////////////////
-    // "Dynamic Growable Buffer" BEGIN
-    //////////////////////////////////////
+    uint64_t key{ fnvOffsetBasis };
+    hash_bytes(key, reinterpret_cast<const char*>(p_worlds.data()), p_worlds.size() * sizeof(const mage::core::maths::Matrix*));
+    for (const auto view : views)
+    {
+        hash_bytes(key, reinterpret_cast<const char*>(view->getArray()), 16 * sizeof(double));
+    }
 
-    if (instances.size() > p_meshe_data.transforms_buffer_size)
+    const auto candidates{ m_frameInstancesRanges.equal_range(key) };
+    for (auto it = candidates.first; it != candidates.second; ++it)
     {
+        const InstancesRange& range{ it->second };
 
-        if (p_meshe_data.transforms_buffer != nullptr)
+        bool same{ range.worlds == p_worlds };
+        for (int i = 0; same && i < 4; i++)
         {
-            p_meshe_data.transforms_buffer->Release();
+            same = (0 == memcmp(range.views[i].getArray(), views[i]->getArray(), 16 * sizeof(double)));
         }
 
-        // realloc with twice size...
+        if (same)
+        {
+            m_currentInstancesStart = range.start;
+            return true;
+        }
+    }
 
-        // TRANSFORMERS buffer creation
-        p_meshe_data.transforms_buffer_size *= 2;
-        if (!createTransformersInstancesBuffer(p_meshe_data.transforms_buffer_size, &p_meshe_data.transforms_buffer))
+    if (m_frameInstancesCount + p_worlds.size() > m_frameInstancesCapacity)
+    {
+        if (!growFrameInstancesBuffer(m_frameInstancesCount + p_worlds.size()))
         {
-            p_meshe_data.transforms_buffer_size = 0;
             return false;
-        }        
+        }
     }
 
-    //////////////////////////////////////
-    // "Dynamic Growable Buffer" END
-    //////////////////////////////////////
+    mage::core::maths::Matrix inv;
+    inv.identity();
+    inv(2, 2) = -1.0;
+    const auto final_view{ p_view * inv };
+    const auto final_view2{ p_view2 * inv };
 
+    // view/proj products computed once per view, then applied to each world
+    mage::transform::MatrixChain view_chain;
+    view_chain.pushMatrix(p_proj);
+    view_chain.pushMatrix(final_view);
+    view_chain.buildResult();
+    const auto view_proj{ view_chain.getResultTransform() };
 
-    // looks like fps is degraded with omp ! :(
-    //#pragma omp parallel for default(shared) schedule(static)
-    for (int i = 0; i < static_cast<int>(p_worlds.size()); ++i)
+    mage::transform::MatrixChain view_chain2;
+    view_chain2.pushMatrix(p_proj2);
+    view_chain2.pushMatrix(final_view2);
+    view_chain2.buildResult();
+    const auto view_proj2{ view_chain2.getResultTransform() };
+
+    m_frameInstancesStaging.resize(p_worlds.size());
+
+    for (size_t i = 0; i < p_worlds.size(); ++i)
     {
-        mage::transform::MatrixChain chain;
+        const mage::core::maths::Matrix& world{ *p_worlds[i] };
+
+        d3d11transformers& tr{ m_frameInstancesStaging[i] };
+        tr.wordlViewProj = convertMatrixToXMFloat44(world * view_proj);
+        tr.world = convertMatrixToXMFloat44(world);
+        tr.wordlView2Proj2 = convertMatrixToXMFloat44(world * view_proj2);
+    }
 
-        chain.pushMatrix(p_proj);
-        chain.pushMatrix(final_view);
-        chain.pushMatrix(*p_worlds[i]);
-        chain.buildResult();
-        auto result{ chain.getResultTransform() };
+    // first write of the frame discards whole buffer, next ones are appended without stall
+    const D3D11_MAP map_type{ 0 == m_frameInstancesCount ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE };
 
-        mage::transform::MatrixChain chain2;
+    D3D11_MAPPED_SUBRESOURCE mapped = {};
+    hRes = m_lpd3ddevcontext->Map(m_frameInstancesBuffer, 0, map_type, 0, &mapped);
+    D3D11_CHECK(Map)
 
-        chain2.pushMatrix(p_proj2);
-        chain2.pushMatrix(final_view2);
-        chain2.pushMatrix(*p_worlds[i]);
-        chain2.buildResult();
-        auto result2{ chain2.getResultTransform() };
+    const size_t bytes{ sizeof(d3d11transformers) * m_frameInstancesStaging.size() };
+    memcpy(static_cast<d3d11transformers*>(mapped.pData) + m_frameInstancesCount, m_frameInstancesStaging.data(), bytes);
 
-        d3d11transformers tr;
-        tr.wordlViewProj = convertMatrixToXMFloat44(result);
-        tr.world = convertMatrixToXMFloat44(*p_worlds[i]);
-        tr.wordlView2Proj2 = convertMatrixToXMFloat44(result2);
+    m_lpd3ddevcontext->Unmap(m_frameInstancesBuffer, 0);
 
-        instances[i] = tr;
+    m_instancesUploadedBytes += bytes;
+
+    InstancesRange range;
+    range.worlds = p_worlds;
+    for (int i = 0; i < 4; i++)
+    {
+        range.views[i] = *views[i];
     }
+    range.start = m_frameInstancesCount;
+    m_frameInstancesRanges.emplace(key, std::move(range));
 
-    D3D11_MAPPED_SUBRESOURCE mapped = {};
-    hRes = m_lpd3ddevcontext->Map(p_meshe_data.transforms_buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
-    D3D11_CHECK(Map)
+    m_currentInstancesStart = m_frameInstancesCount;
+    m_frameInstancesCount += p_worlds.size();
+
+    return true;
+}
 
-    memcpy(mapped.pData, instances.data(), sizeof(d3d11transformers) * instances.size());
+size_t D3D11SystemImpl::getInstancesUploadedBytes() const
+{
+    return m_instancesUploadedBytes;
+}
 
-    m_lpd3ddevcontext->Unmap(p_meshe_data.transforms_buffer, 0);
+void D3D11SystemImpl::resetInstancesUploadedBytes()
+{
+    m_instancesUploadedBytes = 0;
 }
 
 bool D3D11SystemImpl::createTransformersInstancesBuffer(int p_size, ID3D11Buffer** p_outbuffer)
@@ -24,6 +24,8 @@
 
 #include "d3d11systemimpl.h"
 #include <d3dcompiler.h>
+#include <algorithm>
+#include <cstddef>
 
 #include "logsink.h"
 #include "logconf.h"
@@ -336,30 +338,99 @@ void D3D11SystemImpl::destroyPixelShader(const std::string& p_resource_uid)
 }
 
 
+void D3D11SystemImpl::writeShaderArgs(ShaderArg& p_args, ShaderArgUpload& p_upload, size_t p_offset, const void* p_data, size_t p_size)
+{
+    if (p_offset + p_size > sizeof(ShaderArg))
+    {
+        _EXCEPTION("shader constants out of range : offset " + std::to_string(p_offset) + " size " + std::to_string(p_size))
+    }
+
+    const auto end{ p_offset + p_size };
+    const auto dest{ reinterpret_cast<char*>(&p_args) + p_offset };
+
+    if (0 == memcmp(dest, p_data, p_size))
+    {
+        if (end <= p_upload.uploaded_size)
+        {
+            // same content, already on GPU side
+            return;
+        }
+    }
+    else
+    {
+        memcpy(dest, p_data, p_size);
+    }
+
+    p_upload.upload_size = std::max(p_upload.upload_size, end);
+    p_upload.dirty_begin = std::min(p_upload.dirty_begin, p_offset);
+    p_upload.dirty_end = std::max(p_upload.dirty_end, end);
+}
+
 void D3D11SystemImpl::setVertexshaderConstantsVec(int p_startreg, const mage::core::maths::Real4Vector& p_vec)
 {
-    m_vertexshader_args.vector[p_startreg].x = p_vec[0];
-    m_vertexshader_args.vector[p_startreg].y = p_vec[1];
-    m_vertexshader_args.vector[p_startreg].z = p_vec[2];
-    m_vertexshader_args.vector[p_startreg].w = p_vec[3];
+    const DirectX::XMFLOAT4 vec{ (float)p_vec[0], (float)p_vec[1], (float)p_vec[2], (float)p_vec[3] };
+    writeShaderArgs(m_vertexshader_args, m_vertexshader_args_upload, offsetof(ShaderArg, vector) + p_startreg * sizeof(DirectX::XMFLOAT4), &vec, sizeof(vec));
 }
 
 void D3D11SystemImpl::setPixelshaderConstantsVec(int p_startreg, const mage::core::maths::Real4Vector& p_vec)
 {
-    m_pixelshader_args.vector[p_startreg].x = p_vec[0];
-    m_pixelshader_args.vector[p_startreg].y = p_vec[1];
-    m_pixelshader_args.vector[p_startreg].z = p_vec[2];
-    m_pixelshader_args.vector[p_startreg].w = p_vec[3];
+    const DirectX::XMFLOAT4 vec{ (float)p_vec[0], (float)p_vec[1], (float)p_vec[2], (float)p_vec[3] };
+    writeShaderArgs(m_pixelshader_args, m_pixelshader_args_upload, offsetof(ShaderArg, vector) + p_startreg * sizeof(DirectX::XMFLOAT4), &vec, sizeof(vec));
+}
+
+void D3D11SystemImpl::setVertexshaderConstantsVecArray(int p_startreg, const std::vector<mage::core::maths::Float4Vector>& p_array)
+{
+    static_assert(sizeof(mage::core::maths::Float4Vector) == sizeof(DirectX::XMFLOAT4), "Float4Vector must match shader float4 register layout");
+    writeShaderArgs(m_vertexshader_args, m_vertexshader_args_upload, offsetof(ShaderArg, vector) + p_startreg * sizeof(DirectX::XMFLOAT4), p_array.data(), p_array.size() * sizeof(DirectX::XMFLOAT4));
+}
+
+void D3D11SystemImpl::setPixelshaderConstantsVecArray(int p_startreg, const std::vector<mage::core::maths::Float4Vector>& p_array)
+{
+    writeShaderArgs(m_pixelshader_args, m_pixelshader_args_upload, offsetof(ShaderArg, vector) + p_startreg * sizeof(DirectX::XMFLOAT4), p_array.data(), p_array.size() * sizeof(DirectX::XMFLOAT4));
 }
 
 void D3D11SystemImpl::setVertexshaderConstantsMat(int p_startreg, const mage::core::maths::Matrix& p_mat)
 {
-    auto& dest{ m_vertexshader_args.matrix[p_startreg] };
-    dest = convertMatrixToXMFloat44(p_mat);
+    const auto mat{ convertMatrixToXMFloat44(p_mat) };
+    writeShaderArgs(m_vertexshader_args, m_vertexshader_args_upload, offsetof(ShaderArg, matrix) + p_startreg * sizeof(DirectX::XMFLOAT4X4), &mat, sizeof(mat));
 }
 
 void D3D11SystemImpl::setPixelshaderConstantsMat(int p_startreg, const mage::core::maths::Matrix& p_mat)
 {
-    auto& dest{ m_pixelshader_args.matrix[p_startreg] };    
-    dest = convertMatrixToXMFloat44(p_mat);
-}
\ No newline at end of file
+    const auto mat{ convertMatrixToXMFloat44(p_mat) };
+    writeShaderArgs(m_pixelshader_args, m_pixelshader_args_upload, offsetof(ShaderArg, matrix) + p_startreg * sizeof(DirectX::XMFLOAT4X4), &mat, sizeof(mat));
+}
+
+void D3D11SystemImpl::uploadShaderArgs(ID3D11Buffer* p_buffer, const ShaderArg& p_args, ShaderArgUpload& p_upload)
+{
+    if (p_upload.dirty_begin >= p_upload.dirty_end)
+    {
+        // nothing changed since last upload : GPU buffer is up to date
+        return;
+    }
+
+    // WRITE_DISCARD gives a fresh buffer : all the used range [0, upload_size[ is copied at once
+    D3D11_MAPPED_SUBRESOURCE mapped = {};
+    const auto hRes{ m_lpd3ddevcontext->Map(p_buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped) };
+    if (S_OK == hRes)
+    {
+        memcpy(mapped.pData, &p_args, p_upload.upload_size);
+        m_lpd3ddevcontext->Unmap(p_buffer, 0);
+
+        m_shaderArgsUploadedBytes += p_upload.upload_size;
+
+        p_upload.uploaded_size = p_upload.upload_size;
+        p_upload.dirty_begin = sizeof(ShaderArg);
+        p_upload.dirty_end = 0;
+    }
+}
+
+size_t D3D11SystemImpl::getShaderArgsUploadedBytes() const
+{
+    return m_shaderArgsUploadedBytes;
+}
+
+void D3D11SystemImpl::resetShaderArgsUploadedBytes()
+{
+    m_shaderArgsUploadedBytes = 0;
+}
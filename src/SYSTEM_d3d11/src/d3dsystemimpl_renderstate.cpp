@@ -22,32 +22,59 @@
 */
 /* -*-LIC_END-*- */
 
+#include <algorithm>
 #include "d3d11systemimpl.h"
-#include "md5.h"
 
-void D3D11SystemImpl::setDepthStenciState(const mage::rendering::RenderState& p_renderstate)
+using namespace mage::rendering;
+
+static uint64_t hash_desc(const void* p_desc, size_t p_size)
 {
-    const auto arg{ p_renderstate.getArg() };
-    if (mage::rendering::RenderState::Operation::ENABLEZBUFFER == p_renderstate.getOperation())
+    uint64_t hash{ 14695981039346656037ULL };
+    const auto bytes{ static_cast<const uint8_t*>(p_desc) };
+    for (size_t i = 0; i < p_size; i++)
     {
-        if (m_currentDepthStencilState != arg)
-        {
-            if ("true" == arg)
-            {
-                m_lpd3ddevcontext->OMSetDepthStencilState(m_dsState_DepthTestEnabled, 1);
-            }
-            else
-            {
-                m_lpd3ddevcontext->OMSetDepthStencilState(m_dsState_DepthTestDisabled, 1);
-            }
-            m_currentDepthStencilState = arg;
-        }
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+void D3D11SystemImpl::applyRenderStateBlock(const RenderStateBlock& p_block)
+{
+    if (m_renderStateBlockBound && p_block.hash == m_currentRenderStateBlock)
+    {
+        // same block as previous draw : everything is already in place
+        return;
+    }
+
+    setDepthStenciState(p_block.zbuffer);
+    setSamplers(p_block.psSamplers, m_currentPSSamplers, false);
+    setSamplers(p_block.vsSamplers, m_currentVSSamplers, true);
+
+    // prepare updates
+    prepareRenderState(p_block);
+    prepareBlendState(p_block);
+
+    // apply updates
+    setCacheRS();
+    setCacheBlendstate();
+
+    m_currentRenderStateBlock = p_block.hash;
+    m_renderStateBlockBound = true;
+}
+
+void D3D11SystemImpl::setDepthStenciState(RenderStateBlock::Toggle p_zbuffer)
+{
+    if (RenderStateBlock::Toggle::UNSET != p_zbuffer && m_currentDepthStencilState != p_zbuffer)
+    {
+        m_currentDepthStencilState = p_zbuffer;
+        forceCurrentDepthStenciState();
     }
 }
 
 void D3D11SystemImpl::forceCurrentDepthStenciState()
 {
-    if ("true" == m_currentDepthStencilState)
+    if (RenderStateBlock::Toggle::ENABLED == m_currentDepthStencilState)
     {
         m_lpd3ddevcontext->OMSetDepthStencilState(m_dsState_DepthTestEnabled, 1);
     }
@@ -57,435 +84,218 @@ void D3D11SystemImpl::forceCurrentDepthStenciState()
     }
 }
 
+ID3D11SamplerState* D3D11SystemImpl::getSamplerState(RenderStateBlock::Sampler p_sampler) const
+{
+    switch (p_sampler)
+    {
+        case RenderStateBlock::Sampler::LINEAR:             return m_linearFilterSamplerState;
+        case RenderStateBlock::Sampler::ANISOTROPIC:        return m_anisotropicFilterSamplerState;
+        case RenderStateBlock::Sampler::POINT_UVWRAP:       return m_pointFilterSamplerState_uvwrap;
+        case RenderStateBlock::Sampler::LINEAR_UVWRAP:      return m_linearFilterSamplerState_uvwrap;
+        case RenderStateBlock::Sampler::ANISOTROPIC_UVWRAP: return m_anisotropicFilterSamplerState_uvwrap;
+        default:                                            return m_pointFilterSamplerState;
+    }
+}
 
-
-void D3D11SystemImpl::setPSSamplers(const mage::rendering::RenderState& p_renderstate)
+void D3D11SystemImpl::bindSampler(bool p_vertexStage, int p_stage, RenderStateBlock::Sampler p_sampler)
 {
-    static const std::map<std::string, ID3D11SamplerState*> translate_samplerstate =
+    ID3D11SamplerState* ss_array[] = { getSamplerState(p_sampler) };
+    if (p_vertexStage)
     {
-        { "none",               m_pointFilterSamplerState              },
-        { "point",              m_pointFilterSamplerState              },
-        { "linear",             m_linearFilterSamplerState             },
-        { "anisotropic",        m_anisotropicFilterSamplerState        },
-        { "point_uvwrap",       m_pointFilterSamplerState_uvwrap       },
-        { "linear_uvwrap",      m_linearFilterSamplerState_uvwrap      },
-        { "anisotropic_uvwrap", m_anisotropicFilterSamplerState_uvwrap }
-    };
-
-    const auto arg{ p_renderstate.getArg() };
-    if (mage::rendering::RenderState::Operation::SETTEXTUREFILTERTYPE == p_renderstate.getOperation())
+        m_lpd3ddevcontext->VSSetSamplers(p_stage, 1, ss_array);
+    }
+    else
     {
-        if ("extended" == arg)
-        {
-            ID3D11SamplerState* ss_array[] = { nullptr };
-
-            const auto args_list{ p_renderstate.getExtendedArgs() };
-            
-            auto index{ 0 };
-            m_currentPSExtendedSamplersLength = 0;
-
-            for (const auto& e : args_list)
-            {
-                if (m_currentPSExtendedSamplers[index] != e)
-                {
-                    m_currentPSExtendedSamplers[index] = e;
-                    m_currentPSExtendedSamplersLength++;
-
-                    ss_array[0] = translate_samplerstate.at(e);
-                    m_lpd3ddevcontext->PSSetSamplers(index++, 1, ss_array);
-                    
-                }
-            }
-
-            m_PSExtendedSamplers = true;
-        }
-        else
-        {
-            if (m_currentPSSampler != arg)
-            {
-                ID3D11SamplerState* ss_array[] = { translate_samplerstate.at(arg) };
-                for (auto i = 0; i < nbTextureStages; i++)
-                {
-                    m_lpd3ddevcontext->PSSetSamplers(i, 1, ss_array);
-                }
-                m_currentPSSampler = arg;
-            }
-
-            m_PSExtendedSamplers = false;
-        }
+        m_lpd3ddevcontext->PSSetSamplers(p_stage, 1, ss_array);
     }
 }
 
-void D3D11SystemImpl::setVSSamplers(const mage::rendering::RenderState& p_renderstate)
+void D3D11SystemImpl::setSamplers(const RenderStateBlock::Samplers& p_samplers, SamplersState& p_current, bool p_vertexStage)
 {
-    static const std::map<std::string, ID3D11SamplerState*> translate_samplerstate =
-    {
-        { "none",               m_pointFilterSamplerState              },
-        { "point",              m_pointFilterSamplerState              },
-        { "linear",             m_linearFilterSamplerState             },
-        { "anisotropic",        m_anisotropicFilterSamplerState        },
-        { "point_uvwrap",       m_pointFilterSamplerState_uvwrap       },
-        { "linear_uvwrap",      m_linearFilterSamplerState_uvwrap      },
-        { "anisotropic_uvwrap", m_anisotropicFilterSamplerState_uvwrap }
-    };
-
-    const auto arg{ p_renderstate.getArg() };
-    if (mage::rendering::RenderState::Operation::SETVERTEXTEXTUREFILTERTYPE == p_renderstate.getOperation())
+    if (p_samplers.extended)
     {
-        if ("extended" == arg)
+        const int nbStages{ std::min(p_samplers.nbStages, nbTextureStages) };
+        for (int i = 0; i < nbStages; i++)
         {
-            ID3D11SamplerState* ss_array[] = { nullptr };
-
-            const auto args_list{ p_renderstate.getExtendedArgs() };
-
-            auto index{ 0 };
-            m_currentVSExtendedSamplersLength = 0;
-
-            for (const auto& e : args_list)
+            if (!p_current.extended || p_current.stages[i] != p_samplers.stages[i])
             {
-                if (m_currentVSExtendedSamplers[index] != e)
-                {
-                    m_currentVSExtendedSamplers[index] = e;
-                    m_currentVSExtendedSamplersLength++;
-
-                    ss_array[0] = translate_samplerstate.at(e);
-                    m_lpd3ddevcontext->VSSetSamplers(index++, 1, ss_array);
-                }
+                p_current.stages[i] = p_samplers.stages[i];
+                bindSampler(p_vertexStage, i, p_samplers.stages[i]);
             }
-
-            m_VSExtendedSamplers = true;
         }
-        else
+        p_current.nbStages = nbStages;
+        p_current.extended = true;
+    }
+    else if (RenderStateBlock::Sampler::UNSET != p_samplers.global)
+    {
+        if (p_current.extended || p_current.global != p_samplers.global)
         {
-            if (m_currentPSSampler != arg)
+            for (int i = 0; i < nbTextureStages; i++)
             {
-                ID3D11SamplerState* ss_array[] = { translate_samplerstate.at(arg) };
-                for (auto i = 0; i < nbTextureStages; i++)
-                {
-                    m_lpd3ddevcontext->VSSetSamplers(i, 1, ss_array);
-                }
-                m_currentVSSampler = arg;
+                bindSampler(p_vertexStage, i, p_samplers.global);
             }
-
-            m_VSExtendedSamplers = false;
+            p_current.global = p_samplers.global;
         }
+        p_current.extended = false;
     }
 }
 
-void D3D11SystemImpl::forceCurrentPSSamplers()
+void D3D11SystemImpl::forceSamplers(const SamplersState& p_current, bool p_vertexStage)
 {
-    static const std::map<std::string, ID3D11SamplerState*> translate_samplerstate =
+    if (p_current.extended)
     {
-        { "none",               m_pointFilterSamplerState              },
-        { "point",              m_pointFilterSamplerState              },
-        { "linear",             m_linearFilterSamplerState             },
-        { "anisotropic",        m_anisotropicFilterSamplerState        },
-        { "point_uvwrap",       m_pointFilterSamplerState_uvwrap       },
-        { "linear_uvwrap",      m_linearFilterSamplerState_uvwrap      },
-        { "anisotropic_uvwrap", m_anisotropicFilterSamplerState_uvwrap }
-    };
-
-    if (m_PSExtendedSamplers)
-    {
-        ID3D11SamplerState* ss_array[] = { nullptr };
-
-        for (auto i = 0; i < m_currentPSExtendedSamplersLength; i++)
+        for (int i = 0; i < p_current.nbStages; i++)
         {
-            ss_array[0] = translate_samplerstate.at(m_currentPSExtendedSamplers[i]);
-            m_lpd3ddevcontext->PSSetSamplers(i, 1, ss_array);
+            bindSampler(p_vertexStage, i, p_current.stages[i]);
         }
     }
     else
     {
-        ID3D11SamplerState* ss_array[] = { translate_samplerstate.at(m_currentPSSampler) };
-        for (auto i = 0; i < nbTextureStages; i++)
+        for (int i = 0; i < nbTextureStages; i++)
         {
-            m_lpd3ddevcontext->PSSetSamplers(i, 1, ss_array);
-        }                    
+            bindSampler(p_vertexStage, i, p_current.global);
+        }
     }
 }
 
+void D3D11SystemImpl::forceCurrentPSSamplers()
+{
+    forceSamplers(m_currentPSSamplers, false);
+}
+
 void D3D11SystemImpl::forceCurrentVSSamplers()
 {
-    static const std::map<std::string, ID3D11SamplerState*> translate_samplerstate =
-    {
-        { "none",               m_pointFilterSamplerState              },
-        { "point",              m_pointFilterSamplerState              },
-        { "linear",             m_linearFilterSamplerState             },
-        { "anisotropic",        m_anisotropicFilterSamplerState        },
-        { "point_uvwrap",       m_pointFilterSamplerState_uvwrap       },
-        { "linear_uvwrap",      m_linearFilterSamplerState_uvwrap      },
-        { "anisotropic_uvwrap", m_anisotropicFilterSamplerState_uvwrap }
-    };
-
-    if (m_VSExtendedSamplers)
-    {
-        ID3D11SamplerState* ss_array[] = { nullptr };
+    forceSamplers(m_currentVSSamplers, true);
+}
 
-        for (auto i = 0; i < m_currentVSExtendedSamplersLength; i++)
-        {
-            ss_array[0] = translate_samplerstate.at(m_currentVSExtendedSamplers[i]);
-            m_lpd3ddevcontext->VSSetSamplers(i, 1, ss_array);
-        }
-    }
-    else
+static D3D11_BLEND translate_blendfactor(RenderStateBlock::BlendFactor p_factor)
+{
+    switch (p_factor)
     {
-        ID3D11SamplerState* ss_array[] = { translate_samplerstate.at(m_currentVSSampler) };
-        for (auto i = 0; i < nbTextureStages; i++)
-        {
-            m_lpd3ddevcontext->VSSetSamplers(i, 1, ss_array);
-        }
+        case RenderStateBlock::BlendFactor::ZERO:           return D3D11_BLEND_ZERO;
+        case RenderStateBlock::BlendFactor::SRCCOLOR:       return D3D11_BLEND_SRC_COLOR;
+        case RenderStateBlock::BlendFactor::INVSRCCOLOR:    return D3D11_BLEND_INV_SRC_COLOR;
+        case RenderStateBlock::BlendFactor::SRCALPHA:       return D3D11_BLEND_SRC_ALPHA;
+        case RenderStateBlock::BlendFactor::INVSRCALPHA:    return D3D11_BLEND_INV_SRC_ALPHA;
+        case RenderStateBlock::BlendFactor::DESTALPHA:      return D3D11_BLEND_DEST_ALPHA;
+        case RenderStateBlock::BlendFactor::INVDESTALPHA:   return D3D11_BLEND_INV_DEST_ALPHA;
+        case RenderStateBlock::BlendFactor::DESTCOLOR:      return D3D11_BLEND_DEST_COLOR;
+        case RenderStateBlock::BlendFactor::INVDESTCOLOR:   return D3D11_BLEND_INV_DEST_COLOR;
+        default:                                            return D3D11_BLEND_ONE;
     }
 }
 
+static D3D11_BLEND_OP translate_blendop(RenderStateBlock::BlendOp p_op)
+{
+    switch (p_op)
+    {
+        case RenderStateBlock::BlendOp::SUB:        return D3D11_BLEND_OP_SUBTRACT;
+        case RenderStateBlock::BlendOp::REVSUB:     return D3D11_BLEND_OP_REV_SUBTRACT;
+        case RenderStateBlock::BlendOp::MIN:        return D3D11_BLEND_OP_MIN;
+        case RenderStateBlock::BlendOp::MAX:        return D3D11_BLEND_OP_MAX;
+        default:                                    return D3D11_BLEND_OP_ADD;
+    }
+}
 
-void D3D11SystemImpl::prepareBlendState(const mage::rendering::RenderState& p_renderstate)
+void D3D11SystemImpl::prepareBlendState(const RenderStateBlock& p_block)
 {
-    const auto arg{ p_renderstate.getArg() };
+    auto& rtBlendDesc{ m_currentBlendDesc.RenderTarget[0] };
 
-    switch (p_renderstate.getOperation())
+    if (RenderStateBlock::Toggle::UNSET != p_block.alphablend)
     {
-        case mage::rendering::RenderState::Operation::ALPHABLENDENABLE:
-        {
-            if ("true" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].BlendEnable = TRUE;
-            }
-            else if ("false" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].BlendEnable = FALSE;
-            }
-        }
-        break;
+        rtBlendDesc.BlendEnable = (RenderStateBlock::Toggle::ENABLED == p_block.alphablend ? TRUE : FALSE);
+    }
 
-        case mage::rendering::RenderState::Operation::ALPHABLENDOP:
-        {
-            if ("add" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].BlendOp = D3D11_BLEND_OP_ADD;
-                m_currentBlendDesc.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_ADD;
-            }
-            else if ("sub" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].BlendOp = D3D11_BLEND_OP_SUBTRACT;
-                m_currentBlendDesc.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_SUBTRACT;
-            }
-            else if ("revsub" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].BlendOp = D3D11_BLEND_OP_REV_SUBTRACT;
-                m_currentBlendDesc.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_REV_SUBTRACT;
-            }
-            else if ("min" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].BlendOp = D3D11_BLEND_OP_MIN;
-                m_currentBlendDesc.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_MIN;
-            }
-            else if ("max" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].BlendOp = D3D11_BLEND_OP_MAX;
-                m_currentBlendDesc.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_MAX;
-            }
-        }
-        break;
+    if (RenderStateBlock::BlendOp::UNSET != p_block.alphablendOp)
+    {
+        rtBlendDesc.BlendOp = translate_blendop(p_block.alphablendOp);
+        rtBlendDesc.BlendOpAlpha = rtBlendDesc.BlendOp;
+    }
 
-        case mage::rendering::RenderState::Operation::ALPHABLENDFUNC:
-        {
-            if (arg != "always")
-            {
-                _EXCEPTION("unsupported alpha blending func for D3D11")
-            }
-        }
-        break;
+    if (RenderStateBlock::BlendFunc::OTHER == p_block.alphablendFunc)
+    {
+        _EXCEPTION("unsupported alpha blending func for D3D11")
+    }
 
-        case mage::rendering::RenderState::Operation::ALPHABLENDDEST:
-        {
-            if ("zero" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].DestBlend = D3D11_BLEND_ZERO;
-                m_currentBlendDesc.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_ZERO;
-            }
-            else if ("one" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].DestBlend = D3D11_BLEND_ONE;
-                m_currentBlendDesc.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_ONE;
-            }
-            else if ("srccolor" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].DestBlend = D3D11_BLEND_SRC_COLOR;
-                m_currentBlendDesc.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_SRC_COLOR;
-            }
-            else if ("invsrccolor" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].DestBlend = D3D11_BLEND_INV_SRC_COLOR;
-                m_currentBlendDesc.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_INV_SRC_COLOR;
-            }
-            else if ("srcalpha" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].DestBlend = D3D11_BLEND_SRC_ALPHA;
-                m_currentBlendDesc.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_SRC_ALPHA;
-            }
-            else if ("invsrcalpha" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].DestBlend = D3D11_BLEND_INV_SRC_ALPHA;
-                m_currentBlendDesc.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_INV_SRC_ALPHA;
-            }
-            else if ("destalpha" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].DestBlend = D3D11_BLEND_DEST_ALPHA;
-                m_currentBlendDesc.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_DEST_ALPHA;
-            }
-            else if ("invdestalpha" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].DestBlend = D3D11_BLEND_INV_DEST_ALPHA;
-                m_currentBlendDesc.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_INV_DEST_ALPHA;
-            }
-            else if ("destcolor" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].DestBlend = D3D11_BLEND_DEST_COLOR;
-                m_currentBlendDesc.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_DEST_COLOR;
-            }
-            else if ("invdestcolor" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].DestBlend = D3D11_BLEND_INV_DEST_COLOR;
-                m_currentBlendDesc.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_INV_DEST_COLOR;
-            }
-        }
-        break;
+    if (RenderStateBlock::BlendFactor::UNSET != p_block.alphablendDest)
+    {
+        rtBlendDesc.DestBlend = translate_blendfactor(p_block.alphablendDest);
+        rtBlendDesc.DestBlendAlpha = rtBlendDesc.DestBlend;
+    }
 
-        case mage::rendering::RenderState::Operation::ALPHABLENDSRC:
-        {
-            if ("zero" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].SrcBlend = D3D11_BLEND_ZERO;
-                m_currentBlendDesc.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_ZERO;
-            }
-            else if ("one" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].SrcBlend = D3D11_BLEND_ONE;
-                m_currentBlendDesc.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_ONE;
-            }
-            else if ("srccolor" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].SrcBlend = D3D11_BLEND_SRC_COLOR;
-                m_currentBlendDesc.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_SRC_COLOR;
-            }
-            else if ("invsrccolor" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].SrcBlend = D3D11_BLEND_INV_SRC_COLOR;
-                m_currentBlendDesc.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_INV_SRC_COLOR;
-            }
-            else if ("srcalpha" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].SrcBlend = D3D11_BLEND_SRC_ALPHA;
-                m_currentBlendDesc.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_SRC_ALPHA;
-            }
-            else if ("invsrcalpha" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].SrcBlend = D3D11_BLEND_INV_SRC_ALPHA;
-                m_currentBlendDesc.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_INV_SRC_ALPHA;
-            }
-            else if ("destalpha" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].SrcBlend = D3D11_BLEND_DEST_ALPHA;
-                m_currentBlendDesc.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_DEST_ALPHA;
-            }
-            else if ("invdestalpha" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].SrcBlend = D3D11_BLEND_INV_DEST_ALPHA;
-                m_currentBlendDesc.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_INV_DEST_ALPHA;
-            }
-            else if ("destcolor" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].SrcBlend = D3D11_BLEND_DEST_COLOR;
-                m_currentBlendDesc.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_DEST_COLOR;
-            }
-            else if ("invdestcolor" == arg)
-            {
-                m_currentBlendDesc.RenderTarget[0].SrcBlend = D3D11_BLEND_INV_DEST_COLOR;
-                m_currentBlendDesc.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_INV_DEST_COLOR;
-            }
-        }
-        break;
+    if (RenderStateBlock::BlendFactor::UNSET != p_block.alphablendSrc)
+    {
+        rtBlendDesc.SrcBlend = translate_blendfactor(p_block.alphablendSrc);
+        rtBlendDesc.SrcBlendAlpha = rtBlendDesc.SrcBlend;
     }
 }
 
-void D3D11SystemImpl::prepareRenderState(const mage::rendering::RenderState& p_renderstate)
+void D3D11SystemImpl::prepareRenderState(const RenderStateBlock& p_block)
 {
-    const auto arg{ p_renderstate.getArg() };
-   
-    switch (p_renderstate.getOperation())
+    switch (p_block.culling)
     {
-        case mage::rendering::RenderState::Operation::SETCULLING:
-        {           
-            if ("none" == arg)
-            {
-                m_currentRSDesc.CullMode = D3D11_CULL_NONE;
-                m_currentRSDesc.FrontCounterClockwise = FALSE;
-            }
-            else if ("cw" == arg)
-            {
-                // cull cw
-                m_currentRSDesc.CullMode = D3D11_CULL_FRONT;
-                m_currentRSDesc.FrontCounterClockwise = FALSE;
-                // cull cw
-            }
-            else
-            {
-                // cull ccw
-                m_currentRSDesc.CullMode = D3D11_CULL_BACK;
-                m_currentRSDesc.FrontCounterClockwise = FALSE;
-                // cull ccw
-            }
-        }
-        break;
+        case RenderStateBlock::Culling::NONE:
 
-        case mage::rendering::RenderState::Operation::SETFILLMODE:
-        {
-            if ("line" == arg)
-            {
-                m_currentRSDesc.FillMode = D3D11_FILL_WIREFRAME;
-            }
-            else if ("solid" == arg)
-            {
-                m_currentRSDesc.FillMode = D3D11_FILL_SOLID;
-            }
-        }
-        break;
+            m_currentRSDesc.CullMode = D3D11_CULL_NONE;
+            m_currentRSDesc.FrontCounterClockwise = FALSE;
+            break;
+
+        case RenderStateBlock::Culling::CW:
+
+            m_currentRSDesc.CullMode = D3D11_CULL_FRONT;
+            m_currentRSDesc.FrontCounterClockwise = FALSE;
+            break;
+
+        case RenderStateBlock::Culling::CCW:
+
+            m_currentRSDesc.CullMode = D3D11_CULL_BACK;
+            m_currentRSDesc.FrontCounterClockwise = FALSE;
+            break;
     }
-}
 
+    switch (p_block.fillmode)
+    {
+        case RenderStateBlock::FillMode::LINE:
+
+            m_currentRSDesc.FillMode = D3D11_FILL_WIREFRAME;
+            break;
+
+        case RenderStateBlock::FillMode::SOLID:
+
+            m_currentRSDesc.FillMode = D3D11_FILL_SOLID;
+            break;
+    }
+}
 
 bool D3D11SystemImpl::setCacheRS(bool p_force)
 {
     bool status{ true };
     DECLARE_D3D11ASSERT_VARS
 
-    const auto currRS{ m_currentRSDesc };
-    MD5 md5;
-
-    const std::string rsdesc_key{ md5.digestMemory((BYTE*)&currRS, sizeof(D3D11_RASTERIZER_DESC)) };
+    const auto rsdesc_key{ hash_desc(&m_currentRSDesc, sizeof(D3D11_RASTERIZER_DESC)) };
 
-    if (m_rsCache.count(rsdesc_key) > 0)
+    const auto it{ m_rsCache.find(rsdesc_key) };
+    if (it != m_rsCache.end())
     {
-        if (rsdesc_key != m_currentRenderStateMD5 || p_force)
+        if (rsdesc_key != m_currentRenderStateHash || p_force)
         {
             // not already applied
-            m_lpd3ddevcontext->RSSetState(m_rsCache.at(rsdesc_key).rs_state);
-            m_currentRenderStateMD5 = rsdesc_key;
+            m_lpd3ddevcontext->RSSetState(it->second.rs_state);
+            m_currentRenderStateHash = rsdesc_key;
         }
     }
     else
     {
         ID3D11RasterizerState* rs{ nullptr };
-        hRes = m_lpd3ddevice->CreateRasterizerState(&currRS, &rs);
+        hRes = m_lpd3ddevice->CreateRasterizerState(&m_currentRSDesc, &rs);
         D3D11_CHECK(CreateRasterizerState)
         m_lpd3ddevcontext->RSSetState(rs);
 
         // create new entry in cache
-        const RSCacheEntry cache_e{ currRS, rs };
+        const RSCacheEntry cache_e{ m_currentRSDesc, rs };
         m_rsCache[rsdesc_key] = cache_e; // store in cache
 
-        m_currentRenderStateMD5 = rsdesc_key;
+        m_currentRenderStateHash = rsdesc_key;
     }
     return status;
 }
@@ -495,34 +305,32 @@ bool D3D11SystemImpl::setCacheBlendstate(bool p_force)
     bool status{ true };
     DECLARE_D3D11ASSERT_VARS
 
-    const auto currBlendDesc{ m_currentBlendDesc };
-    MD5 md5;
-
     FLOAT bvals[4]{ 0.0, 0.0, 0.0, 0.0 };
 
-    const std::string bsdesc_key{ md5.digestMemory((BYTE*)&currBlendDesc, sizeof(D3D11_BLEND_DESC)) };
+    const auto bsdesc_key{ hash_desc(&m_currentBlendDesc, sizeof(D3D11_BLEND_DESC)) };
 
-    if (m_bsCache.count(bsdesc_key) > 0)
+    const auto it{ m_bsCache.find(bsdesc_key) };
+    if (it != m_bsCache.end())
     {
-        if (bsdesc_key != m_currentBlendStateMD5 || p_force)
+        if (bsdesc_key != m_currentBlendStateHash || p_force)
         {
             // not already applied
-            m_lpd3ddevcontext->OMSetBlendState(m_bsCache.at(bsdesc_key).bs_state, bvals, 0xffffffff);
-            m_currentBlendStateMD5 = bsdesc_key;
+            m_lpd3ddevcontext->OMSetBlendState(it->second.bs_state, bvals, 0xffffffff);
+            m_currentBlendStateHash = bsdesc_key;
         }
     }
     else
     {
         ID3D11BlendState* bs{ nullptr };
-        hRes = m_lpd3ddevice->CreateBlendState(&currBlendDesc, &bs);
+        hRes = m_lpd3ddevice->CreateBlendState(&m_currentBlendDesc, &bs);
         D3D11_CHECK(CreateBlendState)
         m_lpd3ddevcontext->OMSetBlendState(bs, bvals, 0xffffffff);
 
         // create new entry in cache
-        const BSCacheEntry cache_e{ currBlendDesc, bs };
+        const BSCacheEntry cache_e{ m_currentBlendDesc, bs };
         m_bsCache[bsdesc_key] = cache_e; // store in cache
 
-        m_currentBlendStateMD5 = bsdesc_key;
+        m_currentBlendStateHash = bsdesc_key;
     }
     return status;
-}
\ No newline at end of file
+}
@@ -22,13 +22,14 @@
 */
 /* -*-LIC_END-*- */
 
-#include <chrono>
 #include <string>
 
 #include <unordered_map>
 #include <sstream>  
+#include <iomanip>
 
 #include "dataprintsystem.h"
+#include "profiler.h"
 #include "entity.h"
 #include "entitygraph.h"
 #include "aspects.h"
@@ -41,17 +42,143 @@
 using namespace mage;
 using namespace mage::core;
 
+namespace
+{
+	void append_vector(std::string& p_out, const double* p_values, int p_size)
+	{
+		p_out += " [ ";
+		for (int i = 0; i < p_size; i++)
+		{
+			p_out += std::to_string(p_values[i]);
+			p_out += ' ';
+		}
+		p_out += ']';
+	}
+}
+
+template<typename T, class Func>
+void DataPrintSystem::registerFormatter(const Func& p_format)
+{
+	m_formatters[typeid(T).hash_code()] = [p_format](const std::string& p_id) -> RowFormatter
+	{
+		const auto handle{ mage::rendering::Datacloud::getInstance()->getDataHandle<T>(p_id) };
+		return [handle, p_format, p_id](std::string& p_out)
+		{
+			p_out.assign(p_id);
+			p_format(handle.read(), p_out);
+		};
+	};
+}
+
 DataPrintSystem::DataPrintSystem(Entitygraph& p_entitygraph) : System(p_entitygraph)
 {
+	declareAccess(core::timeAspect::id, core::SystemAccess::READ);
+	declareAccess(core::renderingAspect::id, core::SystemAccess::WRITE);
+	// datacloud subscriber below is not synchronized with run()
+	declareMainThreadOnly();
+
+	const auto append_scalar{ [](const auto& p_value, std::string& p_out) { p_out += ' '; p_out += std::to_string(p_value); } };
+
+	registerFormatter<long>(append_scalar);
+	registerFormatter<int>(append_scalar);
+	registerFormatter<unsigned long>(append_scalar);
+	registerFormatter<unsigned int>(append_scalar);
+	registerFormatter<size_t>(append_scalar);
+	registerFormatter<__time64_t>(append_scalar);
+	registerFormatter<float>(append_scalar);
+	registerFormatter<double>(append_scalar);
+
+	registerFormatter<core::maths::IntCoords2D>([](const core::maths::IntCoords2D& p_value, std::string& p_out)
+	{
+		p_out += " [ " + std::to_string(p_value[0]) + " " + std::to_string(p_value[1]) + " ]";
+	});
+
+	registerFormatter<core::maths::FloatCoords2D>([](const core::maths::FloatCoords2D& p_value, std::string& p_out)
+	{
+		p_out += " [ " + std::to_string(p_value[0]) + " " + std::to_string(p_value[1]) + " ]";
+	});
+
+	registerFormatter<core::maths::Real3Vector>([](const core::maths::Real3Vector& p_value, std::string& p_out)
+	{
+		const double values[]{ p_value[0], p_value[1], p_value[2] };
+		append_vector(p_out, values, 3);
+	});
+
+	registerFormatter<core::maths::Real4Vector>([](const core::maths::Real4Vector& p_value, std::string& p_out)
+	{
+		const double values[]{ p_value[0], p_value[1], p_value[2], p_value[3] };
+		append_vector(p_out, values, 4);
+	});
+
+	registerFormatter<std::string>([](const std::string& p_value, std::string& p_out)
+	{
+		p_out += ' ';
+		p_out += p_value;
+	});
+
+	registerFormatter<core::profiler::ZoneStats>([](const core::profiler::ZoneStats& p_value, std::string& p_out)
+	{
+		std::ostringstream ss;
+		ss << std::fixed << std::setprecision(2) << " " << p_value.last_ms << " ms (min " << p_value.min_ms << " avg " << p_value.avg_ms << " p99 " << p_value.p99_ms << ")";
+		p_out += ss.str();
+	});
+
+	// rows follow datacloud changes : values are formatted again only if updated
 	const auto dataCloud{ mage::rendering::Datacloud::getInstance() };
-	dataCloud->registerData<std::string>("mage.timings.dataprintsystem");
+	m_dc_subscriber = dataCloud->registerSubscriber([&, this](rendering::DatacloudEvent p_event, const std::string& p_id, const std::string&)
+	{
+		switch (p_event)
+		{
+			case rendering::DatacloudEvent::DATA_ADDED:
+
+				if (!m_dc_rows_rebuild && checkDcVar(p_id))
+				{
+					addDcRow(p_id);
+				}
+				break;
+
+			case rendering::DatacloudEvent::DATA_REMOVED:
+
+				if (m_dc_rows.erase(p_id))
+				{
+					m_dc_rows_changed = true;
+				}
+				break;
+
+			case rendering::DatacloudEvent::DATA_UPDATED:
+			{
+				const auto it{ m_dc_rows.find(p_id) };
+				if (it != m_dc_rows.end())
+				{
+					it->second.updated = true;
+				}
+				break;
+			}
+		}
+	});
+}
+
+DataPrintSystem::~DataPrintSystem()
+{
+	mage::rendering::Datacloud::getInstance()->unregisterSubscriber(m_dc_subscriber);
 }
 
 void DataPrintSystem::run()
 {
-	const auto start_time{ std::chrono::high_resolution_clock::now() };
+	_MAGE_PROFILE_ZONE("dataprintsystem");
+
+	if (m_dc_rows_rebuild)
+	{
+		rebuildDcRows();
+	}
+
+	if (isRefreshTime())
+	{
+		collectDatacloudVars();
 
-	collectData();
+		if (m_display_synchronizedvars) collectSyncVars();
+		if (m_display_renderingqueues) collectRenderingQueues();
+	}
 
 	print(m_dc_strings, 0, 0, dcNbCols, dcNbRows, dcColWidth, dcRowHeight);
 
@@ -69,10 +196,6 @@ void DataPrintSystem::run()
 	const int x_pos = window_dims[0] - (rqNbCols * rqColWidth);
 
 	if(m_display_renderingqueues) print(m_rq_strings, x_pos, 0, rqNbCols, rqNbRows, rqColWidth, rqRowHeight);
-
-	const auto end_time{ std::chrono::high_resolution_clock::now() };
-	const auto duration{ std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time) };
-	dataCloud->updateDataValue<std::string>("mage.timings.dataprintsystem", std::to_string(duration.count()) + " ms");
 }
 
 void DataPrintSystem::setRenderingQueue(mage::rendering::Queue* p_queue)
@@ -127,153 +250,92 @@ bool DataPrintSystem::checkDcVar(const std::string& p_var_id) const
 	return status;
 }
 
-void DataPrintSystem::collectData()
+bool DataPrintSystem::isRefreshTime()
 {
-	/////// collect datacloud vars
-
-	m_dc_strings.clear();
+	const auto now{ std::chrono::steady_clock::now() };
+	if (m_refresh_rate > 0.0 && now - m_last_refresh < std::chrono::duration<double>(1.0 / m_refresh_rate))
+	{
+		return false;
+	}
+	m_last_refresh = now;
+	return true;
+}
 
+void DataPrintSystem::addDcRow(const std::string& p_var_id)
+{
 	const auto dataCloud{ mage::rendering::Datacloud::getInstance() };
-	const auto dataCloudVariables{ dataCloud->getVarsIdsList() };
+	const auto& vars{ dataCloud->getVarsIdsList() };
 
-	for (const auto& e : dataCloudVariables)
+	const auto it{ vars.find(p_var_id) };
+	if (it == vars.end())
 	{
-		const std::string var_id{ e.first };
-		if (checkDcVar(var_id))
-		{
-			const size_t type_id{ e.second };
-
-			std::string var_str_value;
+		// already removed
+		return;
+	}
 
-			std::unordered_map<size_t, std::function<void(const std::string&)>> conv_funcs
-			{
-				{
-					typeid(long).hash_code(),
-					[&](const std::string& p_id)
-					{
-						const auto value { dataCloud->readDataValue<long>(p_id) };
-						var_str_value = p_id + " " + std::to_string(value);
-					}
-				},
-				{
-					typeid(int).hash_code(),
-					[&](const std::string& p_id)
-					{
-						const auto value { dataCloud->readDataValue<int>(p_id) };
-						var_str_value = p_id + " " + std::to_string(value);
-					}
-				},
-				{
-					typeid(unsigned long).hash_code(),
-					[&](const std::string& p_id)
-					{
-						const auto value { dataCloud->readDataValue<unsigned long>(p_id) };
-						var_str_value = p_id + " " + std::to_string(value);
-					}
-				},
-				{
-					typeid(unsigned int).hash_code(),
-					[&](const std::string& p_id)
-					{
-						const auto value { dataCloud->readDataValue<unsigned int>(p_id) };
-						var_str_value = p_id + " " + std::to_string(value);
-					}
-				},
-				{
-					typeid(size_t).hash_code(),
-					[&](const std::string& p_id)
-					{
-						const auto value { dataCloud->readDataValue<size_t>(p_id) };
-						var_str_value = p_id + " " + std::to_string(value);
-					}
-				},
-				{
-					typeid(__time64_t).hash_code(),
-					[&](const std::string& p_id)
-					{
-						const auto value { dataCloud->readDataValue<__time64_t>(p_id) };
-						var_str_value = p_id + " " + std::to_string(value);
-					}
-				},
-				{
-					typeid(float).hash_code(),
-					[&](const std::string& p_id)
-					{
-						const auto value { dataCloud->readDataValue<float>(p_id) };
-						var_str_value = p_id + " " + std::to_string(value);
-					}
-				},
-				{
-					typeid(double).hash_code(),
-					[&](const std::string& p_id)
-					{
-						const auto value { dataCloud->readDataValue<double>(p_id) };
-						var_str_value = p_id + " " + std::to_string(value);
-					}
-				},
-				{
-					typeid(core::maths::IntCoords2D).hash_code(),
-					[&](const std::string& p_id)
-					{
-						const auto value { dataCloud->readDataValue<core::maths::IntCoords2D>(p_id) };
-						var_str_value = p_id + " " + "[ " + std::to_string(value[0]) + " " + std::to_string(value[1]) + " ]";
-					}
-				},
-				{
-					typeid(core::maths::FloatCoords2D).hash_code(),
-					[&](const std::string& p_id)
-					{
-						const auto value { dataCloud->readDataValue<core::maths::FloatCoords2D>(p_id) };
-						var_str_value = p_id + " " + "[ " + std::to_string(value[0]) + " " + std::to_string(value[1]) + " ]";
-					}
-				},
-				{
-					typeid(core::maths::Real3Vector).hash_code(),
-					[&](const std::string& p_id)
-					{
-						const auto value { dataCloud->readDataValue<core::maths::Real3Vector>(p_id) };
-						var_str_value = p_id + " " + "[ " + std::to_string(value[0]) + " " + std::to_string(value[1]) + " " + std::to_string(value[2]) + " ]";
-					}
-				},
-				{
-					typeid(core::maths::Real4Vector).hash_code(),
-					[&](const std::string& p_id)
-					{
-						const auto value { dataCloud->readDataValue<core::maths::Real4Vector>(p_id) };
-						var_str_value = p_id + " " + "[ " + std::to_string(value[0]) + " " + std::to_string(value[1]) + " " + std::to_string(value[2]) + " " + std::to_string(value[3]) + " ]";
-					}
-				},
-				{
-					typeid(std::string).hash_code(),
-					[&](const std::string& p_id)
-					{
-						const auto value { dataCloud->readDataValue<std::string>(p_id) };
-						var_str_value = p_id + " " + value;
-					}
-				}
+	DcRow row;
+	if (m_formatters.count(it->second))
+	{
+		row.formatter = m_formatters.at(it->second)(p_var_id);
+	}
+	else
+	{
+		// cannot infer type
+		row.text = p_var_id + " <unknown type>";
+		row.updated = false;
+	}
 
-			};
+	m_dc_rows[p_var_id] = std::move(row);
+	m_dc_rows_changed = true;
+}
 
+void DataPrintSystem::rebuildDcRows()
+{
+	m_dc_rows.clear();
 
-			/////////////////////////////////////////////////////////////
+	const auto dataCloud{ mage::rendering::Datacloud::getInstance() };
+	for (const auto& e : dataCloud->getVarsIdsList())
+	{
+		if (checkDcVar(e.first))
+		{
+			addDcRow(e.first);
+		}
+	}
 
-			if (conv_funcs.count(type_id))
-			{
-				conv_funcs.at(type_id)(var_id);
-			}
-			else
-			{
-				// cannot infer type
+	m_dc_rows_rebuild = false;
+	m_dc_rows_changed = true;
+}
 
-				var_str_value = var_id + " <unknown type>";
-			}
+void DataPrintSystem::collectDatacloudVars()
+{
+	const auto dataCloud{ mage::rendering::Datacloud::getInstance() };
 
-			m_dc_strings.push_back(var_str_value);
+	for (auto& e : m_dc_rows)
+	{
+		auto& row{ e.second };
+		if (row.updated && row.formatter && dataCloud->hasData(e.first))
+		{
+			row.formatter(row.text);
+			row.updated = false;
+			m_dc_rows_changed = true;
 		}
 	}
 
-	/////// collect sync vars
+	if (m_dc_rows_changed)
+	{
+		m_dc_strings.resize(m_dc_rows.size());
+
+		size_t i{ 0 };
+		for (const auto& e : m_dc_rows)
+		{
+			m_dc_strings[i++] = e.second.text;
+		}
+		m_dc_rows_changed = false;
+	}
+}
 
+void DataPrintSystem::collectSyncVars()
+{
 	m_sv_strings.clear();
 
 	auto entities_with_time{ m_entitygraph.getEntitiesListForAspect(core::timeAspect::id) };
@@ -281,7 +343,7 @@ void DataPrintSystem::collectData()
 	{
 		const ComponentContainer& time_components{ entity->aspectAccess(core::timeAspect::id) };
 
-		const auto comps{ time_components.getComponentsIdList() };
+		const auto& comps{ time_components.getComponentsIdList() };
 		const size_t sv_hash{ typeid(core::SyncVariable).hash_code() };
 
 		for (const auto& e : comps)
@@ -320,9 +382,10 @@ void DataPrintSystem::collectData()
 			}
 		}
 	}
+}
 
-	/////// collect rendering queues
-
+void DataPrintSystem::collectRenderingQueues()
+{
 	m_rq_strings.clear();
 
 	auto entities_with_rendering{ m_entitygraph.getEntitiesListForAspect(core::renderingAspect::id) };
@@ -397,11 +460,13 @@ void DataPrintSystem::print(const std::vector<std::string>& p_list, int p_x_base
 void DataPrintSystem::addDatacloudFilter(const std::string& p_filter)
 {
 	m_display_filters.push_back({ p_filter });
+	m_dc_rows_rebuild = true;
 }
 
 void DataPrintSystem::addDatacloudFilter(const std::vector<std::string>& p_filter)
 {
 	m_display_filters.push_back( p_filter );
+	m_dc_rows_rebuild = true;
 }
 
 void DataPrintSystem::showRenderingQueues(bool p_show)
@@ -412,4 +477,9 @@ void DataPrintSystem::showRenderingQueues(bool p_show)
 void DataPrintSystem::showSyncVars(bool p_show)
 {
 	m_display_synchronizedvars = p_show;
-}
\ No newline at end of file
+}
+
+void DataPrintSystem::setRefreshRate(double p_rate)
+{
+	m_refresh_rate = p_rate;
+}
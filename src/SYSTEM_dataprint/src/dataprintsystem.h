@@ -28,6 +28,10 @@
 #include <vector>
 #include <string>
 #include <set>
+#include <map>
+#include <unordered_map>
+#include <functional>
+#include <chrono>
 #include "system.h"
 
 
@@ -47,7 +51,7 @@ namespace mage
     public:
         DataPrintSystem() = delete;
         DataPrintSystem(core::Entitygraph& p_entitygraph);
-        ~DataPrintSystem() = default;
+        ~DataPrintSystem();
 
         void run();
 
@@ -59,6 +63,9 @@ namespace mage
         void showRenderingQueues(bool p_show);
         void showSyncVars(bool p_show);
 
+        // displayed values refresh frequency (Hz), 0.0 : each frame
+        void setRefreshRate(double p_rate);
+
     private:
 
         static constexpr int                    dcNbCols{ 1 };
@@ -77,8 +84,28 @@ namespace mage
         static constexpr int                    rqRowHeight{ 21 };
 
 
+        using RowFormatter = std::function<void(std::string&)>;                         // format current value of one datacloud var
+        using RowFormatterFactory = std::function<RowFormatter(const std::string&)>;    // build formatter for a var id
+
+        struct DcRow
+        {
+            RowFormatter    formatter;
+            std::string     text;
+            bool            updated{ true };
+        };
+
         mage::rendering::Queue*                 m_renderingQueue{ nullptr };
 
+        std::unordered_map<size_t, RowFormatterFactory> m_formatters; // per type hash, registered once
+
+        std::map<std::string, DcRow>            m_dc_rows; // displayed datacloud vars, sorted by id
+        size_t                                  m_dc_subscriber{ 0 };
+        bool                                    m_dc_rows_rebuild{ true };
+        bool                                    m_dc_rows_changed{ true };
+
+        double                                  m_refresh_rate{ 4.0 };
+        std::chrono::steady_clock::time_point   m_last_refresh;
+
         std::vector<std::string>                m_dc_strings; // dataclouds display inputs
 
         std::vector<std::string>                m_sv_strings; // synchronized var display inputs
@@ -90,7 +117,17 @@ namespace mage
         bool                                    m_display_renderingqueues{ false };
         bool                                    m_display_synchronizedvars{ false };
 
-        void collectData();
+        template<typename T, class Func>
+        void registerFormatter(const Func& p_format);
+
+        void addDcRow(const std::string& p_var_id);
+        void rebuildDcRows();
+
+        bool isRefreshTime();
+
+        void collectDatacloudVars();
+        void collectSyncVars();
+        void collectRenderingQueues();
         void print(const std::vector<std::string>& p_list, int p_x_base, int p_y_base, int p_nbCols, int p_nbRows, int p_colWidth, int p_rowHeight);
 
         static std::vector<std::string> splitString(const std::string& p_str, char p_delimiter);
@@ -23,12 +23,13 @@
 /* -*-LIC_END-*- */
 
 #include<utility>
-#include <chrono>
 #include <string>
 #include<map>
 #include<vector>
+#include <algorithm>
 
 #include "renderingqueuesystem.h"
+#include "profiler.h"
 #include "entity.h"
 #include "entitygraph.h"
 #include "aspects.h"
@@ -41,6 +42,7 @@
 #include "exceptions.h"
 #include "worldposition.h"
 #include "datacloud.h"
+#include "framearena.h"
 
 #include "logsink.h"
 #include "logconf.h"
@@ -54,8 +56,27 @@ using namespace mage::core;
 RenderingQueueSystem::RenderingQueueSystem(Entitygraph& p_entitygraph) : System(p_entitygraph),
 m_localLogger("RenderingQueueSystem", mage::core::logger::Configuration::getInstance())
 {
+	declareAccess(core::resourcesAspect::id, core::SystemAccess::READ);
+	declareAccess(core::worldAspect::id, core::SystemAccess::READ);
+	declareAccess(core::renderingAspect::id, core::SystemAccess::WRITE);
+	// queues events are handled by D3D11System and application callbacks
+	declareMainThreadOnly();
+	declareExclusive();
+
 	const auto dataCloud{ mage::rendering::Datacloud::getInstance() };
-	dataCloud->registerData<std::string>("mage.timings.renderingqueuesystem");
+	m_rendergraph_culled_passes = dataCloud->registerData<long>("mage.renderingqueuesystem.rendergraph_culled_passes");
+	m_rendergraph_estimated_saved_bytes = dataCloud->registerData<long>("mage.renderingqueuesystem.rendergraph_estimated_saved_bytes");
+
+	m_entitygraph_events = m_entitygraph.getEventBus().registerConsumer();
+
+	// shaders args connections follow datacloud variables lifetime
+	m_dc_subscriber = dataCloud->registerSubscriber([this](rendering::DatacloudEvent p_event, const std::string& p_id, const std::string&)
+	{
+		if (rendering::DatacloudEvent::DATA_ADDED == p_event || rendering::DatacloudEvent::DATA_REMOVED == p_event)
+		{
+			m_shaders_args_to_rebind.insert(p_id);
+		}
+	});
 
 	////// Register callback to entitygraph
 
@@ -65,12 +86,14 @@ m_localLogger("RenderingQueueSystem", mage::core::logger::Configuration::getInst
 		{
 			if (mage::core::EntitygraphEvents::ENTITYGRAPHNODE_REMOVED == p_event)
 			{		
+				// before entity deletion : watched draw flags may belong to it
+				m_rendergraph_dirty = true;
+
 				rendering::Queue* current_queue{ nullptr };
 
 				for (auto it = m_entitygraph.preBegin(); it != m_entitygraph.preEnd(); ++it)
 				{
 					const auto current_entity{ it->data() };
-					const auto currEntityId{ current_entity->getId() };
 
 					if (current_entity->hasAspect(mage::core::renderingAspect::id))
 					{
@@ -84,12 +107,12 @@ m_localLogger("RenderingQueueSystem", mage::core::logger::Configuration::getInst
 						}
 					}
 
-					if (currEntityId == p_removed_entity.getId() && 
+					if (current_entity == &p_removed_entity && 
 						current_queue)
 					{
 						// found the entity that will be removed...
 
-						removeFromRenderingQueue(p_removed_entity.getId(), *current_queue);
+						removeFromRenderingQueue(p_removed_entity, *current_queue);
 					}
 				}
 			}
@@ -98,16 +121,63 @@ m_localLogger("RenderingQueueSystem", mage::core::logger::Configuration::getInst
 	p_entitygraph.registerSubscriber(eg_cb);
 }
 
+RenderingQueueSystem::~RenderingQueueSystem()
+{
+	m_entitygraph.getEventBus().unregisterConsumer(m_entitygraph_events);
+	mage::rendering::Datacloud::getInstance()->unregisterSubscriber(m_dc_subscriber);
+}
+
 void RenderingQueueSystem::run()
 {
-	const auto start_time{ std::chrono::high_resolution_clock::now() };
+	_MAGE_PROFILE_ZONE("renderingqueuesystem");
 
 	manageRenderingQueue();
 
-	const auto end_time{ std::chrono::high_resolution_clock::now() };
-	const auto duration{ std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time) };
-	const auto dataCloud{ mage::rendering::Datacloud::getInstance() };
-	dataCloud->updateDataValue<std::string>("mage.timings.renderingqueuesystem", std::to_string(duration.count()) + " ms");
+	if (m_shaders_args_to_rebind.size())
+	{
+		rebindShadersArgs();
+	}
+
+	checkRendergraphChanges();
+	if (m_rendergraph_dirty)
+	{
+		compileRendergraph();
+		m_rendergraph_dirty = false;
+	}
+}
+
+void RenderingQueueSystem::checkRendergraphChanges()
+{
+	constexpr auto mask{ property::EventBus<core::EntitygraphEvent>::typeBit(core::EntitygraphEvents::ENTITYGRAPHNODE_COMMITTED, core::EntitygraphEvents::ENTITYGRAPHNODE_ASPECT_ADDED) };
+
+	m_entitygraph.getEventBus().drain(m_entitygraph_events, mask, [this](const core::EntitygraphEvent&)
+	{
+		m_rendergraph_dirty = true;
+	});
+
+	if (m_rendergraph_dirty)
+	{
+		return;
+	}
+
+	const auto arena{ core::FrameArena::getInstance() };
+
+	for (const auto& e : m_rendergraph_watched_draws)
+	{
+		const auto entity{ m_entitygraph.getEntity(e.entity) };
+		if (nullptr == entity || !entity->hasAspect(core::renderingAspect::id))
+		{
+			m_rendergraph_dirty = true;
+			return;
+		}
+
+		const auto drawing_controls{ entity->aspectAccess(core::renderingAspect::id).getComponentsByType<rendering::DrawingControl>(arena) };
+		if (0 == drawing_controls.size() || drawing_controls.at(0) != e.drawing_control || drawing_controls.at(0)->getPurpose().draw != e.draw)
+		{
+			m_rendergraph_dirty = true;
+			return;
+		}
+	}
 }
 
 void RenderingQueueSystem::requestRenderingqueueLogging(const std::string& p_entityid)
@@ -117,10 +187,10 @@ void RenderingQueueSystem::requestRenderingqueueLogging(const std::string& p_ent
 
 void RenderingQueueSystem::logRenderingqueue(const std::string& p_entity_id, mage::rendering::Queue& p_renderingQueue) const
 {
-	_MAGE_DEBUG(m_localLogger, ">>>>>>>>>>>>>>> QUEUE DUMP BEGIN <<<<<<<<<<<<<<<<<<<<<<<<")
+	_MAGE_DEBUG(m_localLogger, ">>>>>>>>>>>>>>> QUEUE DUMP BEGIN <<<<<<<<<<<<<<<<<<<<<<<<");
 	_MAGE_DEBUG(m_localLogger, "for entity : " + p_entity_id);
 
-	_MAGE_DEBUG(m_localLogger, "name : " + p_renderingQueue.getName())
+	_MAGE_DEBUG(m_localLogger, "name : " + p_renderingQueue.getName());
 
 	const std::map<rendering::Queue::Purpose, std::string> purpose_translate
 	{
@@ -128,7 +198,7 @@ void RenderingQueueSystem::logRenderingqueue(const std::string& p_entity_id, mag
 		{ rendering::Queue::Purpose::SCREEN_RENDERING, "SCREEN_RENDERING" },
 		{ rendering::Queue::Purpose::BUFFER_RENDERING, "BUFFER_RENDERING" },
 	};
-	_MAGE_DEBUG(m_localLogger, "purpose : " + purpose_translate.at(p_renderingQueue.getPurpose()))
+	_MAGE_DEBUG(m_localLogger, "purpose : " + purpose_translate.at(p_renderingQueue.getPurpose()));
 
 	const std::map<rendering::Queue::State, std::string> state_translate
 	{
@@ -136,9 +206,9 @@ void RenderingQueueSystem::logRenderingqueue(const std::string& p_entity_id, mag
 		{ rendering::Queue::State::READY, "READY" }/*,
 		{ rendering::Queue::State::ERROR_ORPHAN, "ERROR_ORPHAN" },*/
 	};
-	_MAGE_DEBUG(m_localLogger, "state : " + state_translate.at(p_renderingQueue.getState()))
+	_MAGE_DEBUG(m_localLogger, "state : " + state_translate.at(p_renderingQueue.getState()));
 
-	_MAGE_DEBUG(m_localLogger, "clear_target : " + std::to_string(p_renderingQueue.getTargetClearing()))
+	_MAGE_DEBUG(m_localLogger, "clear_target : " + std::to_string(p_renderingQueue.getTargetClearing()));
 
 	if (p_renderingQueue.getTargetClearing())
 	{
@@ -146,7 +216,7 @@ void RenderingQueueSystem::logRenderingqueue(const std::string& p_entity_id, mag
 		_MAGE_DEBUG(m_localLogger, "clear_target_color : " + std::to_string(clear_color.r())
 														+ " " + std::to_string(clear_color.g()) 
 														+ " " + std::to_string(clear_color.b()) 
-														+ " " + std::to_string(clear_color.a()))
+														+ " " + std::to_string(clear_color.a()));
 	}
 
 	// queue node dump
@@ -154,7 +224,7 @@ void RenderingQueueSystem::logRenderingqueue(const std::string& p_entity_id, mag
 
 	if (!qnodes.size())
 	{
-		_MAGE_DEBUG(m_localLogger, "Empty queue")
+		_MAGE_DEBUG(m_localLogger, "Empty queue");
 	}
 	else
 	{
@@ -177,7 +247,12 @@ void RenderingQueueSystem::logRenderingqueue(const std::string& p_entity_id, mag
 
 				for (const auto& rs : shader_payload.list)
 				{
-					_MAGE_DEBUG(m_localLogger, "\t\t\t-> renderstate : " + rs.first);
+					std::string rs_set_dump;
+					for (const auto& e : rs.second.description)
+					{
+						rs_set_dump += e.toString() + "; ";
+					}
+					_MAGE_DEBUG(m_localLogger, "\t\t\t-> renderstate : " + rs_set_dump + "(" + std::to_string(rs.first) + ")");
 
 					if (rs.second.triangles_dc_list.size() > 0)
 					{
@@ -186,12 +261,12 @@ void RenderingQueueSystem::logRenderingqueue(const std::string& p_entity_id, mag
 
 					for (const auto& triangles_dc : rs.second.triangles_dc_list)
 					{
-						_MAGE_DEBUG(m_localLogger, "\t\t\t\t-> triangles_dc : " + triangles_dc.first + " worlds stack size = " + std::to_string(triangles_dc.second.worlds.size()) );
+						_MAGE_DEBUG(m_localLogger, "\t\t\t\t-> triangles_dc : " + triangles_dc.second.owner_entity_id + " worlds stack size = " + std::to_string(triangles_dc.second.worlds.size()) );
 					}
 
 					for (const auto& lines_dc : rs.second.lines_dc_list)
 					{
-						_MAGE_DEBUG(m_localLogger, "\t\t\t\t-> lines_dc : " + lines_dc.first + " worlds stack size = " + std::to_string(lines_dc.second.worlds.size()));						
+						_MAGE_DEBUG(m_localLogger, "\t\t\t\t-> lines_dc : " + lines_dc.second.owner_entity_id + " worlds stack size = " + std::to_string(lines_dc.second.worlds.size()));						
 					}
 				}
 			}
@@ -290,7 +365,7 @@ void RenderingQueueSystem::manageRenderingQueue()
 			if (entity->hasAspect(mage::core::resourcesAspect::id))
 			{
 				const auto& resource_aspect{ entity->aspectAccess(mage::core::resourcesAspect::id) };
-				checkEntityInsertion(currEntityId, resource_aspect, rendering_aspect, *current_queue);
+				checkEntityInsertion(entity, resource_aspect, rendering_aspect, *current_queue);
 			}
 
 			// search for text rendering in rendering aspect
@@ -325,6 +400,169 @@ void RenderingQueueSystem::manageRenderingQueue()
 	}
 }
 
+void RenderingQueueSystem::compileRendergraph()
+{
+	_MAGE_PROFILE_ZONE("renderingqueuesystem.rendergraph");
+
+	rendering::RendergraphCompiler compiler;
+
+	auto entities_with_rendering{ m_entitygraph.getEntitiesListForAspect(core::renderingAspect::id) };
+
+	///////// targets : render target textures, read by the queue drawing the entity holding them
+
+	// several entities can share a target : one consumer edge per reading queue, persistent if any reader is
+	std::unordered_map<std::string, rendering::RendergraphCompiler::TargetDescr> targets;
+	std::vector<std::string> targets_order;
+	std::unordered_map<rendering::Queue*, std::vector<std::string>> queues_inputs;
+
+	m_rendergraph_watched_draws.clear();
+
+	for (Entity* entity : entities_with_rendering)
+	{
+		if (!entity->hasAspect(core::resourcesAspect::id))
+		{
+			continue;
+		}
+
+		const auto& resource_aspect{ entity->aspectAccess(core::resourcesAspect::id) };
+		const auto textures_list{ resource_aspect.getComponentsByType<std::pair<size_t, mage::Texture>>() };
+
+		if (0 == textures_list.size())
+		{
+			continue;
+		}
+
+		const auto& rendering_aspect{ entity->aspectAccess(core::renderingAspect::id) };
+		const auto drawing_controls{ rendering_aspect.getComponentsByType<rendering::DrawingControl>() };
+
+		// no drawing control : standalone target texture (see helpers::plugTargetTexture), read by scene entities
+		const bool standalone{ 0 == drawing_controls.size() };
+
+		// quad not drawn : its textures are not consumed
+		rendering::Queue* consumer{ nullptr };
+		if (!standalone)
+		{
+			const bool draw{ drawing_controls.at(0)->getPurpose().draw };
+			m_rendergraph_watched_draws.push_back({ entity->getHandle(), drawing_controls.at(0), draw });
+
+			if (draw)
+			{
+				consumer = searchRenderingQueueInAncestors(entity);
+			}
+		}
+
+		for (const auto& e : textures_list)
+		{
+			const auto& texture{ e->getPurpose().second };
+			if (mage::Texture::Source::CONTENT_FROM_RENDERINGQUEUE != texture.getSource())
+			{
+				continue;
+			}
+
+			const auto uid{ texture.getResourceUID() };
+			const bool persistent{ standalone || mage::Texture::ContentAccessMode::CONTENT_ACCESS == texture.getContentAccessMode() };
+
+			if (targets.count(uid))
+			{
+				targets.at(uid).persistent |= persistent;
+			}
+			else
+			{
+				rendering::RendergraphCompiler::TargetDescr target;
+				target.id = uid;
+				target.format = texture.getFormat();
+				target.width = texture.getWidth();
+				target.height = texture.getHeight();
+				target.persistent = persistent;
+
+				targets[uid] = target;
+				targets_order.push_back(uid);
+			}
+
+			if (consumer)
+			{
+				auto& inputs{ queues_inputs[consumer] };
+				if (std::find(inputs.begin(), inputs.end(), uid) == inputs.end())
+				{
+					inputs.push_back(uid);
+				}
+			}
+		}
+	}
+
+	for (const auto& uid : targets_order)
+	{
+		compiler.addTarget(targets.at(uid));
+	}
+
+	///////// passes : ready queues
+
+	std::unordered_map<std::string, rendering::Queue*> queues;
+
+	for (Entity* entity : entities_with_rendering)
+	{
+		const auto& rendering_aspect{ entity->aspectAccess(core::renderingAspect::id) };
+		const auto rendering_queues_list{ rendering_aspect.getComponentsByType<rendering::Queue>() };
+
+		if (0 == rendering_queues_list.size())
+		{
+			continue;
+		}
+
+		auto& renderingQueue{ rendering_queues_list.at(0)->getPurpose() };
+		if (rendering::Queue::State::READY != renderingQueue.getState())
+		{
+			continue;
+		}
+
+		rendering::RendergraphCompiler::PassDescr pass;
+		pass.id = renderingQueue.getName();
+
+		if (queues_inputs.count(&renderingQueue))
+		{
+			pass.inputs = queues_inputs.at(&renderingQueue);
+		}
+
+		if (rendering::Queue::Purpose::BUFFER_RENDERING == renderingQueue.getPurpose())
+		{
+			pass.output = renderingQueue.getTargetTextureUID();
+			if (!targets.count(pass.output))
+			{
+				// target not visible in rendergraph : keep queue
+				pass.output = "";
+			}
+		}
+
+		compiler.addPass(pass);
+		queues[pass.id] = &renderingQueue;
+	}
+
+	///////// compile only if rendergraph changed
+
+	if (compiler.getPasses() == m_rendergraphCompiler.getPasses() && compiler.getTargets() == m_rendergraphCompiler.getTargets())
+	{
+		return;
+	}
+	m_rendergraphCompiler = compiler;
+
+	const auto result{ compiler.compile() };
+
+	for (auto& q : queues)
+	{
+		q.second->m_culled = false;
+	}
+	for (const auto& culled : result.culled_passes)
+	{
+		queues.at(culled)->m_culled = true;
+	}
+
+	const auto dataCloud{ mage::rendering::Datacloud::getInstance() };
+	dataCloud->updateDataValue(m_rendergraph_culled_passes, static_cast<long>(result.culled_passes.size()));
+	dataCloud->updateDataValue(m_rendergraph_estimated_saved_bytes, static_cast<long>(result.declared_bytes - result.allocated_bytes));
+
+	_MAGE_DEBUG(m_localLogger, "rendergraph compiled :\n" + result.report());
+}
+
 void RenderingQueueSystem::handleRenderingQueuesState(Entity* p_entity, rendering::Queue& p_renderingQueue)
 {
 	switch (p_renderingQueue.getState())
@@ -362,7 +600,7 @@ void RenderingQueueSystem::handleRenderingQueuesState(Entity* p_entity, renderin
 									// set queue purpose accordingly
 
 									p_renderingQueue.setScreenRenderingPurpose();
-									_MAGE_DEBUG(m_localLogger, "rendering queue " + p_renderingQueue.getName() + " set to READY, SCREEN_RENDERING")
+									_MAGE_DEBUG(m_localLogger, "rendering queue " + p_renderingQueue.getName() + " set to READY, SCREEN_RENDERING");
 								}
 								else
 								{
@@ -390,10 +628,11 @@ void RenderingQueueSystem::handleRenderingQueuesState(Entity* p_entity, renderin
 										_EXCEPTION("Missing rendertarget texture on requested stage for BUFFER_RENDERING queue : " + p_renderingQueue.getName());
 									}
 
-									_MAGE_DEBUG(m_localLogger, "rendering queue " + p_renderingQueue.getName() + " set to READY, BUFFER_RENDERING")
+									_MAGE_DEBUG(m_localLogger, "rendering queue " + p_renderingQueue.getName() + " set to READY, BUFFER_RENDERING");
 								}
 
 								p_renderingQueue.setState(rendering::Queue::State::READY);
+								m_rendergraph_dirty = true;
 
 								for (const auto& call : m_callbacks)
 								{
@@ -429,15 +668,64 @@ void RenderingQueueSystem::handleRenderingQueuesState(Entity* p_entity, renderin
 	}
 }
 
-static std::string build_rs_list_id(const std::vector<mage::rendering::RenderState>& p_rs_list)
+static rendering::QueueDrawingControl::ShaderArgConnection make_shader_arg_connection(const std::string& p_datacloud_id, const mage::Shader::GenericArgument& p_argument)
 {
-	std::string rs_set_signature;
-	for (const auto& e : p_rs_list)
+	rendering::QueueDrawingControl::ShaderArgConnection connection;
+	connection.datacloud_id = p_datacloud_id;
+	connection.argument = p_argument;
+
+	const auto dataCloud{ rendering::Datacloud::getInstance() };
+	if ("Real4Vector" == p_argument.argument_type && dataCloud->hasData(p_datacloud_id))
 	{
-		rs_set_signature += e.toString() + "; ";
+		connection.real4vector = dataCloud->getDataHandle<core::maths::Real4Vector>(p_datacloud_id);
 	}
+	return connection;
+}
 
-	return rs_set_signature;
+void RenderingQueueSystem::rebindShadersArgs()
+{
+	const auto rebind{ [&](std::vector<rendering::QueueDrawingControl::ShaderArgConnection>& p_connections)
+	{
+		for (auto& connection : p_connections)
+		{
+			if (m_shaders_args_to_rebind.count(connection.datacloud_id))
+			{
+				connection = make_shader_arg_connection(connection.datacloud_id, connection.argument);
+			}
+		}
+	} };
+
+	for (Entity* entity : m_entitygraph.getEntitiesListForAspect(core::renderingAspect::id))
+	{
+		const auto& rendering_aspect{ entity->aspectAccess(core::renderingAspect::id) };
+		const auto rendering_queues_list{ rendering_aspect.getComponentsByType<rendering::Queue>() };
+
+		if (0 == rendering_queues_list.size())
+		{
+			continue;
+		}
+
+		for (auto& channel : rendering_queues_list.at(0)->getPurpose().m_queueNodes)
+		{
+			for (auto& shaders_payload : channel.second.list)
+			{
+				for (auto& rs_payload : shaders_payload.second.list)
+				{
+					for (auto& qdc : rs_payload.second.triangles_dc_list)
+					{
+						rebind(qdc.second.vshaders_map_cnx);
+						rebind(qdc.second.pshaders_map_cnx);
+					}
+					for (auto& qdc : rs_payload.second.lines_dc_list)
+					{
+						rebind(qdc.second.vshaders_map_cnx);
+						rebind(qdc.second.pshaders_map_cnx);
+					}
+				}
+			}
+		}
+	}
+	m_shaders_args_to_rebind.clear();
 }
 
 static void const connect_shaders_args(/*mage::core::logger::Sink& p_localLogger,*/
@@ -456,7 +744,7 @@ static void const connect_shaders_args(/*mage::core::logger::Sink& p_localLogger
 		{
 			if (argument_id == connection_pair.second)
 			{
-				p_queueDrawingControl.vshaders_map_cnx.push_back(std::make_pair(connection_pair.first, current_arg));
+				p_queueDrawingControl.vshaders_map_cnx.push_back(make_shader_arg_connection(connection_pair.first, current_arg));
 			}
 		}
 	}
@@ -472,7 +760,7 @@ static void const connect_shaders_args(/*mage::core::logger::Sink& p_localLogger
 		{
 			if (argument_id == connection_pair.second)
 			{
-				p_queueDrawingControl.pshaders_map_cnx.push_back(std::make_pair(connection_pair.first, current_arg));
+				p_queueDrawingControl.pshaders_map_cnx.push_back(make_shader_arg_connection(connection_pair.first, current_arg));
 			}
 		}
 	}
@@ -480,7 +768,7 @@ static void const connect_shaders_args(/*mage::core::logger::Sink& p_localLogger
 }
 
 
-void RenderingQueueSystem::checkEntityInsertion(const std::string& p_entity_id, const mage::core::ComponentContainer& p_resourceAspect,
+void RenderingQueueSystem::checkEntityInsertion(const core::Entity* p_entity, const mage::core::ComponentContainer& p_resourceAspect,
 												const mage::core::ComponentContainer& p_renderingAspect, 
 												mage::rendering::Queue& p_renderingQueue)
 {	
@@ -497,7 +785,8 @@ void RenderingQueueSystem::checkEntityInsertion(const std::string& p_entity_id,
 			if (!drawingControl.ready)
 			{
 				notAllReady = true;
-				drawingControl.owner_entity_id = p_entity_id;
+				drawingControl.owner_entity_id = p_entity->getId();
+				drawingControl.owner_entity = p_entity->getHandle();
 			}
 		}
 
@@ -714,7 +1003,15 @@ void RenderingQueueSystem::checkEntityInsertion(const std::string& p_entity_id,
 							shaderPayloadPtr = &newShaderPayload;
 						}
 
-						const auto rs_list_id{ build_rs_list_id(rsStates.at(0)->getPurpose()) };
+						const auto& rs_description{ rsStates.at(0)->getPurpose() };
+						auto rs_list_id{ rendering::RenderStateBlock::computeHash(rs_description) };
+
+						// hash collision with another renderstates set : probe next key
+						while (shaderPayloadPtr->list.count(rs_list_id) &&
+							!rendering::RenderStateBlock::sameDescription(shaderPayloadPtr->list.at(rs_list_id).description, rs_description))
+						{
+							rs_list_id++;
+						}
 
 						mage::rendering::Queue::RenderStatePayload newRenderStatePayload;
 						mage::rendering::Queue::RenderStatePayload* renderStatePayloadPtr{ nullptr };
@@ -741,8 +1038,9 @@ void RenderingQueueSystem::checkEntityInsertion(const std::string& p_entity_id,
 								/// common parts
 										
 								linesQueueDrawingControl.owner_entity_id = linesDrawingControl.owner_entity_id;
+								linesQueueDrawingControl.owner_entity = linesDrawingControl.owner_entity;
 
-								pushWorldOutputToQueueDrawingControl(p_entity_id, linesQueueDrawingControl);
+								pushWorldOutputToQueueDrawingControl(p_entity, linesQueueDrawingControl);
 
 								connect_shaders_args(linesDrawingControl, linesQueueDrawingControl, vshader, pshader);
 
@@ -763,7 +1061,7 @@ void RenderingQueueSystem::checkEntityInsertion(const std::string& p_entity_id,
 
 								/// register
 										
-								renderStatePayloadPtr->lines_dc_list[linesDrawingControl.owner_entity_id] = linesQueueDrawingControl;
+								renderStatePayloadPtr->lines_dc_list[linesDrawingControl.owner_entity] = linesQueueDrawingControl;
 							}
 						}
 						else if (triangle_meshe_ref)
@@ -791,8 +1089,9 @@ void RenderingQueueSystem::checkEntityInsertion(const std::string& p_entity_id,
 								/// common parts
 
 								trianglesQueueDrawingControl.owner_entity_id = trianglesDrawingControl.owner_entity_id;
+								trianglesQueueDrawingControl.owner_entity = trianglesDrawingControl.owner_entity;
 
-								pushWorldOutputToQueueDrawingControl(p_entity_id, trianglesQueueDrawingControl);
+								pushWorldOutputToQueueDrawingControl(p_entity, trianglesQueueDrawingControl);
 	
 
 								trianglesQueueDrawingControl.projected_z_neg = &trianglesDrawingControl.projected_z_neg;
@@ -817,7 +1116,7 @@ void RenderingQueueSystem::checkEntityInsertion(const std::string& p_entity_id,
 
 								/// register
 								//
-								renderStatePayloadPtr->triangles_dc_list[trianglesDrawingControl.owner_entity_id] = trianglesQueueDrawingControl;
+								renderStatePayloadPtr->triangles_dc_list[trianglesDrawingControl.owner_entity] = trianglesQueueDrawingControl;
 
 							}
 						}
@@ -846,8 +1145,9 @@ void RenderingQueueSystem::checkEntityInsertion(const std::string& p_entity_id,
 								/// common parts
 
 								trianglesQueueDrawingControl.owner_entity_id = trianglesDrawingControl.owner_entity_id;
+								trianglesQueueDrawingControl.owner_entity = trianglesDrawingControl.owner_entity;
 				
-								pushWorldOutputToQueueDrawingControl(p_entity_id, trianglesQueueDrawingControl);
+								pushWorldOutputToQueueDrawingControl(p_entity, trianglesQueueDrawingControl);
 
 								trianglesQueueDrawingControl.projected_z_neg = &trianglesDrawingControl.projected_z_neg;
 
@@ -873,34 +1173,34 @@ void RenderingQueueSystem::checkEntityInsertion(const std::string& p_entity_id,
 								
 								if (0 == renderStatePayloadPtr->triangles_dc_list.size())
 								{
-									renderStatePayloadPtr->triangles_dc_list[trianglesDrawingControl.owner_entity_id] = trianglesQueueDrawingControl;
+									renderStatePayloadPtr->triangles_dc_list[trianglesDrawingControl.owner_entity] = trianglesQueueDrawingControl;
 								}
 								else
 								{
 									// POUR LA GESTION DU DRAWINDEXEDINSTANCED !!! -> push les matrices worlds sur le meme QueueDrawingControl !!!!
 
 									bool found = false;
-									std::string found_trianglesQueueDrawingControl_owner_entity_id;
+									core::EntityHandle found_trianglesQueueDrawingControl_owner_entity;
 
 									for (const auto& qtdc : renderStatePayloadPtr->triangles_dc_list)
 									{										
 										if (qtdc.second == trianglesQueueDrawingControl) // cf bool QueueTrianglesDrawingControl::operator==(const QueueTrianglesDrawingControl& p_other) const -> mme meshe id et textures !!
 										{
 											found = true;
-											found_trianglesQueueDrawingControl_owner_entity_id = qtdc.first;
+											found_trianglesQueueDrawingControl_owner_entity = qtdc.first;
 											break;
 										}
 									}
 
 									if (!found)
 									{
-										renderStatePayloadPtr->triangles_dc_list[trianglesDrawingControl.owner_entity_id] = trianglesQueueDrawingControl;
+										renderStatePayloadPtr->triangles_dc_list[trianglesDrawingControl.owner_entity] = trianglesQueueDrawingControl;
 									}
 									else
 									{
-										auto& qtdc = renderStatePayloadPtr->triangles_dc_list.at(found_trianglesQueueDrawingControl_owner_entity_id);
+										auto& qtdc = renderStatePayloadPtr->triangles_dc_list.at(found_trianglesQueueDrawingControl_owner_entity);
 
-										pushWorldOutputToQueueDrawingControl(p_entity_id, qtdc);
+										pushWorldOutputToQueueDrawingControl(p_entity, qtdc);
 									}
 								}
 							}
@@ -909,7 +1209,9 @@ void RenderingQueueSystem::checkEntityInsertion(const std::string& p_entity_id,
 						if (!shaderPayloadPtr->list.count(rs_list_id))
 						{
 							// new renderStatePayload
-							newRenderStatePayload.description = rsStates.at(0)->getPurpose();
+							newRenderStatePayload.description = rs_description;
+							newRenderStatePayload.block = rendering::RenderStateBlock(newRenderStatePayload.description);
+							newRenderStatePayload.block.hash = rs_list_id; // unique key, used by renderer to skip redundant state changes
 							shaderPayloadPtr->list[rs_list_id] = newRenderStatePayload;
 						}
 
@@ -931,7 +1233,7 @@ void RenderingQueueSystem::checkEntityInsertion(const std::string& p_entity_id,
 }
 
 
-void RenderingQueueSystem::removeFromRenderingQueue(const std::string& p_entity_id, mage::rendering::Queue& p_renderingQueue)
+void RenderingQueueSystem::removeFromRenderingQueue(const core::Entity& p_entity, mage::rendering::Queue& p_renderingQueue)
 {
 	auto queueNodes{ p_renderingQueue.getQueueNodes() };
 
@@ -944,55 +1246,29 @@ void RenderingQueueSystem::removeFromRenderingQueue(const std::string& p_entity_
 		std::vector<std::string> shaders_pair_to_remove;
 		for (auto& shaders : rendering_channel.list)
 		{
-			std::vector<std::string> rs_to_remove;
+			std::vector<rendering::RenderStateBlock::Hash> rs_to_remove;
 
 			for (auto& rs : shaders.second.list)
 			{
 
 				//// line meshes
-				std::vector<std::string> ldc_to_remove;
-		
-				for (auto& ldc : rs.second.lines_dc_list)
+				if (rs.second.lines_dc_list.erase(p_entity.getHandle()))
 				{
-					if (ldc.second.owner_entity_id == p_entity_id)
+					for (const auto& call : m_callbacks)
 					{
-						ldc_to_remove.push_back(p_entity_id);
-
-						for (const auto& call : m_callbacks)
-						{
-							call(RenderingQueueSystemEvent::LINEDRAWING_REMOVED, p_entity_id, p_renderingQueue);
-						}
+						call(RenderingQueueSystemEvent::LINEDRAWING_REMOVED, p_entity.getId(), p_renderingQueue);
 					}
 				}
 
-				for (const std::string& id : ldc_to_remove)
-				{
-					rs.second.lines_dc_list.erase(id);
-				}
-
-
 				//// triangle meshes
-				std::vector<std::string> tdc_to_remove;
-				
-				for (auto& tdc : rs.second.triangles_dc_list)
+				if (rs.second.triangles_dc_list.erase(p_entity.getHandle()))
 				{
-					if (tdc.second.owner_entity_id == p_entity_id)
-					{						
-						// remove this triangle dc
-						tdc_to_remove.push_back(p_entity_id);
-
-						for (const auto& call : m_callbacks)
-						{
-							call(RenderingQueueSystemEvent::TRIANGLEDRAWING_REMOVED, p_entity_id, p_renderingQueue);
-						}
+					for (const auto& call : m_callbacks)
+					{
+						call(RenderingQueueSystemEvent::TRIANGLEDRAWING_REMOVED, p_entity.getId(), p_renderingQueue);
 					}
 				}
 
-				for (const std::string& id : tdc_to_remove)
-				{
-					rs.second.triangles_dc_list.erase(id);
-				}
-
 				////////////////////
 
 				if (0 == rs.second.lines_dc_list.size() && 0 == rs.second.triangles_dc_list.size())
@@ -1002,7 +1278,7 @@ void RenderingQueueSystem::removeFromRenderingQueue(const std::string& p_entity_
 				}				
 			}
 
-			for (const std::string& id : rs_to_remove)
+			for (const auto id : rs_to_remove)
 			{
 				shaders.second.list.erase(id);
 			}
@@ -1024,7 +1300,7 @@ void RenderingQueueSystem::removeFromRenderingQueue(const std::string& p_entity_
 
 		if (0 == rendering_channel.list.size())
 		{
-			_MAGE_DEBUG(m_localLogger, "rendering order channel is now empty, remove : " + std::to_string(qnode.first))
+			_MAGE_DEBUG(m_localLogger, "rendering order channel is now empty, remove : " + std::to_string(qnode.first));
 			roc_to_remove.push_back(qnode.first);
 		}
 	}
@@ -1100,11 +1376,9 @@ void RenderingQueueSystem::addQueuesToViewGroup(const std::string& p_viewGroupId
 	}
 }
 
-void RenderingQueueSystem::pushWorldOutputToQueueDrawingControl(const std::string& p_entity_id, rendering::QueueDrawingControl& p_outqtdc)
+void RenderingQueueSystem::pushWorldOutputToQueueDrawingControl(const core::Entity* p_entity, rendering::QueueDrawingControl& p_outqtdc)
 {
-	const Entitygraph::Node& node{ m_entitygraph.node(p_entity_id) };
-	const auto entity{ node.data() };
-	auto& world_aspect{ entity->aspectAccess(mage::core::worldAspect::id) };
+	const auto& world_aspect{ p_entity->aspectAccess(mage::core::worldAspect::id) };
 
 	// search if world aspect is delegated to a separated scene entity, represented by a Entity* component in this local entity world aspect
 
@@ -1132,7 +1406,7 @@ void RenderingQueueSystem::pushWorldOutputToQueueDrawingControl(const std::strin
 		const auto& worldpositions_list{ world_aspect.getComponentsByType<transform::WorldPosition>() };
 		if (0 == worldpositions_list.size())
 		{
-			_EXCEPTION("entity world aspect : missing world position on entity " + p_entity_id);
+			_EXCEPTION("entity world aspect : missing world position on entity " + p_entity->getId());
 		}
 		const transform::WorldPosition& worldposition{ worldpositions_list.at(0)->getPurpose() };
 
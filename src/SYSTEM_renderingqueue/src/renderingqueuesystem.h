@@ -34,13 +34,15 @@
 #include "logconf.h"
 #include "logging.h"
 #include "eventsource.h"
+#include "datacloud.h"
+#include "rendergraphcompiler.h"
 
 namespace mage
 {
     namespace core { class Entity; }
     namespace core { class Entitygraph; }
     namespace core { class ComponentContainer; }
-    namespace rendering { struct Queue; struct QueueDrawingControl; }
+    namespace rendering { struct Queue; struct QueueDrawingControl; struct DrawingControl; }
 
     enum class RenderingQueueSystemEvent
     {
@@ -69,7 +71,7 @@ namespace mage
 
         RenderingQueueSystem() = delete;
         RenderingQueueSystem(core::Entitygraph& p_entitygraph);
-        ~RenderingQueueSystem() = default;
+        ~RenderingQueueSystem();
 
         void        run();
         void        requestRenderingqueueLogging(const std::string& p_entityid);
@@ -90,25 +92,51 @@ namespace mage
 
         std::unordered_map<std::string, ViewGroup>          m_cameraViewGroups;
 
+        // last compiled rendergraph description
+        rendering::RendergraphCompiler                      m_rendergraphCompiler;
+
+        // rendergraph compiled again only if set : queue ready, entity committed or removed, render target quad draw flag toggled
+        bool                                                m_rendergraph_dirty{ true };
+
+        // render target quads drawing controls : resolved again from entity each frame (component can be removed alone)
+        struct WatchedDraw
+        {
+            core::EntityHandle                                  entity;
+            const core::Component<rendering::DrawingControl>*   drawing_control{ nullptr }; // identity only, never dereferenced
+            bool                                                draw{ false };
+        };
+        std::vector<WatchedDraw>                            m_rendergraph_watched_draws;
+        property::EventBus<core::EntitygraphEvent>::ConsumerId m_entitygraph_events;
+
+        rendering::Datacloud::DataHandle<long>              m_rendergraph_culled_passes;
+        rendering::Datacloud::DataHandle<long>              m_rendergraph_estimated_saved_bytes; // headless estimate : pooling plan not applied by D3D11 backend yet
+
+        // datacloud variables added or removed since last run : shaders args connections to resolve again
+        std::unordered_set<std::string>                     m_shaders_args_to_rebind;
+        rendering::Datacloud::SubscriberId                  m_dc_subscriber{ 0 };
+
         void manageRenderingQueue();
+        void checkRendergraphChanges();
+        void compileRendergraph();
+        void rebindShadersArgs();
         void handleRenderingQueuesState(core::Entity* p_entity, rendering::Queue& p_renderingQueue);
 
         void checkEntityInsertion(
-                                    const std::string& p_entity_id, 
+                                    const core::Entity* p_entity, 
                                     const mage::core::ComponentContainer& p_resourceAspect,
                                     const mage::core::ComponentContainer& p_renderingAspect, 
                                     mage::rendering::Queue& p_renderingQueue
                                 );
 
         void removeFromRenderingQueue(
-                                    const std::string& p_entity_id, 
+                                    const core::Entity& p_entity, 
                                     mage::rendering::Queue& p_renderingQueue
                                 );
 
 
         void logRenderingqueue(const std::string& p_entity_id, mage::rendering::Queue& p_renderingQueue) const;
 
-        void pushWorldOutputToQueueDrawingControl(const std::string& p_entity_id, rendering::QueueDrawingControl& p_outqtdc);
+        void pushWorldOutputToQueueDrawingControl(const core::Entity* p_entity, rendering::QueueDrawingControl& p_outqtdc);
 
     };
 }
\ No newline at end of file
@@ -22,10 +22,10 @@
 */
 /* -*-LIC_END-*- */
 
-#include <chrono>
 #include <string>
 
 #include "resourcesystem.h"
+#include "profiler.h"
 
 #include "entity.h"
 #include "entitygraph.h"
@@ -51,11 +51,14 @@ ResourceSystem::ResourceSystem(Entitygraph& p_entitygraph) : System(p_entitygrap
 m_localLogger("ResourceSystem", mage::core::logger::Configuration::getInstance()),
 m_localLoggerRunner("ResourceSystemRunner", mage::core::logger::Configuration::getInstance())
 {
+	declareAccess(core::resourcesAspect::id, core::SystemAccess::WRITE);
+	// runners events are dispatched to application callbacks
+	declareMainThreadOnly();
+	declareExclusive();
+
 	const auto dataCloud{ mage::rendering::Datacloud::getInstance() };
 	dataCloud->registerData<std::string>("mage.resourcesystem.event");	
 
-	dataCloud->registerData<std::string>("mage.timings.resourcesystem");
-	
 	///////////////////////////////////////////
 
 	m_runner.reserve(nbRunners);
@@ -90,7 +93,17 @@ m_localLoggerRunner("ResourceSystemRunner", mage::core::logger::Configuration::g
 	{
 		[&, this](mage::core::RunnerEvent p_event, const std::string& p_target_descr, const std::string& p_action_descr)
 		{
-			if (mage::core::RunnerEvent::TASK_ERROR == p_event)
+			if (mage::core::RunnerEvent::TASK_ERROR == p_event && texturePrefetchAction == p_action_descr)
+			{
+				// prefetch is only a hint
+				_MAGE_WARN(m_localLoggerRunner, std::string("prefetch failed on target ") + p_target_descr);
+
+				for (const auto& call : m_callbacks)
+				{
+					call(ResourceSystemEvent::RESOURCE_TEXTURE_PREFETCH_ERROR, p_target_descr);
+				}
+			}
+			else if (mage::core::RunnerEvent::TASK_ERROR == p_event)
 			{
 				_EXCEPTION(std::string("failed action ") + p_action_descr + " on target " + p_target_descr);
 			}
@@ -116,7 +129,7 @@ ResourceSystem::~ResourceSystem()
 
 void ResourceSystem::run()
 {
-	const auto start_time{ std::chrono::high_resolution_clock::now() };
+	_MAGE_PROFILE_ZONE("resourcesystem");
 
 	bool allDone{ true };
 
@@ -195,20 +208,49 @@ void ResourceSystem::run()
 					allDone = false;
 				}
 			}
+
+			////// Handle meshes LODs //////////
+			const auto meshes_lods_list{ resource_components.getComponentsByType<std::pair<double, std::pair<std::pair<std::string, std::string>, TriangleMeshe>>>() };
+			for (auto& e : meshes_lods_list)
+			{
+				auto& meshe_descr{ e->getPurpose().second };
+				TriangleMeshe& meshe{ meshe_descr.second };
+
+				const auto& ids{ meshe_descr.first };
+
+				const std::string& file_path{ ids.second };
+				const std::string& meshe_id{ ids.first };
+
+				const auto state{ meshe.getState() };
+				if (TriangleMeshe::State::INIT == state)
+				{
+					ResourceStateControler::getInstance()->update(meshe, TriangleMeshe::State::BLOBLOADING);
+					handleSceneFile(file_path, meshe_id, meshe, nodes_list);
+				}
+
+				if (TriangleMeshe::State::BLOBLOADED > state)
+				{
+					allDone = false;
+				}
+			}
 		}
 	}
 
+	////// Handle prefetch : one texture per frame, only if runners have nothing else to do //////
+	if (!m_texturesPrefetchQueue.empty() && 0 == getNbBusyRunners())
+	{
+		const std::string filename{ m_texturesPrefetchQueue.front() };
+		m_texturesPrefetchQueue.pop();
+		m_texturesPrefetchRequested.erase(filename);
+
+		handleTexturePrefetch(filename);
+	}
+
 	for (int i = 0; i < nbRunners; i++)
 	{
 		m_runner[i].get()->dispatchEvents();
 	}
 
-	const auto end_time{ std::chrono::high_resolution_clock::now() };
-	const auto duration{ std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time) };
-	const auto dataCloud{ mage::rendering::Datacloud::getInstance() };
-	dataCloud->updateDataValue<std::string>("mage.timings.resourcesystem", std::to_string(duration.count()) + " ms");
-
-	
 	if (m_requested && allDone)
 	{
 		m_requested = false;
@@ -241,7 +283,33 @@ size_t ResourceSystem::getNbBusyRunners() const
 	return count;
 }
 
+bool ResourceSystem::hasPendingWork() const
+{
+	if (m_requested || !m_texturesPrefetchQueue.empty())
+	{
+		return true;
+	}
+
+	for (int i = 0; i < nbRunners; i++)
+	{
+		if (m_runner[i].get()->hasPendingTasks())
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
 void ResourceSystem::request()
 {
 	m_requested = true;
+}
+
+void ResourceSystem::prefetchTexture(const std::string& p_filename)
+{
+	if (!m_texturesPrefetchRequested.count(p_filename))
+	{
+		m_texturesPrefetchRequested.insert(p_filename);
+		m_texturesPrefetchQueue.push(p_filename);
+	}
 }
\ No newline at end of file
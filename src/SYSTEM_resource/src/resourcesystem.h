@@ -27,6 +27,8 @@
 
 #include <mutex>
 #include <map>
+#include <queue>
+#include <unordered_set>
 #include <unordered_map>
 #include <string>
 #include <vector>
@@ -71,6 +73,7 @@ namespace mage
 
         RESOURCE_TEXTURE_LOAD_BEGIN,
         RESOURCE_TEXTURE_LOAD_SUCCESS,
+        RESOURCE_TEXTURE_PREFETCH_ERROR, // non fatal : texture will be loaded (and checked) again by a regular request
 
         RESOURCE_MESHE_LOAD_BEGIN,
         RESOURCE_MESHE_LOAD_SUCCESS
@@ -151,8 +154,17 @@ namespace mage
 
         size_t getNbBusyRunners() const;
 
+        // loading requested, running or waiting in runners
+        bool hasPendingWork() const;
+
         void request();
 
+        // low priority blob loading, processed only when runners are idle
+        void prefetchTexture(const std::string& p_filename);
+
+        // texture blob already in cache (loaded by a request or a prefetch)
+        bool isTextureLoaded(const std::string& p_filename);
+
     private:
         mage::core::logger::Sink                                                        m_localLogger;
         mage::core::logger::Sink                                                        m_localLoggerRunner;
@@ -164,6 +176,7 @@ namespace mage
         std::mutex                                                                      m_jsonparser_mutex;
 
         static constexpr unsigned int                                                   nbRunners{ 1 };
+        static constexpr const char*                                                    texturePrefetchAction{ "prefetch_texture" };
 
         std::vector<std::unique_ptr<mage::core::Runner>>                                m_runner;
         int                                                                             m_runnerIndex{ 0 };
@@ -179,9 +192,13 @@ namespace mage
         std::unordered_map<std::string, ShaderCacheEntry>                               m_shadersCache;
 
         bool                                                                            m_requested{ false };
+
+        std::queue<std::string>                                                         m_texturesPrefetchQueue;
+        std::unordered_set<std::string>                                                 m_texturesPrefetchRequested; // names waiting in m_texturesPrefetchQueue
        
         void handleShader(const std::string& p_filename, Shader& p_shaderInfos);
         void handleTexture(const std::string& p_filename, Texture& p_textureInfos );
+        void handleTexturePrefetch(const std::string& p_filename);
         
         void handleSceneFile(const std::string& p_filename,
                             const std::string& p_mesheid, TriangleMeshe& p_mesheInfos,
@@ -223,7 +223,7 @@ void ResourceSystem::handleShader(const std::string& p_filename, Shader& p_shade
 							shader_md5_content.save(shaderMD5.c_str(), shaderMD5.length());
 
 							m_shadersCache_mutex.lock();
-							m_shadersCache.at(resourceUID).shader_code.fill(shaderBytes.get(), shaderBytesLength);
+							m_shadersCache.at(resourceUID).shader_code = core::Buffer<char>::adopt(std::move(shaderBytes), shaderBytesLength);
 							m_shadersCache_mutex.unlock();
 
 							p_shaderInfos.setCode(m_shadersCache.at(resourceUID).shader_code.getData(), m_shadersCache.at(resourceUID).shader_code.getDataSize());
@@ -259,7 +259,7 @@ void ResourceSystem::handleShader(const std::string& p_filename, Shader& p_shade
 						cache_code_content.load();
 
 						m_shadersCache_mutex.lock();
-						m_shadersCache.at(resourceUID).shader_code.fill(cache_code_content.getData(), cache_code_content.getDataSize());
+						m_shadersCache.at(resourceUID).shader_code = cache_code_content.getBuffer();
 						m_shadersCache_mutex.unlock();
 
 						p_shaderInfos.setCode(m_shadersCache.at(resourceUID).shader_code.getData(), m_shadersCache.at(resourceUID).shader_code.getDataSize());
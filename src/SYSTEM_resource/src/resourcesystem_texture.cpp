@@ -46,14 +46,19 @@ void ResourceSystem::handleTexture(const std::string& p_filename, Texture& p_tex
 
 	const auto resourceUID{ p_textureInfos.getResourceUID() };
 
-	if (!m_texturesBlobCache.count(resourceUID))
+	// entry can be erased by a failed prefetch task : check and create under lock
+	m_texturesBlobCache_mutex.lock();
+	const bool cached{ m_texturesBlobCache.count(resourceUID) > 0 };
+	if (!cached)
 	{
-		_MAGE_DEBUG(m_localLogger, std::string("launching task because texture not found in resource cache : ") + p_textureInfos.getSourceID() + std::string(" ") + p_textureInfos.getResourceUID());
-
-		m_texturesBlobCache_mutex.lock();
 		m_texturesBlobCache[resourceUID]; // to create entry
 		m_texturesBlobCache[resourceUID].state = TextureCacheEntry::State::BLOBLOADING;
-		m_texturesBlobCache_mutex.unlock();
+	}
+	m_texturesBlobCache_mutex.unlock();
+
+	if (!cached)
+	{
+		_MAGE_DEBUG(m_localLogger, std::string("launching task because texture not found in resource cache : ") + p_textureInfos.getSourceID() + std::string(" ") + p_textureInfos.getResourceUID());
 
 		const auto task{ new mage::core::SimpleAsyncTask<>(textureAction, p_filename,
 			[&,
@@ -82,7 +87,7 @@ void ResourceSystem::handleTexture(const std::string& p_filename, Texture& p_tex
 					texture_content.load();
 
 					m_texturesBlobCache_mutex.lock();
-					m_texturesBlobCache.at(resourceUID).texture_content.fill(texture_content.getData(), texture_content.getDataSize());
+					m_texturesBlobCache.at(resourceUID).texture_content = texture_content.getBuffer();
 					m_texturesBlobCache_mutex.unlock();
 
 					p_textureInfos.setFileContent(m_texturesBlobCache.at(resourceUID).texture_content.getData(), m_texturesBlobCache.at(resourceUID).texture_content.getDataSize());
@@ -132,7 +137,9 @@ void ResourceSystem::handleTexture(const std::string& p_filename, Texture& p_tex
 		_MAGE_DEBUG(m_localLogger, std::string("texture found in resource cache : ") + p_textureInfos.getSourceID() + std::string(" ") + p_textureInfos.getResourceUID());
 
 		m_texturesBlobCache_mutex.lock();
-		const auto texture_state{ m_texturesBlobCache.at(resourceUID).state };
+		const auto it{ m_texturesBlobCache.find(resourceUID) };
+		// prefetch failed meanwhile : entry created again on next call
+		const auto texture_state{ it != m_texturesBlobCache.end() ? it->second.state : TextureCacheEntry::State::BLOBLOADING };
 		m_texturesBlobCache_mutex.unlock();
 
 		if (TextureCacheEntry::State::BLOBLOADED == texture_state)
@@ -141,4 +148,90 @@ void ResourceSystem::handleTexture(const std::string& p_filename, Texture& p_tex
 			ResourceStateControler::getInstance()->update(p_textureInfos, Texture::State::BLOBLOADED);
 		}
 	}
-}
\ No newline at end of file
+}
+bool ResourceSystem::isTextureLoaded(const std::string& p_filename)
+{
+	Texture texture;
+	texture.setSource(Texture::Source::CONTENT_FROM_FILE, p_filename);
+
+	m_texturesBlobCache_mutex.lock();
+	const auto it{ m_texturesBlobCache.find(texture.getResourceUID()) };
+	const bool loaded{ it != m_texturesBlobCache.end() && TextureCacheEntry::State::BLOBLOADED == it->second.state };
+	m_texturesBlobCache_mutex.unlock();
+
+	return loaded;
+}
+
+void ResourceSystem::handleTexturePrefetch(const std::string& p_filename)
+{
+	const std::string textureAction{ texturePrefetchAction };
+
+	// compute resource uid as handleTexture() would do, so that next regular request hit the cache
+	Texture texture;
+	texture.setSource(Texture::Source::CONTENT_FROM_FILE, p_filename);
+
+	const auto resourceUID{ texture.getResourceUID() };
+
+	m_texturesBlobCache_mutex.lock();
+	const bool already_cached{ m_texturesBlobCache.count(resourceUID) > 0 };
+	if (!already_cached)
+	{
+		m_texturesBlobCache[resourceUID]; // to create entry
+		m_texturesBlobCache[resourceUID].state = TextureCacheEntry::State::BLOBLOADING;
+	}
+	m_texturesBlobCache_mutex.unlock();
+
+	if (already_cached)
+	{
+		return;
+	}
+
+	_MAGE_DEBUG(m_localLogger, std::string("launching prefetch task for texture : ") + p_filename + std::string(" ") + resourceUID);
+
+	const auto task{ new mage::core::SimpleAsyncTask<>(textureAction, p_filename,
+		[&,
+			textureAction = textureAction,
+			currentIndex = m_runnerIndex,
+			filename = p_filename,
+			resourceUID = resourceUID
+		]()
+		{
+			// build full path
+			const auto texture_path{ m_texturesBasePath + "/" + filename };
+
+			try
+			{
+				mage::core::FileContent<unsigned char> texture_content(texture_path);
+				texture_content.load();
+
+				m_texturesBlobCache_mutex.lock();
+				m_texturesBlobCache.at(resourceUID).texture_content = texture_content.getBuffer();
+				m_texturesBlobCache.at(resourceUID).state = TextureCacheEntry::State::BLOBLOADED;
+				m_texturesBlobCache_mutex.unlock();
+
+				_MAGE_DEBUG(m_localLoggerRunner, std::string("task has prefetched texture ") + filename + ", resource uid = " + resourceUID);
+			}
+			catch (const std::exception& e)
+			{
+				_MAGE_WARN(m_localLoggerRunner, std::string("failed to prefetch ") + texture_path + " : reason = " + e.what());
+
+				// forget entry : a regular request for this texture loads it again
+				m_texturesBlobCache_mutex.lock();
+				m_texturesBlobCache.erase(resourceUID);
+				m_texturesBlobCache_mutex.unlock();
+
+				// non fatal, see ResourceSystem ctor runners callback
+				const Runner::TaskReport report{ RunnerEvent::TASK_ERROR, filename, textureAction };
+				m_runner[currentIndex].get()->m_mailbox_out.push(report);
+			}
+		}
+	) };
+
+	m_runner[m_runnerIndex].get()->m_mailbox_in.push(task);
+
+	m_runnerIndex++;
+	if (m_runnerIndex == nbRunners)
+	{
+		m_runnerIndex = 0;
+	}
+}
@@ -59,7 +59,7 @@ namespace mage
         struct VectorArrayArgument
         {
             int                                     start_shader_register{ -1 };
-            std::vector<core::maths::Real4Vector>   array;
+            std::vector<core::maths::Float4Vector>  array; // float4 registers, ready for upload as is
         };
 
         Shader() = delete;
@@ -33,7 +33,9 @@
 #include <json_struct/json_struct.h>
 
 #include "scenestreamersystem.h"
+#include "profiler.h"
 #include "renderingqueuesystem.h"
+#include "renderingqueue.h"
 
 
 
@@ -62,31 +64,17 @@ SceneStreamerSystem::SceneStreamerSystem(Entitygraph& p_entitygraph) : System(p_
 m_localLogger("SceneStreamerSystem", mage::core::logger::Configuration::getInstance())
 {
     const auto dataCloud{ mage::rendering::Datacloud::getInstance() };
-    dataCloud->registerData<std::string>("mage.timings.scenestreamersystem");
-    dataCloud->registerData<std::string>("mage.timings.scenestreamersystem.3");
-    dataCloud->registerData<std::string>("mage.timings.scenestreamersystem.4");
+    dataCloud->registerData<long>("mage.scenestreamersystem.prefetch_hits");
+    dataCloud->registerData<long>("mage.scenestreamersystem.prefetch_misses");
 
 
-    // Register callback for entitygraph events
-    m_entitygraph.registerSubscriber([this](core::EntitygraphEvents p_event, const core::Entity& p_entity)
-        {
-            switch (p_event)
-            {
-                case core::EntitygraphEvents::ENTITYGRAPHNODE_ADDED:
-                {
-                    // push it to the queue to be processed later - in next run() call, because entity was just created so no any aspects added yet at this moment
-
-                    m_newly_added_entities.push(const_cast<core::Entity*>(&p_entity));
-                }
-                break;
+    // entitygraph events drained at each run() start
+    m_entitygraph_events = m_entitygraph.getEventBus().registerConsumer();
+}
 
-                case core::EntitygraphEvents::ENTITYGRAPHNODE_REMOVED:
-                {
-                    // TODO !!!
-                }
-                break;
-            }
-        });
+SceneStreamerSystem::~SceneStreamerSystem()
+{
+    m_entitygraph.getEventBus().unregisterConsumer(m_entitygraph_events);
 }
 
 void SceneStreamerSystem::enableSystem(bool p_enabled)
@@ -105,190 +93,30 @@ void SceneStreamerSystem::configure(const Configuration& p_config)
     {
         m_configuration = p_config;
         m_configured = true;
+
+        init_XTree();
     }
 }
 
-void SceneStreamerSystem::init_XTree(RendergraphPartData& p_rgpd)
+void SceneStreamerSystem::init_XTree()
 {
     if (!m_configured)
     {
         _EXCEPTION("Not configured");
     }
 
+    // nodes are created only when entities are placed in them
+    const double half_size{ m_configuration.scene_size / 2 };
+
     if (XtreeType::QUADTREE == m_configuration.xtree_type)
     {
-        const SceneQuadTreeNode root_node{ m_configuration.scene_size, Real2Vector(0, 0),
-                                            Real2Vector(-m_configuration.scene_size / 2, -m_configuration.scene_size / 2) + Real2Vector(m_configuration.center[0], m_configuration.center[2]),
-                                            Real2Vector(m_configuration.scene_size / 2, m_configuration.scene_size / 2) + Real2Vector(m_configuration.center[0], m_configuration.center[2])};
-
-        p_rgpd.quadtree_root = std::make_unique<core::QuadTreeNode<SceneQuadTreeNode>>(root_node);
-
-        const std::function<void(QuadTreeNode<SceneQuadTreeNode>*, int)> expand
-        {
-            [&](QuadTreeNode<SceneQuadTreeNode>* p_current_node, int p_max_depth)
-            {
-                if (p_max_depth == p_current_node->getDepth())
-                {
-                    return;
-                }
-
-                p_current_node->split();
-
-                const auto curr_node_pos{ p_current_node->getData().local_position };
-
-                for (int i = 0; i < mage::core::QuadTreeNode<SceneQuadTreeNode>::ChildCount; i++)
-                {
-                    auto child { p_current_node->getChild(i) };
-
-                    SceneQuadTreeNode childNodeContent;
-                    childNodeContent.side_length = p_current_node->getData().side_length / 2;
-
-                    switch (i)
-                    {
-                        case QuadTreeNode<SceneQuadTreeNode>::L0_UP_LEFT_INDEX:
-
-                            childNodeContent.local_position[0] = curr_node_pos[0] - childNodeContent.side_length / 2;
-                            childNodeContent.local_position[1] = curr_node_pos[1] - childNodeContent.side_length / 2;
-                            break;
-
-                        case QuadTreeNode<SceneQuadTreeNode>::L0_UP_RIGHT_INDEX:
-
-                            childNodeContent.local_position[0] = curr_node_pos[0] + childNodeContent.side_length / 2;
-                            childNodeContent.local_position[1] = curr_node_pos[1] - childNodeContent.side_length / 2;
-                            break;
-
-                        case QuadTreeNode<SceneQuadTreeNode>::L0_DOWN_RIGHT_INDEX:
-
-                            childNodeContent.local_position[0] = curr_node_pos[0] + childNodeContent.side_length / 2;
-                            childNodeContent.local_position[1] = curr_node_pos[1] + childNodeContent.side_length / 2;
-                            break;
-
-                        case QuadTreeNode<SceneQuadTreeNode>::L0_DOWN_LEFT_INDEX:
-
-                            childNodeContent.local_position[0] = curr_node_pos[0] - childNodeContent.side_length / 2;
-                            childNodeContent.local_position[1] = curr_node_pos[1] + childNodeContent.side_length / 2;
-                            break;
-                    }
-
-                    childNodeContent.xz_min[0] = childNodeContent.local_position[0] - childNodeContent.side_length / 2 + m_configuration.center[0];
-                    childNodeContent.xz_min[1] = childNodeContent.local_position[1] - childNodeContent.side_length / 2 + m_configuration.center[2];
-
-                    childNodeContent.xz_max[0] = childNodeContent.local_position[0] + childNodeContent.side_length / 2 + m_configuration.center[0];
-                    childNodeContent.xz_max[1] = childNodeContent.local_position[1] + childNodeContent.side_length / 2 + m_configuration.center[2];
-
-
-                    child->setData(childNodeContent);
-
-                    expand(child, p_max_depth);
-                }
-            }
-        };
-
-        expand(p_rgpd.quadtree_root.get(), m_configuration.xtree_max_depth);
+        m_quadtree.configure({ m_configuration.center[0] - half_size, m_configuration.center[2] - half_size },
+                                    m_configuration.scene_size, m_configuration.xtree_max_depth);
     }
     else // XtreeType::OCTREE
     {
-        const SceneOctreeNode root_node{ m_configuration.scene_size, Real3Vector(0, 0, 0),
-                                            Real3Vector(-m_configuration.scene_size / 2, -m_configuration.scene_size / 2, -m_configuration.scene_size / 2) + Real3Vector(m_configuration.center[0], m_configuration.center[1], m_configuration.center[2]),
-                                            Real3Vector(m_configuration.scene_size / 2, m_configuration.scene_size / 2, m_configuration.scene_size / 2) + Real3Vector(m_configuration.center[0], m_configuration.center[1], m_configuration.center[2]) };
-
-        p_rgpd.octree_root = std::make_unique<core::OctreeNode<SceneOctreeNode>>(root_node);
-
-        const std::function<void(OctreeNode<SceneOctreeNode>*, int)> expand
-        {
-            [&](OctreeNode<SceneOctreeNode>* p_current_node, int p_max_depth)
-            {
-                if (p_max_depth == p_current_node->getDepth())
-                {
-                    return;
-                }
-
-                p_current_node->split();
-
-                const auto curr_node_pos{ p_current_node->getData().local_position };
-
-                for (int i = 0; i < mage::core::OctreeNode<SceneOctreeNode>::ChildCount; i++)
-                {
-                    auto child { p_current_node->getChild(i) };
-
-                    SceneOctreeNode childNodeContent;
-                    childNodeContent.side_length = p_current_node->getData().side_length / 2;
-
-                    switch (i)
-                    {
-                        case OctreeNode<SceneOctreeNode>::L0_UP_LEFT_INDEX:
-
-                            childNodeContent.local_position[0] = curr_node_pos[0] - childNodeContent.side_length / 2;
-                            childNodeContent.local_position[1] = curr_node_pos[1] - childNodeContent.side_length / 2;
-                            childNodeContent.local_position[2] = curr_node_pos[2] - childNodeContent.side_length / 2;
-                            break;
-
-                        case OctreeNode<SceneOctreeNode>::L0_UP_RIGHT_INDEX:
-
-                            childNodeContent.local_position[0] = curr_node_pos[0] + childNodeContent.side_length / 2;
-                            childNodeContent.local_position[1] = curr_node_pos[1] - childNodeContent.side_length / 2;
-                            childNodeContent.local_position[2] = curr_node_pos[2] - childNodeContent.side_length / 2;
-                            break;
-
-                        case OctreeNode<SceneOctreeNode>::L0_DOWN_RIGHT_INDEX:
-
-                            childNodeContent.local_position[0] = curr_node_pos[0] + childNodeContent.side_length / 2;
-                            childNodeContent.local_position[1] = curr_node_pos[1] - childNodeContent.side_length / 2;
-                            childNodeContent.local_position[2] = curr_node_pos[2] + childNodeContent.side_length / 2;
-                            break;
-
-                        case OctreeNode<SceneOctreeNode>::L0_DOWN_LEFT_INDEX:
-
-                            childNodeContent.local_position[0] = curr_node_pos[0] - childNodeContent.side_length / 2;
-                            childNodeContent.local_position[1] = curr_node_pos[1] - childNodeContent.side_length / 2;
-                            childNodeContent.local_position[2] = curr_node_pos[2] + childNodeContent.side_length / 2;
-                            break;
-
-                        case OctreeNode<SceneOctreeNode>::L1_UP_LEFT_INDEX:
-
-                            childNodeContent.local_position[0] = curr_node_pos[0] - childNodeContent.side_length / 2;
-                            childNodeContent.local_position[1] = curr_node_pos[1] + childNodeContent.side_length / 2;
-                            childNodeContent.local_position[2] = curr_node_pos[2] - childNodeContent.side_length / 2;
-                            break;
-
-                        case OctreeNode<SceneOctreeNode>::L1_UP_RIGHT_INDEX:
-
-                            childNodeContent.local_position[0] = curr_node_pos[0] + childNodeContent.side_length / 2;
-                            childNodeContent.local_position[1] = curr_node_pos[1] + childNodeContent.side_length / 2;
-                            childNodeContent.local_position[2] = curr_node_pos[2] - childNodeContent.side_length / 2;
-                            break;
-
-                        case OctreeNode<SceneOctreeNode>::L1_DOWN_RIGHT_INDEX:
-
-                            childNodeContent.local_position[0] = curr_node_pos[0] + childNodeContent.side_length / 2;
-                            childNodeContent.local_position[1] = curr_node_pos[1] + childNodeContent.side_length / 2;
-                            childNodeContent.local_position[2] = curr_node_pos[2] + childNodeContent.side_length / 2;
-                            break;
-
-                        case OctreeNode<SceneOctreeNode>::L1_DOWN_LEFT_INDEX:
-
-                            childNodeContent.local_position[0] = curr_node_pos[0] - childNodeContent.side_length / 2;
-                            childNodeContent.local_position[1] = curr_node_pos[1] + childNodeContent.side_length / 2;
-                            childNodeContent.local_position[2] = curr_node_pos[2] + childNodeContent.side_length / 2;
-                            break;
-                    }
-
-                    childNodeContent.xyz_min[0] = childNodeContent.local_position[0] - childNodeContent.side_length / 2 + m_configuration.center[0];
-                    childNodeContent.xyz_min[1] = childNodeContent.local_position[1] - childNodeContent.side_length / 2 + m_configuration.center[1];
-                    childNodeContent.xyz_min[2] = childNodeContent.local_position[2] - childNodeContent.side_length / 2 + m_configuration.center[2];
-
-                    childNodeContent.xyz_max[0] = childNodeContent.local_position[0] + childNodeContent.side_length / 2 + m_configuration.center[0];
-                    childNodeContent.xyz_max[1] = childNodeContent.local_position[1] + childNodeContent.side_length / 2 + m_configuration.center[1];
-                    childNodeContent.xyz_max[2] = childNodeContent.local_position[2] + childNodeContent.side_length / 2 + m_configuration.center[2];
-                
-                    child->setData(childNodeContent);
-
-                    expand(child, p_max_depth);
-                }
-            }
-        };
-
-        expand(p_rgpd.octree_root.get(), m_configuration.xtree_max_depth);
+        m_octree.configure({ m_configuration.center[0] - half_size, m_configuration.center[1] - half_size, m_configuration.center[2] - half_size },
+                                    m_configuration.scene_size, m_configuration.xtree_max_depth);
     }
 }
 
@@ -324,9 +152,9 @@ bool SceneStreamerSystem::compute_entity(core::Entity* p_entity, const core::Com
     if (mage::helpers::checkTag(p_entity, "#alwaysRendered"))
     {
         // render it directly, and no need to add it in rgpd xtree_entities list
-        if (!m_entity_renderings.at(p_entity->getId()).m_rendered)
+        if (!m_entity_renderings.at(p_entity->getHandle()).m_rendered)
         {
-            m_entity_renderings.at(p_entity->getId()).m_request_rendering = true;
+            m_entity_renderings.at(p_entity->getHandle()).m_request_rendering = true;
         }
 
         computed = true;
@@ -337,68 +165,77 @@ bool SceneStreamerSystem::compute_entity(core::Entity* p_entity, const core::Com
         {
             const std::unordered_set<std::string> scene_entity_rg_parts{ m_scene_entities_rg_parts.at(p_entity->getId()) };
 
-            for (auto& rgpd : m_rendergraphpart_data)
+            // viewgroups in which this entity can be rendered
+            std::unordered_set<std::string> entity_viewgroups;
+
+            for (const auto& rgpd : m_rendergraphpart_data)
             {
                 for (const std::string& rendering_queue_id : rgpd.second.viewgroup.queue_entities)
                 {
                     if (scene_entity_rg_parts.count(rendering_queue_id))
                     {
-                        // can add this entity in this viewgroup/rgpd xtree
-                        if (!rgpd.second.xtree_moving_entities_to_monitor.count(p_entity->getId()))
+                        entity_viewgroups.insert(rgpd.first);
+                        break;
+                    }
+                }
+            }
+
+            // placed once in shared xtree, whatever the number of viewgroups
+            if (entity_viewgroups.size() > 0 && !m_xtree_moving_entities_to_monitor.count(p_entity->getId()))
+            {
+                m_xtree_entities_viewgroups[p_entity] = entity_viewgroups;
+
+                XTreeEntity xtreeEnt;
+                xtreeEnt.entity = p_entity;
+
+                const bool frozen_tag{ mage::helpers::checkTag(p_entity, "#frozen") };
+                const bool static_tag{ mage::helpers::checkTag(p_entity, "#static") };
+
+                // "#static" : no moving on scene, always stay at x,y,z coords, but can potentially be transforemed at each frame (ex: rotation on y axis)
+                if (static_tag || frozen_tag)
+                {
+                    // place it on xtree once for all
+                    const auto& resources_aspect{ p_entity->aspectAccess(resourcesAspect::id) };
+
+                    const auto meshes_list{ resources_aspect.getComponentsByType<std::pair<std::pair<std::string, std::string>, TriangleMeshe>>() };
+                    if (meshes_list.size() > 0)
+                    {
+                        auto& meshe_descr{ meshes_list.at(0)->getPurpose() };
+                        TriangleMeshe& meshe{ meshe_descr.second };
+
+                        if (TriangleMeshe::State::RENDERERLOADED == meshe.getState())
                         {
-                            XTreeEntity xtreeEnt;
-                            xtreeEnt.entity = p_entity;
+                            const double meshe_size{ meshe.getSize() };
 
-                            const bool frozen_tag{ mage::helpers::checkTag(p_entity, "#frozen") };
-                            const bool static_tag{ mage::helpers::checkTag(p_entity, "#static") };
+                            const auto& world_aspect{ p_entity->aspectAccess(worldAspect::id) };
 
-                            // "#static" : no moving on scene, always stay at x,y,z coords, but can potentially be transforemed at each frame (ex: rotation on y axis)
-                            if (static_tag || frozen_tag)
+                            const auto& entity_worldposition_list{ world_aspect.getComponentsByType<transform::WorldPosition>() };
+                            auto& entity_worldposition{ entity_worldposition_list.at(0)->getPurpose() };
+                            const auto global_pos = entity_worldposition.global_pos;
+
+
+                            if (XtreeType::QUADTREE == m_configuration.xtree_type)
                             {
-                                // place it on xtree once for all
-                                const auto& resources_aspect{ p_entity->aspectAccess(resourcesAspect::id) };
-
-                                const auto meshes_list{ resources_aspect.getComponentsByType<std::pair<std::pair<std::string, std::string>, TriangleMeshe>>() };
-                                if (meshes_list.size() > 0)
-                                {
-                                    auto& meshe_descr{ meshes_list.at(0)->getPurpose() };
-                                    TriangleMeshe& meshe{ meshe_descr.second };
-
-                                    if (TriangleMeshe::State::RENDERERLOADED == meshe.getState())
-                                    {
-                                        const double meshe_size{ meshe.getSize() };
-
-                                        const auto& world_aspect{ p_entity->aspectAccess(worldAspect::id) };
-
-                                        const auto& entity_worldposition_list{ world_aspect.getComponentsByType<transform::WorldPosition>() };
-                                        auto& entity_worldposition{ entity_worldposition_list.at(0)->getPurpose() };
-                                        const auto global_pos = entity_worldposition.global_pos;
-
-
-                                        if (XtreeType::QUADTREE == m_configuration.xtree_type)
-                                        {
-                                            m_place_obj_on_quadtree_leaf(rgpd.second.quadtree_root.get(), meshe_size, global_pos, p_entity, xtreeEnt);
-                                        }
-                                        else // XtreeType::OCTREE
-                                        {
-                                            m_place_obj_on_octree_leaf(rgpd.second.octree_root.get(), meshe_size, global_pos, p_entity, xtreeEnt);
-                                        }
-                                        computed = true;
-                                    }
-                                    // else (not RENDERERLOADED) : computed stay FALSE !!! -> continue watching
-                                }
-                                else
-                                {
-                                    computed = true;
-                                }
+                                place_obj_on_xtree(m_quadtree, meshe_size, global_pos, p_entity, xtreeEnt);
                             }
-                            else
+                            else // XtreeType::OCTREE
                             {
-                                rgpd.second.xtree_moving_entities_to_monitor[p_entity->getId()] = xtreeEnt;
-                                computed = true;
+                                place_obj_on_xtree(m_octree, meshe_size, global_pos, p_entity, xtreeEnt);
                             }
+                            m_xtree_static_entities[p_entity->getId()] = xtreeEnt;
+                            computed = true;
                         }
+                        // else (not RENDERERLOADED) : computed stay FALSE !!! -> continue watching
                     }
+                    else
+                    {
+                        computed = true;
+                    }
+                }
+                else
+                {
+                    m_xtree_moving_entities_to_monitor[p_entity->getId()] = xtreeEnt;
+                    computed = true;
                 }
             }
         }
@@ -411,193 +248,104 @@ void SceneStreamerSystem::run()
 {
     const auto dataCloud{ mage::rendering::Datacloud::getInstance() };
 
-    const auto start_time{ std::chrono::high_resolution_clock::now() };
+    _MAGE_PROFILE_ZONE("scenestreamersystem");
+
+    // committed entities, or world aspect made after commit : each entity is examined once
+    // removed entities : purged from tables and xtree before anything else reads them
+    m_entitygraph.getEventBus().drain(m_entitygraph_events,
+        property::EventBus<core::EntitygraphEvent>::typeBit(core::EntitygraphEvents::ENTITYGRAPHNODE_COMMITTED, core::EntitygraphEvents::ENTITYGRAPHNODE_ASPECT_ADDED, core::EntitygraphEvents::ENTITYGRAPHNODE_REMOVED),
+        [this](const core::EntitygraphEvent& p_event)
+        {
+            if (core::EntitygraphEvents::ENTITYGRAPHNODE_REMOVED == p_event.type)
+            {
+                forget_entity(p_event.entity, p_event.handle);
+            }
+            else if (core::EntitygraphEvents::ENTITYGRAPHNODE_COMMITTED == p_event.type || core::worldAspect::id == p_event.aspect)
+            {
+                m_newly_added_entities.push(p_event.handle);
+            }
+        });
 
     if (!m_enabled)
     {
         return;
     }
 
+    // entities waiting for their meshe : checked apart, so that they don't hold back following entities
+    for (size_t i = 0; i < m_entities_waiting_meshe.size();)
+    {
+        // nullptr if entity removed meanwhile
+        core::Entity* entity{ m_entitygraph.getEntity(m_entities_waiting_meshe[i]) };
+
+        if (nullptr == entity || compute_entity(entity, entity->aspectAccess(worldAspect::id)))
+        {
+            m_entities_waiting_meshe[i] = m_entities_waiting_meshe.back();
+            m_entities_waiting_meshe.pop_back();
+        }
+        else
+        {
+            i++;
+        }
+    }
+
     while (!m_newly_added_entities.empty())
     {
-        core::Entity* newly_added_entity{ m_newly_added_entities.front() };
-        //m_newly_added_entities.pop();
-        
-        if (newly_added_entity->hasAspect(core::worldAspect::id))
+        const auto handle{ m_newly_added_entities.front() };
+        m_newly_added_entities.pop();
+
+        // nullptr if entity committed then removed before this run
+        core::Entity* newly_added_entity{ m_entitygraph.getEntity(handle) };
+
+        if (newly_added_entity && newly_added_entity->hasAspect(core::worldAspect::id))
         {
             const auto& world_aspect{ newly_added_entity->aspectAccess(worldAspect::id) };
 
-            bool computed = compute_entity(newly_added_entity, world_aspect);
-            if (computed)
+            if (!compute_entity(newly_added_entity, world_aspect))
             {
-                m_newly_added_entities.pop();
+                m_entities_waiting_meshe.push_back(handle);
             }
         }
-        else
-        {
-            m_newly_added_entities.pop();
-        }        
     }
     
     /////////////////////////////////////////////////////////
-    // XTrees updating
+    // XTree updating
     // 
-    for (auto& rgpd : m_rendergraphpart_data)
+    if (XtreeType::QUADTREE == m_configuration.xtree_type)
     {
-        auto& rgpd_data = rgpd.second;
-
-        if (XtreeType::QUADTREE == m_configuration.xtree_type)
-        {
-            /////////////////////////////////////////////////////////////////////////////////
-            // place cam in appropriate xtree leaf : utility lambda
-            const std::function<void(core::QuadTreeNode<SceneQuadTreeNode>*, const core::maths::Matrix&, core::Entity*, SceneStreamerSystem::XTreeEntity&)> place_cam_on_leaf
-            {
-                [&](core::QuadTreeNode<SceneQuadTreeNode>* p_current_node, const core::maths::Matrix& p_global_pos, core::Entity* p_entity, SceneStreamerSystem::XTreeEntity& p_xtreeEntity)
-                {
-                    if (p_current_node->isLeaf())
-                    {
-                        p_current_node->dataAccess().entities.insert(p_entity);
-                        p_xtreeEntity.quadtree_node = p_current_node;
-                    }
-                    else
-                    {
-                        for (int i = 0; i < core::QuadTreeNode<SceneQuadTreeNode>::ChildCount; i++)
-                        {
-                            auto child { p_current_node->getChild(i) };
-
-                            if (SceneStreamerSystem::is_inside_quadtreenode(child->getData(), p_global_pos))
-                            {
-                                place_cam_on_leaf(child, p_global_pos, p_entity, p_xtreeEntity);
-                            }
-                        }
-                    }
-                }
-            };
-            /////////////////////////////////////////////////////////////////////////////////
-
-
-            const std::function<bool(const SceneStreamerSystem::XTreeEntity&)> has_node
-            {
-                [&](const SceneStreamerSystem::XTreeEntity& p_xe) -> bool
-                {
-                    return (p_xe.quadtree_node != nullptr);
-                } 
-            };
-
-            /////////////////////////////////////////////////////////////////////////////////
-
-            const std::function<bool(SceneStreamerSystem::XTreeEntity&, const core::maths::Matrix&)> is_inside
-            {
-                [&](SceneStreamerSystem::XTreeEntity& p_xe, const core::maths::Matrix& p_global_pos) -> bool
-                {
-                    return is_inside_quadtreenode(p_xe.quadtree_node->getData(), p_global_pos);
-                }
-            };
-
-            update_XTree<SceneQuadTreeNode, core::QuadTreeNode<SceneQuadTreeNode>>(rgpd_data.quadtree_root.get(), rgpd_data.xtree_moving_entities_to_monitor, place_cam_on_leaf, m_place_obj_on_quadtree_leaf, has_node, is_inside);
-        }
-        else // XtreeType::OCTREE
-        {           
-            /////////////////////////////////////////////////////////////////////////////////
-            // place cam in appropriate xtree leaf : utility lambda
-            const std::function<void(core::OctreeNode<SceneOctreeNode>*, const core::maths::Matrix&, core::Entity*, SceneStreamerSystem::XTreeEntity&)> place_cam_on_leaf
-            {
-                [&](core::OctreeNode<SceneOctreeNode>* p_current_node, const core::maths::Matrix& p_global_pos, core::Entity* p_entity, SceneStreamerSystem::XTreeEntity& p_xtreeEntity)
-                {
-                    if (p_current_node->isLeaf())
-                    {
-                        p_current_node->dataAccess().entities.insert(p_entity);
-                        p_xtreeEntity.octree_node = p_current_node;
-                    }
-                    else
-                    {
-                        for (int i = 0; i < core::OctreeNode<SceneOctreeNode>::ChildCount; i++)
-                        {
-                            auto child { p_current_node->getChild(i) };
-
-                            if(SceneStreamerSystem::is_inside_octreenode(child->getData(), p_global_pos))
-                            {
-                                place_cam_on_leaf(child, p_global_pos, p_entity, p_xtreeEntity);
-                            }
-                        }
-                    }
-                }
-            };
-            /////////////////////////////////////////////////////////////////////////////////
-
-
-
-            const std::function<bool(const SceneStreamerSystem::XTreeEntity&)> has_node
-            {
-                [&](const SceneStreamerSystem::XTreeEntity& p_xe) -> bool
-                {
-                    return (p_xe.octree_node != nullptr);
-                }
-            };
-
-            /////////////////////////////////////////////////////////////////////////////////
-
-            const std::function<bool(SceneStreamerSystem::XTreeEntity&, const core::maths::Matrix&)> is_inside
-            {
-                [&](SceneStreamerSystem::XTreeEntity& p_xe, const core::maths::Matrix& p_global_pos) -> bool
-                {
-                    return is_inside_octreenode(p_xe.octree_node->getData(), p_global_pos);
-                }
-            };
-
-
-            update_XTree<SceneOctreeNode, core::OctreeNode<SceneOctreeNode>>(rgpd_data.octree_root.get(), rgpd_data.xtree_moving_entities_to_monitor, place_cam_on_leaf, m_place_obj_on_octree_leaf, has_node, is_inside);
-        }
+        update_XTree(m_quadtree, m_xtree_moving_entities_to_monitor);
+    }
+    else // XtreeType::OCTREE
+    {
+        update_XTree(m_octree, m_xtree_moving_entities_to_monitor);
     }
-
-    const auto start_time_3{ std::chrono::high_resolution_clock::now() };
 
     if (m_xtree_check_enabled)
     {
+        _MAGE_PROFILE_ZONE("scenestreamersystem.xtree_check");
+
         /////////////////////////////////////////////////////////
-        // XTree check
+        // XTree check : one neighbourood search shared by all viewgroups
         //
-        for (auto& rgpd : m_rendergraphpart_data)
+        if (XtreeType::QUADTREE == m_configuration.xtree_type)
         {
-            auto& rgpd_data = rgpd.second;
-
-            if (XtreeType::QUADTREE == m_configuration.xtree_type)
-            {
-                const std::function<core::QuadTreeNode<SceneQuadTreeNode>* (const XTreeEntity&)> get_quadtree_node_func
-                {
-                    [](const XTreeEntity& p_xe) -> core::QuadTreeNode<SceneQuadTreeNode>*
-                    {
-                        return p_xe.quadtree_node;
-                    }
-                };
-
-                check_XTree<SceneQuadTreeNode, core::QuadTreeNode<SceneQuadTreeNode>>(rgpd_data.xtree_moving_entities_to_monitor, rgpd_data.viewgroup, get_quadtree_node_func);
-            }
-            else // XtreeType::OCTREE
-            {
-                const std::function<core::OctreeNode<SceneOctreeNode>* (const XTreeEntity&)> get_octree_node_func
-                {
-                    [](const XTreeEntity& p_xe) -> core::OctreeNode<SceneOctreeNode>*
-                    {
-                        return p_xe.octree_node;
-                    }
-                };
-
-                check_XTree<SceneOctreeNode, core::OctreeNode<SceneOctreeNode>>(rgpd_data.xtree_moving_entities_to_monitor, rgpd_data.viewgroup, get_octree_node_func);
-            }
+            check_XTree(m_quadtree);
+        }
+        else // XtreeType::OCTREE
+        {
+            check_XTree(m_octree);
         }
     }
 
-    const auto end_time_3{ std::chrono::high_resolution_clock::now() };
-    const auto duration_3{ std::chrono::duration_cast<std::chrono::milliseconds>(end_time_3 - start_time_3) };
-
-    dataCloud->updateDataValue<std::string>("mage.timings.scenestreamersystem.3", std::to_string(duration_3.count()) + " ms");
+    dataCloud->updateDataValue<long>("mage.scenestreamersystem.prefetch_hits", m_prefetch_hits);
+    dataCloud->updateDataValue<long>("mage.scenestreamersystem.prefetch_misses", m_prefetch_misses);
     
     /////////////////////////////////////////////////////////
     // loop on entity rendering entries
     /////////////////////////////////////////////////////////
 
-    const auto start_time_4{ std::chrono::high_resolution_clock::now() };
+    _MAGE_PROFILE_ZONE("scenestreamersystem.queues_update");
+
+    update_lods();
 
     //VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV
     //VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV
@@ -605,15 +353,22 @@ void SceneStreamerSystem::run()
 
     for (auto& e : m_entity_renderings)
     {
+        core::Entity* entity{ m_entitygraph.getEntity(e.first) };
+        if (nullptr == entity)
+        {
+            // stale handle : entity removed from graph
+            continue;
+        }
+
         if (e.second.m_request_rendering && !e.second.m_rendered)
         {
-            register_to_queues(e.second.m_channels, m_scene_entities.at(e.first));
+            register_to_queues(e.second.m_channels, entity);
             e.second.m_rendered = true;
 
         }
         else if (!e.second.m_request_rendering && e.second.m_rendered)
         {
-            unregister_from_queues(m_scene_entities.at(e.first));
+            unregister_from_queues(entity);
             e.second.m_rendered = false;
         }
     }
@@ -622,19 +377,6 @@ void SceneStreamerSystem::run()
     //VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV
     //VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV
 
-    const auto end_time_4{ std::chrono::high_resolution_clock::now() };
-    const auto duration_4{ std::chrono::duration_cast<std::chrono::milliseconds>(end_time_4 - start_time_4) };
-
-    if (duration_4.count() > 0)
-    {
-        dataCloud->updateDataValue<std::string>("mage.timings.scenestreamersystem.4", std::to_string(duration_4.count()) + " ms");
-    }                    
-
-    
-    const auto end_time{ std::chrono::high_resolution_clock::now() };
-    const auto duration{ std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time) };
-    
-    dataCloud->updateDataValue<std::string>("mage.timings.scenestreamersystem", std::to_string(duration.count()) + " ms");
 }
 
 void SceneStreamerSystem::buildRendergraphPart(const std::string& p_jsonsource, const std::string& p_parentEntityId,
@@ -1068,19 +810,62 @@ void SceneStreamerSystem::buildScenegraphEntity(const std::string& p_jsonsource,
                     resource_aspect.addComponent< std::pair<std::pair<std::string, std::string>, TriangleMeshe>>("meshe", std::make_pair(std::make_pair(p_node.resource_aspect.meshe.meshe_id, p_node.resource_aspect.meshe.filename), TriangleMeshe()));
                 }
 
+                // meshe LODs ?
+                if (p_node.resource_aspect.lods.size() > 0)
+                {
+                    if ("" == p_node.resource_aspect.meshe.descr)
+                    {
+                        _EXCEPTION("meshe LODs declared without base meshe : " + entity_id);
+                    }
+
+                    if (0 == p_rendergraph_parts.size() || !m_entitygraph.hasNode(p_rendergraph_parts.at(0)))
+                    {
+                        _EXCEPTION("meshe LODs requires a rendergraph part : " + entity_id);
+                    }
+
+                    double previous_distance{ 0.0 };
+                    int lod_level{ 1 };
+
+                    for (const auto& lod : p_node.resource_aspect.lods)
+                    {
+                        if (lod.distance <= previous_distance)
+                        {
+                            _EXCEPTION("meshe LODs must be declared with increasing distances : " + entity_id);
+                        }
+                        previous_distance = lod.distance;
+
+                        resource_aspect.addComponent<std::pair<double, std::pair<std::pair<std::string, std::string>, TriangleMeshe>>>("meshe_lod" + std::to_string(lod_level++),
+                                                                        std::make_pair(lod.distance, std::make_pair(std::make_pair(lod.meshe_id, lod.filename), TriangleMeshe())));
+                    }
+
+                    // distance to camera is updated by WorldSystem, regarding main view of first rendergraph part queue
+                    const auto queue_entity{ m_entitygraph.node(p_rendergraph_parts.at(0)).data() };
+                    const auto& queue_rendering_aspect{ queue_entity->aspectAccess(core::renderingAspect::id) };
+
+                    rendering::Queue* queue{ &queue_rendering_aspect.getComponentsByType<rendering::Queue>().at(0)->getPurpose() };
+                    world_aspect.addComponent<std::pair<rendering::Queue*, double>>("lod_distance_to_cam", std::make_pair(queue, 0.0));
+                }
+
                 register_scene_entity(entity);
 
     
                 if (p_node.channels.configs.size() > 0) // store only entites that can be "rendered" -> those with number of channels > 0
                 {
-                    if (m_entity_renderings.count(entity_id) > 0)
+                    if (m_entity_renderings.count(entity->getHandle()) > 0)
                     {
                         _EXCEPTION("Already registered " + entity_id);
                     }
                     else
                     {
                         EntityRendering rendering_infos(p_node.channels);
-                        m_entity_renderings[entity_id] = rendering_infos;
+
+                        for (const auto& lod : p_node.resource_aspect.lods)
+                        {
+                            rendering_infos.m_lod_distances.push_back(lod.distance);
+                        }
+                        rendering_infos.m_lod_hysteresis = p_node.resource_aspect.lod_hysteresis;
+
+                        m_entity_renderings[entity->getHandle()] = rendering_infos;
                     }
                 }
             }
@@ -1112,6 +897,9 @@ void SceneStreamerSystem::register_scene_entity(mage::core::Entity* p_entity)
     {
         m_scene_entities[entity_id] = p_entity;
     }
+
+    // scene entity fully built
+    m_entitygraph.commit(entity_id);
 }
 
 void SceneStreamerSystem::buildViewgroup(const std::string& p_jsonsource, int p_renderingQueueSystemSlot, int p_resourceSystemSlot)
@@ -1144,8 +932,6 @@ void SceneStreamerSystem::buildViewgroup(const std::string& p_jsonsource, int p_
 
     m_rendergraphpart_data[vg.name].viewgroup = vg;
 
-    init_XTree(m_rendergraphpart_data.at(vg.name));
-
     m_renderingQueueSystemSlot = p_renderingQueueSystemSlot;
     m_resourceSystemSlot = p_resourceSystemSlot;
 }
@@ -1472,9 +1258,10 @@ void SceneStreamerSystem::init_values_generator_from_matrix_factory(const std::v
 
 void SceneStreamerSystem::requestEntityRendering(const std::string& p_entity_id, bool p_render_it)
 {
-    if (m_entity_renderings.count(p_entity_id))
+    const auto handle{ m_entitygraph.getHandle(p_entity_id) };
+    if (m_entity_renderings.count(handle))
     {
-        m_entity_renderings.at(p_entity_id).m_request_rendering = p_render_it;
+        m_entity_renderings.at(handle).m_request_rendering = p_render_it;
     }
     else
     {
@@ -1599,182 +1386,269 @@ void SceneStreamerSystem::register_to_queues(const json::Channels& p_channels, m
         }
     }
 
+    // link current meshe LOD, if any
+    if (m_entity_renderings.count(p_entity->getHandle()))
+    {
+        const int lod_level{ m_entity_renderings.at(p_entity->getHandle()).m_lod_level };
+        if (lod_level > 0)
+        {
+            const auto& resource_aspect{ p_entity->aspectAccess(core::resourcesAspect::id) };
+            channelsRendering.meshe_ref = &resource_aspect.getComponent<std::pair<double, std::pair<std::pair<std::string, std::string>, TriangleMeshe>>>("meshe_lod" + std::to_string(lod_level))->getPurpose().second;
+        }
+    }
+
     const auto rendering_proxies{ renderingHelper->registerToQueues(m_entitygraph, p_entity, channelsRendering) };
 
-    m_rendering_proxies[p_entity->getId()] = rendering_proxies;
+    m_rendering_proxies[p_entity->getHandle()] = rendering_proxies;
 }
 
 void SceneStreamerSystem::unregister_from_queues(mage::core::Entity* p_entity)
 {
-    const auto rendering_proxies = m_rendering_proxies.at(p_entity->getId());
+    const auto rendering_proxies = m_rendering_proxies.at(p_entity->getHandle());
 
     const auto renderingHelper{ mage::helpers::RenderingChannels::getInstance() };
     renderingHelper->unregisterFromQueues(m_entitygraph, p_entity, rendering_proxies);
 
-    m_rendering_proxies.erase(p_entity->getId());
+    m_rendering_proxies.erase(p_entity->getHandle());
 }
 
 
-bool SceneStreamerSystem::is_inside_quadtreenode(const SceneQuadTreeNode& p_qtn, const core::maths::Matrix& p_global_pos)
+void SceneStreamerSystem::forget_entity(core::Entity* p_entity, core::EntityHandle p_handle)
 {
-    bool inside{ false };
+    m_prefetched_entities.erase(p_handle);
+    m_entity_renderings.erase(p_handle);
+    m_rendering_proxies.erase(p_handle);
+    m_xtree_entities_viewgroups.erase(p_entity);
+    m_found_entities_to_render.erase(p_entity);
+
+    const auto forget_xtree_entity{ [&](std::unordered_map<std::string, XTreeEntity>& p_xtree_entities)
+    {
+        for (auto it = p_xtree_entities.begin(); it != p_xtree_entities.end(); ++it)
+        {
+            if (p_entity == it->second.entity)
+            {
+                if (XtreeType::QUADTREE == m_configuration.xtree_type)
+                {
+                    remove_from_xtree(m_quadtree, p_entity, it->second);
+                }
+                else // XtreeType::OCTREE
+                {
+                    remove_from_xtree(m_octree, p_entity, it->second);
+                }
+                p_xtree_entities.erase(it);
+                return;
+            }
+        }
+    } };
 
-    Real2Vector object_pos(p_global_pos(3, 0), p_global_pos(3, 2));
+    forget_xtree_entity(m_xtree_moving_entities_to_monitor);
+    forget_xtree_entity(m_xtree_static_entities);
 
-    if (p_qtn.xz_min.x() <= object_pos.x() && object_pos.x() < p_qtn.xz_max.x() &&
-        p_qtn.xz_min.y() <= object_pos.y() && object_pos.y() < p_qtn.xz_max.y())
+    for (auto it = m_scene_entities.begin(); it != m_scene_entities.end(); ++it)
     {
-        inside = true;
+        if (p_entity == it->second)
+        {
+            m_scene_entities.erase(it);
+            break;
+        }
     }
-    return inside;
 }
 
-bool SceneStreamerSystem::is_inside_octreenode(const SceneOctreeNode& p_otn, const core::maths::Matrix& p_global_pos)
+void SceneStreamerSystem::prefetch_entity(core::Entity* p_entity)
 {
-    bool inside{ false };
+    // meshes are loaded with entity creation, so remaining lazy resources are channels textures
+    auto resourceSystemInstance{ dynamic_cast<mage::ResourceSystem*>(SystemEngine::getInstance()->getSystem(m_resourceSystemSlot)) };
 
-    Real3Vector object_pos(p_global_pos(3, 0), p_global_pos(3, 1), p_global_pos(3, 2));
-
-    if (p_otn.xyz_min.x() <= object_pos.x() && object_pos.x() < p_otn.xyz_max.x() &&
-        p_otn.xyz_min.y() <= object_pos.y() && object_pos.y() < p_otn.xyz_max.y() &&
-        p_otn.xyz_min.z() <= object_pos.z() && object_pos.z() < p_otn.xyz_max.z())
+    const auto& channels{ m_entity_renderings.at(p_entity->getHandle()).m_channels };
+    for (const auto& config : channels.configs)
     {
-        inside = true;
+        for (const auto& texturefile : config.textures_files_list)
+        {
+            resourceSystemInstance->prefetchTexture(texturefile.filename);
+        }
     }
-    return inside;
+
+    m_prefetched_entities.insert(p_entity->getHandle());
 }
 
-void SceneStreamerSystem::dumpXTree()
+bool SceneStreamerSystem::is_prefetch_complete(core::Entity* p_entity)
 {
-    _MAGE_DEBUG(m_localLogger, ">>>>>>>>>>>>>>> XTREE DUMP BEGIN <<<<<<<<<<<<<<<<<<<<<<<<")
+    auto resourceSystemInstance{ dynamic_cast<mage::ResourceSystem*>(SystemEngine::getInstance()->getSystem(m_resourceSystemSlot)) };
 
-    for (const auto& rgpd : m_rendergraphpart_data)
+    const auto& channels{ m_entity_renderings.at(p_entity->getHandle()).m_channels };
+    for (const auto& config : channels.configs)
     {
-        _MAGE_DEBUG(m_localLogger, "for ViewGroup " + rgpd.first)
-
-        if (XtreeType::QUADTREE == m_configuration.xtree_type)
+        for (const auto& texturefile : config.textures_files_list)
         {
-            rgpd.second.quadtree_root->traverse([&](const SceneQuadTreeNode& p_data, size_t p_depth)
-                {
-                    if (0 == p_data.entities.size())
-                    {
-                        return;
-                    }
+            if (!resourceSystemInstance->isTextureLoaded(texturefile.filename))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
 
-                    std::string tab;
-                    for (size_t i = 0; i < p_depth; i++) tab = tab + " ";
+bool SceneStreamerSystem::update_camera_motion(CameraMotion& p_camera_motion, const core::maths::Matrix& p_global_pos)
+{
+    // weight of last sample in velocity smoothing
+    static constexpr double velocitySmoothing{ 0.2 };
 
-                    _MAGE_DEBUG(m_localLogger, tab + "depth = " + std::to_string(p_depth)
+    const auto now{ std::chrono::steady_clock::now() };
+    const core::maths::Real3Vector position(p_global_pos(3, 0), p_global_pos(3, 1), p_global_pos(3, 2));
 
-                        + " side_length = " + std::to_string(p_data.side_length)
-                        + " local_position = " + std::to_string(p_data.local_position[0]) + " " + std::to_string(p_data.local_position[1])
+    if (!p_camera_motion.initialized)
+    {
+        p_camera_motion.initialized = true;
+        p_camera_motion.last_position = position;
+        p_camera_motion.last_sample = now;
+        return false;
+    }
 
-                        + " xz min = " + std::to_string(p_data.xz_min[0]) + " " + std::to_string(p_data.xz_min[1])
-                        + " xz max = " + std::to_string(p_data.xz_max[0]) + " " + std::to_string(p_data.xz_max[1]))
-                        for (const auto& e : p_data.entities)
-                        {
-                            const auto& world_aspect{ e->aspectAccess(worldAspect::id) };
+    const double dt{ std::chrono::duration<double>(now - p_camera_motion.last_sample).count() };
+    if (dt <= 0.0)
+    {
+        return false;
+    }
 
-                            const auto& entity_worldposition_list{ world_aspect.getComponentsByType<transform::WorldPosition>() };
-                            auto& entity_worldposition{ entity_worldposition_list.at(0)->getPurpose() };
-                            const auto global_pos = entity_worldposition.global_pos;
+    for (int i = 0; i < 3; i++)
+    {
+        const double instant_velocity{ (position[i] - p_camera_motion.last_position[i]) / dt };
+        p_camera_motion.velocity[i] += velocitySmoothing * (instant_velocity - p_camera_motion.velocity[i]);
+    }
 
-                            _MAGE_DEBUG(m_localLogger, "-> " + tab + e->getId() + " position = " + std::to_string(global_pos(3, 0)) + " " + std::to_string(global_pos(3, 2)));
-                        }
-                });
+    p_camera_motion.last_position = position;
+    p_camera_motion.last_sample = now;
+
+    return true;
+}
+
+void SceneStreamerSystem::update_lods()
+{
+    for (auto& e : m_entity_renderings)
+    {
+        EntityRendering& entity_rendering{ e.second };
+
+        if (0 == entity_rendering.m_lod_distances.size() || !entity_rendering.m_request_rendering)
+        {
+            continue;
         }
-        else // XtreeType::OCTREE
+
+        core::Entity* entity{ m_entitygraph.getEntity(e.first) };
+        if (nullptr == entity)
         {
-            rgpd.second.octree_root->traverse([&](const SceneOctreeNode& p_data, size_t p_depth)
-                {
-                    if (0 == p_data.entities.size())
-                    {
-                        return;
-                    }
+            continue;
+        }
+
+        const auto& world_aspect{ entity->aspectAccess(worldAspect::id) };
+        const double distance{ world_aspect.getComponent<std::pair<rendering::Queue*, double>>("lod_distance_to_cam")->getPurpose().second };
 
-                    std::string tab;
-                    for (size_t i = 0; i < p_depth; i++) tab = tab + " ";
+        // m_lod_distances[i] is the distance from which level i + 1 replace level i;
+        // level change only when distance is beyond threshold +/- hysteresis, to avoid flickering around it
+        const auto& distances{ entity_rendering.m_lod_distances };
+        const double hysteresis{ entity_rendering.m_lod_hysteresis };
 
-                    _MAGE_DEBUG(m_localLogger, tab + "depth = " + std::to_string(p_depth)
+        int level{ entity_rendering.m_lod_level };
 
-                        + " side_length = " + std::to_string(p_data.side_length)
-                        + " local_position = " + std::to_string(p_data.local_position[0]) + " " + std::to_string(p_data.local_position[1]) + " " + std::to_string(p_data.local_position[2])
+        while (level < static_cast<int>(distances.size()) && distance > distances.at(level) * (1.0 + hysteresis))
+        {
+            level++;
+        }
 
-                        + " xz min = " + std::to_string(p_data.xyz_min[0]) + " " + std::to_string(p_data.xyz_min[1]) + " " + std::to_string(p_data.xyz_min[2])
-                        + " xz max = " + std::to_string(p_data.xyz_max[0]) + " " + std::to_string(p_data.xyz_max[1]) + " " + std::to_string(p_data.xyz_max[2]))
+        while (level > 0 && distance < distances.at(level - 1) * (1.0 - hysteresis))
+        {
+            level--;
+        }
 
-                        for (const auto& e : p_data.entities)
-                        {
-                            const auto& world_aspect{ e->aspectAccess(worldAspect::id) };
+        if (level == entity_rendering.m_lod_level)
+        {
+            continue;
+        }
 
-                            const auto& entity_worldposition_list{ world_aspect.getComponentsByType<transform::WorldPosition>() };
-                            auto& entity_worldposition{ entity_worldposition_list.at(0)->getPurpose() };
-                            const auto global_pos = entity_worldposition.global_pos;
+        // switch only when target meshe is ready on renderer side, otherwise keep current level
+        const auto& resource_aspect{ entity->aspectAccess(resourcesAspect::id) };
 
-                            _MAGE_DEBUG(m_localLogger, "-> " + tab + e->getId() + " position = " + std::to_string(global_pos(3, 0)) + " " + std::to_string(global_pos(3, 0)) + " " + std::to_string(global_pos(3, 2)));
-                        }
-                });
+        const TriangleMeshe* target_meshe{ nullptr };
+        if (0 == level)
+        {
+            target_meshe = &resource_aspect.getComponent<std::pair<std::pair<std::string, std::string>, TriangleMeshe>>("meshe")->getPurpose().second;
+        }
+        else
+        {
+            target_meshe = &resource_aspect.getComponent<std::pair<double, std::pair<std::pair<std::string, std::string>, TriangleMeshe>>>("meshe_lod" + std::to_string(level))->getPurpose().second.second;
+        }
+
+        if (TriangleMeshe::State::RENDERERLOADED != target_meshe->getState())
+        {
+            continue;
+        }
+
+        if (entity_rendering.m_rendered)
+        {
+            // proxies are rebuilt with new meshe : rendering queue will move instance to matching drawing control
+            unregister_from_queues(entity);
+            entity_rendering.m_lod_level = level;
+            register_to_queues(entity_rendering.m_channels, entity);
+        }
+        else
+        {
+            // not registered yet : will be with right level
+            entity_rendering.m_lod_level = level;
         }
     }
-    _MAGE_DEBUG(m_localLogger, ">>>>>>>>>>>>>>> XTREE DUMP END <<<<<<<<<<<<<<<<<<<<<<<<")
 }
 
-void SceneStreamerSystem::dumpXTreeEntities()
+void SceneStreamerSystem::dumpXTree()
 {
-    _MAGE_DEBUG(m_localLogger, ">>>>>>>>>>>>>>> XTREE ENTITIES BEGIN <<<<<<<<<<<<<<<<<<<<<<<<")
+    _MAGE_DEBUG(m_localLogger, ">>>>>>>>>>>>>>> XTREE DUMP BEGIN <<<<<<<<<<<<<<<<<<<<<<<<");
 
-    for (const auto& rgpd : m_rendergraphpart_data)
+    if (XtreeType::QUADTREE == m_configuration.xtree_type)
     {
-        _MAGE_DEBUG(m_localLogger, "for ViewGroup " + rgpd.first)
+        dump_XTree(m_quadtree);
+    }
+    else // XtreeType::OCTREE
+    {
+        dump_XTree(m_octree);
+    }
 
-        for (const auto& e : rgpd.second.xtree_moving_entities_to_monitor)
-        {
-            const core::Entity* entity{ e.second.entity };
-            const auto& world_aspect{ entity->aspectAccess(worldAspect::id) };
+    _MAGE_DEBUG(m_localLogger, ">>>>>>>>>>>>>>> XTREE DUMP END <<<<<<<<<<<<<<<<<<<<<<<<");
+}
 
-            const auto& entity_worldposition_list{ world_aspect.getComponentsByType<transform::WorldPosition>() };
-            auto& entity_worldposition{ entity_worldposition_list.at(0)->getPurpose() };
-            const auto global_pos = entity_worldposition.global_pos;
+void SceneStreamerSystem::dumpXTreeEntities()
+{
+    _MAGE_DEBUG(m_localLogger, ">>>>>>>>>>>>>>> XTREE ENTITIES BEGIN <<<<<<<<<<<<<<<<<<<<<<<<");
 
-            if (XtreeType::QUADTREE == m_configuration.xtree_type)
-            {
-                if (e.second.quadtree_node)
-                {
-                    const SceneQuadTreeNode data{ e.second.quadtree_node->getData() };
+    for (const auto& e : m_xtree_moving_entities_to_monitor)
+    {
+        const core::Entity* entity{ e.second.entity };
+        const auto& world_aspect{ entity->aspectAccess(worldAspect::id) };
 
-                    _MAGE_DEBUG(m_localLogger, e.first + " position = " + std::to_string(global_pos(3, 0)) + " " + std::to_string(global_pos(3, 2))
-                        + " tree -> xz min = " + std::to_string(data.xz_min[0]) + " " + std::to_string(data.xz_min[1])
-                        + " xz max = " + std::to_string(data.xz_max[0]) + " " + std::to_string(data.xz_max[1]) + " depth = "
-                        + std::to_string(e.second.quadtree_node->getDepth()) + " side length = " + std::to_string(data.side_length))
-                }
-                else
-                {
-                    _MAGE_DEBUG(m_localLogger, e.first + " position = " + std::to_string(global_pos(3, 0)) + " " + std::to_string(global_pos(3, 2))
-                        + " NO SceneQuadTreeNode !!!")
-                }
-            }
-            else // XtreeType::OCTREE
-            {
-                if (e.second.octree_node)
-                {
-                    const SceneOctreeNode data{ e.second.octree_node->getData() };
+        const auto& entity_worldposition_list{ world_aspect.getComponentsByType<transform::WorldPosition>() };
+        auto& entity_worldposition{ entity_worldposition_list.at(0)->getPurpose() };
+        const auto global_pos = entity_worldposition.global_pos;
 
-                    _MAGE_DEBUG(m_localLogger, e.first + " position = " + std::to_string(global_pos(3, 0)) + " " + std::to_string(global_pos(3, 1)) + " " + std::to_string(global_pos(3, 2))
-                        + " tree -> xyz min = " + std::to_string(data.xyz_min[0]) + " " + std::to_string(data.xyz_min[1]) + " " + std::to_string(data.xyz_min[2])
-                        + " xyz max = " + std::to_string(data.xyz_max[0]) + " " + std::to_string(data.xyz_max[1]) + " " + std::to_string(data.xyz_max[2])
-                        + " depth = " + std::to_string(e.second.octree_node->getDepth()) + " side length = " + std::to_string(data.side_length))
-                }
-                else
-                {
-                    _MAGE_DEBUG(m_localLogger, e.first + " position = " + std::to_string(global_pos(3, 0)) + " " + std::to_string(global_pos(3, 1)) + " " + std::to_string(global_pos(3, 2))
-                        + " NO SceneOctreeNode !!!")
-                }
+        const auto code{ e.second.xtree_code };
+        const std::string position_str{ " position = " + std::to_string(global_pos(3, 0)) + " " + std::to_string(global_pos(3, 1)) + " " + std::to_string(global_pos(3, 2)) };
 
-            }
+        if (0 == code)
+        {
+            _MAGE_DEBUG(m_localLogger, e.first + position_str + " NOT IN XTREE !!!");
+        }
+        else if (XtreeType::QUADTREE == m_configuration.xtree_type)
+        {
+            const auto cell_min{ m_quadtree.cellMin(code) };
+            _MAGE_DEBUG(m_localLogger, e.first + position_str + " tree -> xz min = " + std::to_string(cell_min[0]) + " " + std::to_string(cell_min[1])
+                + " depth = " + std::to_string(SceneQuadTree::depthOf(code)) + " side length = " + std::to_string(m_quadtree.cellSideLength(code)));
+        }
+        else // XtreeType::OCTREE
+        {
+            const auto cell_min{ m_octree.cellMin(code) };
+            _MAGE_DEBUG(m_localLogger, e.first + position_str + " tree -> xyz min = " + std::to_string(cell_min[0]) + " " + std::to_string(cell_min[1]) + " " + std::to_string(cell_min[2])
+                + " depth = " + std::to_string(SceneOctree::depthOf(code)) + " side length = " + std::to_string(m_octree.cellSideLength(code)));
         }
     }
 
-    _MAGE_DEBUG(m_localLogger, ">>>>>>>>>>>>>>> XTREE ENTITIES END <<<<<<<<<<<<<<<<<<<<<<<<")
+    _MAGE_DEBUG(m_localLogger, ">>>>>>>>>>>>>>> XTREE ENTITIES END <<<<<<<<<<<<<<<<<<<<<<<<");
 }
 
 std::string SceneStreamerSystem::filter_arguments_stack(const std::string p_input, const std::unordered_map<std::string, std::string> p_file_args)
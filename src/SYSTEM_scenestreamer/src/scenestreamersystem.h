@@ -35,6 +35,7 @@
 #include <random>
 #include <limits>
 #include <cmath>
+#include <chrono>
 
 
 #include <json_struct/json_struct.h>
@@ -45,13 +46,15 @@
 #include "resourcesystem.h"
 
 #include "system.h"
+#include "entityhandle.h"
+#include "entitygraph.h"
 #include "matrix.h"
 #include "tvector.h"
 
 #include "syncvariable.h"
 
 #include "matrixfactory.h"
-#include "xtree.h"
+#include "linearxtree.h"
 
 #include "logsink.h"
 #include "logconf.h"
@@ -415,11 +418,23 @@ namespace mage
             JS_OBJ(configs, vertex_shaders_params, pixel_shaders_params);
         };
 
+        struct MesheLod
+        {
+            std::string                         filename;
+            std::string                         meshe_id;
+            double                              distance{ 0.0 }; // distance to camera from which this level replace previous one
+
+            JS_OBJ(filename, meshe_id, distance);
+        };
+
         struct ResourceAspect
         {            
-            Meshe meshe;
+            Meshe                               meshe;
 
-            JS_OBJ(meshe);
+            std::vector<MesheLod>               lods;                  // optional lower detail levels, meshe above is level 0
+            double                              lod_hysteresis{ 0.1 }; // ratio of switch distance to cross before changing level
+
+            JS_OBJ(meshe, lods, lod_hysteresis);
         };
 
         struct ScenegraphEntity
@@ -644,9 +659,14 @@ namespace mage
         }
 
     private:
-        json::Channels  m_channels;
-        bool            m_request_rendering         { false };
-        bool            m_rendered                  { false }; // if true, passes are actually mapped in rendergraph side and so entity is normally rendered
+        json::Channels      m_channels;
+        bool                m_request_rendering         { false };
+        bool                m_rendered                  { false }; // if true, passes are actually mapped in rendergraph side and so entity is normally rendered
+
+        // meshe LOD management (empty m_lod_distances -> no LOD)
+        std::vector<double> m_lod_distances;
+        double              m_lod_hysteresis            { 0.1 };
+        int                 m_lod_level                 { 0 };
 
         friend class SceneStreamerSystem;
     };
@@ -655,132 +675,51 @@ namespace mage
     {
     private:
 
-        // node for quadtree
-        struct SceneQuadTreeNode
+        // node for quadtree or octree : cell geometry is computed from node code (see core::LinearXTree)
+        struct SceneXTreeNode
         {
-            double                                              side_length{ 0 };
-            core::maths::Real2Vector                            local_position;
-
-            core::maths::Real2Vector                            xz_min;
-            core::maths::Real2Vector                            xz_max;
-
             std::unordered_set<mage::core::Entity*>             entities;
         };
 
-        // node for Octree
-        struct SceneOctreeNode
-        {
-            double                                              side_length{ 0 };
-            core::maths::Real3Vector                            local_position;
-
-            core::maths::Real3Vector                            xyz_min;
-            core::maths::Real3Vector                            xyz_max;
-
-            std::unordered_set<mage::core::Entity*>             entities;
-        };
+        using SceneQuadTree = core::LinearQuadTree<SceneXTreeNode>;
+        using SceneOctree = core::LinearOctree<SceneXTreeNode>;
 
         struct XTreeEntity
         {
             core::Entity*                                       entity{ nullptr };
 
-            //ptr vers le node correspondant dans le xtree 
-            core::QuadTreeNode<SceneQuadTreeNode>*              quadtree_node{ nullptr }; 
-            core::OctreeNode<SceneOctreeNode>*                  octree_node{ nullptr };
+            // code of xtree node holding the entity
+            uint64_t                                            xtree_code{ 0 }; // 0 : not placed yet
         };
 
 
-        // regroup main infos related to a rendergraph part:
-        // 
-        //  > associated viewgroup
-        //  > xtree stuff
+        // camera motion estimation from successive WorldPosition samples, for prefetch
 
-        struct RendergraphPartData
+        struct CameraMotion
         {
-            json::ViewGroup                                                                         viewgroup;
+            bool                                                initialized{ false };
 
-            std::unique_ptr<core::QuadTreeNode<SceneQuadTreeNode>>                                  quadtree_root;
-            std::unique_ptr<core::OctreeNode<SceneOctreeNode>>                                      octree_root;
+            core::maths::Real3Vector                            last_position;
+            std::chrono::steady_clock::time_point               last_sample;
 
-            // regrouping here all entities dispatched in m_xtree_root above
-            std::unordered_map<std::string, XTreeEntity>                                            xtree_moving_entities_to_monitor;
+            core::maths::Real3Vector                            velocity; // units per second, smoothed
         };
 
+        // regroup main infos related to a rendergraph part:
+        // 
+        //  > associated viewgroup
+        //  > camera motion for prefetch
+        // 
+        // xtree is shared by all rendergraph parts : see m_quadtree/m_octree
 
-
-        const std::function<void(core::QuadTreeNode<SceneQuadTreeNode>*, double, const core::maths::Matrix&, core::Entity*, SceneStreamerSystem::XTreeEntity&)> m_place_obj_on_quadtree_leaf
+        struct RendergraphPartData
         {
-            [&](core::QuadTreeNode<SceneQuadTreeNode>* p_current_node, double p_obj_size, const core::maths::Matrix& p_global_pos, core::Entity* p_entity, SceneStreamerSystem::XTreeEntity& p_xtreeEntity)
-            {
-                if (p_current_node->isLeaf())
-                {
-                    // leaf reached, cannt go beyond, so place it anyway
-                    p_current_node->dataAccess().entities.insert(p_entity);
-                    p_xtreeEntity.quadtree_node = p_current_node;
-                }
-                else
-                {
-                    if (SceneStreamerSystem::is_inside_quadtreenode(p_current_node->getData(), p_global_pos))
-                    {
-                        const double node_size{ p_current_node->getData().side_length };
+            json::ViewGroup                                                                         viewgroup;
 
-                        const auto ratio{ p_obj_size / node_size };
-                        if (ratio > m_configuration.object_xtreenode_ratio)
-                        {
-                            //place it
-                            p_current_node->dataAccess().entities.insert(p_entity);
-                            p_xtreeEntity.quadtree_node = p_current_node;
-                        }
-                        else
-                        {
-                            for (int i = 0; i < core::QuadTreeNode<SceneQuadTreeNode>::ChildCount; i++)
-                            {
-                                auto child{ p_current_node->getChild(i) };
-                                m_place_obj_on_quadtree_leaf(child, p_obj_size, p_global_pos, p_entity, p_xtreeEntity);
-                            }
-                        }
-                    }
-                }
-            }
+            CameraMotion                                                                            camera_motion;
         };
 
-        /////////////////////////////////////////////////////////////////////////////////
-        // place 3D object in appropriate xtree leaf : utility lambda
-
-        const std::function<void(core::OctreeNode<SceneOctreeNode>*, double, const core::maths::Matrix&, core::Entity*, SceneStreamerSystem::XTreeEntity&)> m_place_obj_on_octree_leaf
-        {
-            [&](core::OctreeNode<SceneOctreeNode>* p_current_node, double p_obj_size, const core::maths::Matrix& p_global_pos, core::Entity* p_entity, SceneStreamerSystem::XTreeEntity& p_xtreeEntity)
-            {
-                if (p_current_node->isLeaf())
-                {
-                    // leaf reached, cannt go beyond, so place it anyway
-                    p_current_node->dataAccess().entities.insert(p_entity);
-                    p_xtreeEntity.octree_node = p_current_node;
-                }
-                else
-                {
-                    if (SceneStreamerSystem::is_inside_octreenode(p_current_node->getData(), p_global_pos))
-                    {
-                        const double node_size{ p_current_node->getData().side_length };
 
-                        const auto ratio{ p_obj_size / node_size };
-                        if (ratio > m_configuration.object_xtreenode_ratio)
-                        {
-                            //place it
-                            p_current_node->dataAccess().entities.insert(p_entity);
-                            p_xtreeEntity.octree_node = p_current_node;
-                        }
-                        else
-                        {
-                            for (int i = 0; i < core::OctreeNode<SceneOctreeNode>::ChildCount; i++)
-                            {
-                                auto child{ p_current_node->getChild(i) };
-                                m_place_obj_on_octree_leaf(child, p_obj_size, p_global_pos, p_entity, p_xtreeEntity);
-                            }
-                        }
-                    }
-                }
-            }
-        };
 
     public:
 
@@ -805,11 +744,14 @@ namespace mage
             double                      object_xtreenode_ratio      { 0.1 };            
             XtreeType                   xtree_type                  { XtreeType::QUADTREE };
             core::maths::Real3Vector    center;
+
+            bool                        prefetch_enabled            { true };
+            double                      prefetch_lookahead          { 1.0 }; // seconds of camera motion to anticipate
         };
 
         SceneStreamerSystem() = delete;
         SceneStreamerSystem(core::Entitygraph& p_entitygraph);
-        ~SceneStreamerSystem() = default;
+        ~SceneStreamerSystem();
 
         void run();
 
@@ -844,28 +786,51 @@ namespace mage
     private:
 
 
-        static bool is_inside_quadtreenode(const SceneQuadTreeNode& p_qtn, const core::maths::Matrix& p_global_pos);
-        static bool is_inside_octreenode(const SceneOctreeNode& p_otn, const core::maths::Matrix& p_global_pos);
+        // quadtree : x, z; octree : x, y, z
+        template<typename XTreeType>
+        static typename XTreeType::Position xtree_position(const core::maths::Matrix& p_global_pos);
+
+        // move entity to p_code node, previous node released if empty
+        template<typename XTreeType>
+        static void place_on_xtree(XTreeType& p_xtree, typename XTreeType::Code p_code, core::Entity* p_entity, XTreeEntity& p_xtreeEntity);
+
+        // release node holding entity, if any
+        template<typename XTreeType>
+        static void remove_from_xtree(XTreeType& p_xtree, core::Entity* p_entity, const XTreeEntity& p_xtreeEntity);
+
+        // camera : leaf containing it; 3D object : first node small enough regarding object size (see Configuration::object_xtreenode_ratio)
+        template<typename XTreeType>
+        void place_cam_on_xtree(XTreeType& p_xtree, const core::maths::Matrix& p_global_pos, core::Entity* p_entity, XTreeEntity& p_xtreeEntity);
+
+        template<typename XTreeType>
+        void place_obj_on_xtree(XTreeType& p_xtree, double p_obj_size, const core::maths::Matrix& p_global_pos, core::Entity* p_entity, XTreeEntity& p_xtreeEntity);
+
+        static bool update_camera_motion(CameraMotion& p_camera_motion, const core::maths::Matrix& p_global_pos);
 
         void register_to_queues(const json::Channels& p_channels, mage::core::Entity* p_entity);
 
         void unregister_from_queues(mage::core::Entity* p_entity);
 
-        void init_XTree(RendergraphPartData& p_rgpd);
+        // entity removed from entitygraph : p_entity already deleted, used as a key only
+        void forget_entity(mage::core::Entity* p_entity, core::EntityHandle p_handle);
+
+        // all channels textures of entity already loaded
+        bool is_prefetch_complete(mage::core::Entity* p_entity);
+
+        void update_lods();
+
+        void init_XTree();
+
+        template<typename XTreeType>
+        void update_XTree(XTreeType& p_xtree, std::unordered_map<std::string, XTreeEntity>& p_xtree_entities);
 
-        template<typename SceneXTreeNode, typename XTreeType>
-        void update_XTree(XTreeType* p_xtree_root,
-                            std::unordered_map<std::string,
-                            XTreeEntity>& p_xtree_entities,
-                            const std::function<void(XTreeType*, const core::maths::Matrix&, core::Entity*, SceneStreamerSystem::XTreeEntity&)>& p_place_cam_on_leaf_func,
-                            const std::function<void(XTreeType*, double, const core::maths::Matrix&, core::Entity*, SceneStreamerSystem::XTreeEntity&)>& p_place_obj_on_leaf_func,
-                            const std::function<bool(const SceneStreamerSystem::XTreeEntity&)> p_hasnode_func,
-                            const std::function<bool(SceneStreamerSystem::XTreeEntity&, const core::maths::Matrix&)> p_is_inside_func);
+        template<typename XTreeType>
+        void check_XTree(const XTreeType& p_xtree);
 
-        template<typename SceneXTreeNode, typename XTreeType>
-        void check_XTree(std::unordered_map<std::string, SceneStreamerSystem::XTreeEntity>& p_xtree_entities, 
-                            const json::ViewGroup& p_viewgroup, 
-                            const std::function<XTreeType* (const SceneStreamerSystem::XTreeEntity&)>& p_get_node_func);
+        template<typename XTreeType>
+        void dump_XTree(const XTreeType& p_xtree);
+
+        void prefetch_entity(core::Entity* p_entity);
 
 
         bool compute_entity(core::Entity* p_entity, const core::ComponentContainer& p_world_components);
@@ -881,16 +846,33 @@ namespace mage
         ///////////////////////////// TABLES
         std::unordered_map<std::string, mage::core::Entity*>                                    m_scene_entities;
 
-        std::unordered_map<std::string, std::unordered_map<std::string, mage::core::Entity*>>   m_rendering_proxies; // i.e rendering_entites ;-)
+        std::unordered_map<core::EntityHandle, std::unordered_map<std::string, mage::core::Entity*>> m_rendering_proxies; // i.e rendering_entites ;-)
 
         std::unordered_map<std::string, std::unordered_set<std::string>>                        m_scene_entities_rg_parts; // rendergraph parts for each scene entity (defined in json as "rendergraph_parts" array)
 
-        std::unordered_map<std::string, EntityRendering>                                        m_entity_renderings;        // entities rendering infos (channels, etc...)
+        std::unordered_map<core::EntityHandle, EntityRendering>                                 m_entity_renderings;        // entities rendering infos (channels, etc...)
 
         std::unordered_map<std::string, RendergraphPartData>                                    m_rendergraphpart_data;
 
+        // spatial index shared by all rendergraph parts
+        SceneQuadTree                                                                           m_quadtree;
+        SceneOctree                                                                             m_octree;
+
+        // regrouping here all moving entities dispatched in xtree above
+        std::unordered_map<std::string, XTreeEntity>                                            m_xtree_moving_entities_to_monitor;
+
+        // "#static" and "#frozen" entities, placed once : kept to release their node on removal
+        std::unordered_map<std::string, XTreeEntity>                                            m_xtree_static_entities;
+
+        std::unordered_map<mage::core::Entity*, std::unordered_set<std::string>>                m_xtree_entities_viewgroups; // viewgroups in which each xtree entity can be rendered
+
         std::unordered_set<mage::core::Entity*>                                                 m_found_entities_to_render;   // entities actually rendered
+
+        std::unordered_set<mage::core::EntityHandle>                                            m_prefetched_entities;        // entities whose resources were prefetched, not rendered yet
         /////////////////////////////////
+
+        long                                                                                    m_prefetch_hits{ 0 };         // entity discovered with its prefetched resources already loaded
+        long                                                                                    m_prefetch_misses{ 0 };       // entity discovered without prefetch
       
         Configuration                                                                           m_configuration;
         bool                                                                                    m_configured{ false };
@@ -902,7 +884,9 @@ namespace mage
 
         /////////////////////////////////
 
-        std::queue<core::Entity*>                                                               m_newly_added_entities;
+        property::EventBus<core::EntitygraphEvent>::ConsumerId                                  m_entitygraph_events;
+        std::queue<core::EntityHandle>                                                          m_newly_added_entities;
+        std::vector<core::EntityHandle>                                                         m_entities_waiting_meshe; // meshe not loaded yet when entity was committed
 
         /////////////////////////////////
 
@@ -927,13 +911,68 @@ namespace mage
     /////////////////////////////////////////////////////////////////////////////////
     /////////////////////////////////////////////////////////////////////////////////
 
-    template<typename SceneXTreeNode, typename XTreeType>
-    void SceneStreamerSystem::update_XTree(XTreeType* p_xtree_root, 
-                                                std::unordered_map<std::string, SceneStreamerSystem::XTreeEntity>& p_xtree_entities,
-                                                const std::function<void(XTreeType*, const core::maths::Matrix&, core::Entity*, SceneStreamerSystem::XTreeEntity&)>& p_place_cam_on_leaf_func,
-                                                const std::function<void(XTreeType*, double, const core::maths::Matrix&, core::Entity*, SceneStreamerSystem::XTreeEntity&)>& p_place_obj_on_leaf_func,
-                                                const std::function<bool(const SceneStreamerSystem::XTreeEntity&)> p_hasnode_func,
-                                                const std::function<bool(SceneStreamerSystem::XTreeEntity&, const core::maths::Matrix&)> p_is_inside_func)
+    template<typename XTreeType>
+    typename XTreeType::Position SceneStreamerSystem::xtree_position(const core::maths::Matrix& p_global_pos)
+    {
+        if constexpr (2 == XTreeType::Dimension)
+        {
+            return { p_global_pos(3, 0), p_global_pos(3, 2) };
+        }
+        else
+        {
+            return { p_global_pos(3, 0), p_global_pos(3, 1), p_global_pos(3, 2) };
+        }
+    }
+
+    template<typename XTreeType>
+    void SceneStreamerSystem::place_on_xtree(XTreeType& p_xtree, typename XTreeType::Code p_code, core::Entity* p_entity, XTreeEntity& p_xtreeEntity)
+    {
+        if (XTreeType::invalidCode == p_code || p_code == p_xtreeEntity.xtree_code)
+        {
+            // outside scene or same node : keep current placement
+            return;
+        }
+
+        remove_from_xtree(p_xtree, p_entity, p_xtreeEntity);
+
+        p_xtree.nodeAccess(p_code).entities.insert(p_entity);
+        p_xtreeEntity.xtree_code = p_code;
+    }
+
+    template<typename XTreeType>
+    void SceneStreamerSystem::remove_from_xtree(XTreeType& p_xtree, core::Entity* p_entity, const XTreeEntity& p_xtreeEntity)
+    {
+        if (XTreeType::invalidCode == p_xtreeEntity.xtree_code)
+        {
+            return;
+        }
+
+        const auto node{ p_xtree.findNode(p_xtreeEntity.xtree_code) };
+        if (node)
+        {
+            node->entities.erase(p_entity);
+            if (node->entities.empty())
+            {
+                p_xtree.removeNode(p_xtreeEntity.xtree_code);
+            }
+        }
+    }
+
+    template<typename XTreeType>
+    void SceneStreamerSystem::place_cam_on_xtree(XTreeType& p_xtree, const core::maths::Matrix& p_global_pos, core::Entity* p_entity, XTreeEntity& p_xtreeEntity)
+    {
+        place_on_xtree(p_xtree, p_xtree.locate(xtree_position<XTreeType>(p_global_pos)), p_entity, p_xtreeEntity);
+    }
+
+    template<typename XTreeType>
+    void SceneStreamerSystem::place_obj_on_xtree(XTreeType& p_xtree, double p_obj_size, const core::maths::Matrix& p_global_pos, core::Entity* p_entity, XTreeEntity& p_xtreeEntity)
+    {
+        const auto depth{ p_xtree.depthForSize(p_obj_size, m_configuration.object_xtreenode_ratio) };
+        place_on_xtree(p_xtree, p_xtree.locate(xtree_position<XTreeType>(p_global_pos), depth), p_entity, p_xtreeEntity);
+    }
+
+    template<typename XTreeType>
+    void SceneStreamerSystem::update_XTree(XTreeType& p_xtree, std::unordered_map<std::string, SceneStreamerSystem::XTreeEntity>& p_xtree_entities)
     {
         for (auto& xe : p_xtree_entities)
         {
@@ -946,7 +985,7 @@ namespace mage
 
             ///////////////////////////////////////////////
 
-            if (!p_hasnode_func(xe.second))
+            if (XTreeType::invalidCode == xe.second.xtree_code)
             {
                 //// PLACE NEW
 
@@ -954,7 +993,7 @@ namespace mage
                 {
                     // camera
 
-                    p_place_cam_on_leaf_func(p_xtree_root, global_pos, entity, xe.second);
+                    place_cam_on_xtree(p_xtree, global_pos, entity, xe.second);
                 }
                 else if (entity->hasAspect(resourcesAspect::id))
                 {
@@ -969,7 +1008,7 @@ namespace mage
                         if (TriangleMeshe::State::RENDERERLOADED == meshe.getState())
                         {
                             const double meshe_size{ meshe.getSize() };
-                            p_place_obj_on_leaf_func(p_xtree_root, meshe_size, global_pos, entity, xe.second);
+                            place_obj_on_xtree(p_xtree, meshe_size, global_pos, entity, xe.second);
                         }
                     }
                 }
@@ -978,35 +1017,32 @@ namespace mage
             {
                 //// UPDATE
 
+                const bool is_inside{ p_xtree.contains(xe.second.xtree_code, xtree_position<XTreeType>(global_pos)) };
+                if (is_inside)
+                {
+                    continue;
+                }
+
                 if (entity->hasAspect(cameraAspect::id))
                 {
-                    const bool is_inside{ p_is_inside_func(xe.second, global_pos) };
-                    if (!is_inside)
-                    {
-                        // update location in xtree
-                        p_place_cam_on_leaf_func(p_xtree_root, global_pos, entity, xe.second);
-                    }
+                    // update location in xtree
+                    place_cam_on_xtree(p_xtree, global_pos, entity, xe.second);
                 }
                 else if (entity->hasAspect(resourcesAspect::id) /* && !xe.second.is_static */)
                 {
-                    const bool is_inside{ p_is_inside_func(xe.second, global_pos) };
+                    // update location in xtree
+                    const auto& resources_aspect{ entity->aspectAccess(resourcesAspect::id) };
 
-                    if (!is_inside)
+                    const auto meshes_list{ resources_aspect.getComponentsByType<std::pair<std::pair<std::string, std::string>, TriangleMeshe>>() };
+                    if (meshes_list.size() > 0)
                     {
-                        // update location in xtree
-                        const auto& resources_aspect{ entity->aspectAccess(resourcesAspect::id) };
+                        auto& meshe_descr{ meshes_list.at(0)->getPurpose() };
+                        TriangleMeshe& meshe{ meshe_descr.second };
 
-                        const auto meshes_list{ resources_aspect.getComponentsByType<std::pair<std::pair<std::string, std::string>, TriangleMeshe>>() };
-                        if (meshes_list.size() > 0)
+                        if (TriangleMeshe::State::BLOBLOADED == meshe.getState())
                         {
-                            auto& meshe_descr{ meshes_list.at(0)->getPurpose() };
-                            TriangleMeshe& meshe{ meshe_descr.second };
-
-                            if (TriangleMeshe::State::BLOBLOADED == meshe.getState())
-                            {
-                                const double meshe_size{ meshe.getSize() };
-                                p_place_obj_on_leaf_func(p_xtree_root, meshe_size, global_pos, entity, xe.second);
-                            }
+                            const double meshe_size{ meshe.getSize() };
+                            place_obj_on_xtree(p_xtree, meshe_size, global_pos, entity, xe.second);
                         }
                     }
                 }
@@ -1015,121 +1051,205 @@ namespace mage
     }
 
 
-    template<typename SceneXTreeNode, typename XTreeType>
-    void SceneStreamerSystem::check_XTree(std::unordered_map<std::string, SceneStreamerSystem::XTreeEntity>& p_xtree_entities, 
-                                            const json::ViewGroup& p_viewgroup, 
-                                            const std::function<XTreeType* (const SceneStreamerSystem::XTreeEntity&)>& p_get_node_func)
+    template<typename XTreeType>
+    void SceneStreamerSystem::check_XTree(const XTreeType& p_xtree)
     {
-        // for current view group, find current camera id 
-
         auto renderingQueueSystemInstance{ dynamic_cast<mage::RenderingQueueSystem*>(SystemEngine::getInstance()->getSystem(m_renderingQueueSystemSlot)) };
-        const auto current_views{ renderingQueueSystemInstance->getViewGroupCurrentViews(p_viewgroup.name) };
-
-        const std::string main_camera_id{ current_views.first };
-
-        XTreeEntity xe{ p_xtree_entities.at(main_camera_id) };
 
-        std::unordered_set<mage::core::Entity*> found_entities; // search entities in camera's neighbourood
+        // entities in neighbourood of a xtree node, computed once per frame and shared by all viewgroups
+        std::unordered_map<typename XTreeType::Code, std::unordered_set<mage::core::Entity*>> neighbouroods;
 
-        const std::function<void(std::unordered_set<mage::core::Entity*>&, XTreeType*, int)> search_near_entities
+        const auto get_neighbourood
         {
-            [&](std::unordered_set<mage::core::Entity*>& p_found_entities, XTreeType* p_node, int p_neighbourood_depth)
+            [&](typename XTreeType::Code p_code) -> const std::unordered_set<mage::core::Entity*>&
             {
-                if (p_neighbourood_depth > m_configuration.max_neighbourood_depth)
-                {
-                    return;
-                }
-
-                ////////// search in current node
-                const SceneXTreeNode& scene_xtree_node{ p_node->getData() };
-                for (mage::core::Entity* e : scene_xtree_node.entities)
+                const auto it{ neighbouroods.find(p_code) };
+                if (it != neighbouroods.end())
                 {
-                    if (m_entity_renderings.count(e->getId()) > 0)
-                    {
-                        // store only those than can be rendered
-                        p_found_entities.insert(e);
-                    }
+                    return it->second;
                 }
 
-                ////////// search in current node neighbours
+                auto& near_entities{ neighbouroods[p_code] };
 
-                std::vector<XTreeType*> neighbours{ p_node->getNeighbours() };
-                for (XTreeType* n : neighbours)
+                // node, then its ancestors : bigger objects are placed in upper nodes
+                for (auto code = p_code; code != XTreeType::invalidCode; code = XTreeType::parentOf(code))
                 {
-                    if (nullptr != n)
+                    // nodes at same depth, up to (max_neighbourood_depth + 1) cells away
+                    p_xtree.forEachNodeAround(code, m_configuration.max_neighbourood_depth + 1, [&](typename XTreeType::Code, const SceneXTreeNode& p_node)
                     {
-                        const SceneXTreeNode& n_scene_xtree_node{ n->getData() };
-                        for (mage::core::Entity* e : n_scene_xtree_node.entities)
+                        for (mage::core::Entity* e : p_node.entities)
                         {
-                            if (m_entity_renderings.count(e->getId()) > 0)
+                            if (m_entity_renderings.count(e->getHandle()) > 0)
                             {
                                 // store only those than can be rendered
-                                p_found_entities.insert(e);
+                                near_entities.insert(e);
                             }
                         }
-                        search_near_entities(p_found_entities, n, p_neighbourood_depth + 1);
+                    });
+                }
+                return near_entities;
+            }
+        };
+
+        // per viewgroup filter on a shared neighbourood
+        const auto collect_viewgroup_entities
+        {
+            [&](const std::string& p_viewgroup, const std::unordered_set<mage::core::Entity*>& p_near_entities, std::unordered_set<mage::core::Entity*>& p_result)
+            {
+                for (mage::core::Entity* e : p_near_entities)
+                {
+                    const auto it{ m_xtree_entities_viewgroups.find(e) };
+                    if (it != m_xtree_entities_viewgroups.end() && it->second.count(p_viewgroup))
+                    {
+                        p_result.insert(e);
                     }
                 }
             }
         };
 
+        bool camera_placed{ false };
 
-        XTreeType* curr = p_get_node_func(xe); // get xe.quadtree or xe.octree regarding XTreeType used :)
+        std::unordered_set<mage::core::Entity*> found_entities; // search entities in cameras neighbourood
+        std::unordered_set<mage::core::Entity*> predicted_entities; // search entities around cameras predicted positions
 
-        if (curr)
+        for (auto& rgpd : m_rendergraphpart_data)
         {
-            while (1)
+            auto& rgpd_data{ rgpd.second };
+
+            // for current view group, find current camera id 
+            const auto current_views{ renderingQueueSystemInstance->getViewGroupCurrentViews(rgpd_data.viewgroup.name) };
+            const std::string main_camera_id{ current_views.first };
+
+            const XTreeEntity& xe{ m_xtree_moving_entities_to_monitor.at(main_camera_id) };
+            const auto cam_code{ xe.xtree_code };
+
+            if (XTreeType::invalidCode == cam_code)
             {
-                search_near_entities(found_entities, curr, 0);
+                continue;
+            }
+            camera_placed = true;
+
+            collect_viewgroup_entities(rgpd_data.viewgroup.name, get_neighbourood(cam_code), found_entities);
+
+            // prefetch : anticipate camera motion and prefetch resources of entities around predicted position
+            const auto& cam_world_aspect{ xe.entity->aspectAccess(worldAspect::id) };
+            const auto& cam_worldposition_list{ cam_world_aspect.getComponentsByType<transform::WorldPosition>() };
 
-                curr = curr->getParent();
-                if (nullptr == curr)
+            if (update_camera_motion(rgpd_data.camera_motion, cam_worldposition_list.at(0)->getPurpose().global_pos) && m_configuration.prefetch_enabled)
+            {
+                const auto& position{ rgpd_data.camera_motion.last_position };
+                const auto& velocity{ rgpd_data.camera_motion.velocity };
+                const double lookahead{ m_configuration.prefetch_lookahead };
+
+                core::maths::Matrix predicted_pos;
+                predicted_pos.translation(position[0] + velocity[0] * lookahead, 
+                                            position[1] + velocity[1] * lookahead, 
+                                            position[2] + velocity[2] * lookahead);
+
+                // leaf containing predicted position
+                const auto predicted_code{ p_xtree.locate(xtree_position<XTreeType>(predicted_pos)) };
+
+                if (XTreeType::invalidCode != predicted_code && predicted_code != cam_code)
                 {
-                    break;
+                    collect_viewgroup_entities(rgpd_data.viewgroup.name, get_neighbourood(predicted_code), predicted_entities);
                 }
             }
+        }
 
-            bool needTriggerResourcesSystem{ false };
+        if (!camera_placed)
+        {
+            return;
+        }
+
+        bool needTriggerResourcesSystem{ false };
 
-            // new entities discovered, to render
-            for (mage::core::Entity* entity : found_entities)
+        // new entities discovered, to render
+        for (mage::core::Entity* entity : found_entities)
+        {
+            if (!m_found_entities_to_render.count(entity))
             {
-                if (!m_found_entities_to_render.count(entity))
+                // just discovered -> ask for rendering
+                if (!m_entity_renderings.at(entity->getHandle()).m_rendered)
                 {
-                    // just discovered -> ask for rendering
-                    if (!m_entity_renderings.at(entity->getId()).m_rendered)
-                    {
-                        m_entity_renderings.at(entity->getId()).m_request_rendering = true;
+                    m_entity_renderings.at(entity->getHandle()).m_request_rendering = true;
+
+                    // at least one entity added to rendergraph, we gonna need to reactivate the resource system
+                    needTriggerResourcesSystem = true;
 
-                        // at least one entity added to rendergraph, we gonna need to reactivate the resource system
-                        needTriggerResourcesSystem = true;
+                    // hit only if prefetch is done : queued requests don't count
+                    if (m_prefetched_entities.erase(entity->getHandle()) && is_prefetch_complete(entity))
+                    {
+                        m_prefetch_hits++;
+                    }
+                    else
+                    {
+                        m_prefetch_misses++;
                     }
                 }
             }
+        }
 
-            // entities not in neigbourood no more, to remove from rendering...
-            for (mage::core::Entity* rendered_entity : m_found_entities_to_render)
+        // entities not in neigbourood no more, to remove from rendering...
+        for (mage::core::Entity* rendered_entity : m_found_entities_to_render)
+        {
+            if (!found_entities.count(rendered_entity))
             {
-                if (!found_entities.count(rendered_entity))
-                {
-                    // not found no more -> ask to stop rendering
+                // not found no more -> ask to stop rendering
 
-                    if (m_entity_renderings.at(rendered_entity->getId()).m_rendered)
-                    {
-                        m_entity_renderings.at(rendered_entity->getId()).m_request_rendering = false;
-                    }
+                if (m_entity_renderings.at(rendered_entity->getHandle()).m_rendered)
+                {
+                    m_entity_renderings.at(rendered_entity->getHandle()).m_request_rendering = false;
                 }
             }
+        }
 
-            // update...
-            m_found_entities_to_render = found_entities;
+        // update...
+        m_found_entities_to_render = found_entities;
 
-            if (needTriggerResourcesSystem)
+        for (mage::core::Entity* entity : predicted_entities)
+        {
+            if (!found_entities.count(entity) && !m_prefetched_entities.count(entity->getHandle()) && !m_entity_renderings.at(entity->getHandle()).m_rendered)
             {
-                // 
-                auto resourceSystemInstance{ dynamic_cast<mage::ResourceSystem*>(SystemEngine::getInstance()->getSystem(m_resourceSystemSlot)) };
-                resourceSystemInstance->request();
+                prefetch_entity(entity);
             }
         }
+
+        if (needTriggerResourcesSystem)
+        {
+            // 
+            auto resourceSystemInstance{ dynamic_cast<mage::ResourceSystem*>(SystemEngine::getInstance()->getSystem(m_resourceSystemSlot)) };
+            resourceSystemInstance->request();
+        }
     };
+
+    template<typename XTreeType>
+    void SceneStreamerSystem::dump_XTree(const XTreeType& p_xtree)
+    {
+        _MAGE_DEBUG(m_localLogger, "nodes count = " + std::to_string(p_xtree.getNodesCount()));
+
+        p_xtree.forEachNode([&](typename XTreeType::Code p_code, const SceneXTreeNode& p_node)
+        {
+            const auto depth{ XTreeType::depthOf(p_code) };
+            const auto cell_min{ p_xtree.cellMin(p_code) };
+
+            std::string tab;
+            for (size_t i = 0; i < depth; i++) tab = tab + " ";
+
+            std::string min_str;
+            for (const auto c : cell_min) min_str += " " + std::to_string(c);
+
+            _MAGE_DEBUG(m_localLogger, tab + "depth = " + std::to_string(depth) + " side_length = " + std::to_string(p_xtree.cellSideLength(p_code)) + " min =" + min_str);
+
+            for (const auto& e : p_node.entities)
+            {
+                const auto& world_aspect{ e->aspectAccess(worldAspect::id) };
+
+                const auto& entity_worldposition_list{ world_aspect.getComponentsByType<transform::WorldPosition>() };
+                auto& entity_worldposition{ entity_worldposition_list.at(0)->getPurpose() };
+                const auto global_pos = entity_worldposition.global_pos;
+
+                _MAGE_DEBUG(m_localLogger, "-> " + tab + e->getId() + " position = " + std::to_string(global_pos(3, 0)) + " " + std::to_string(global_pos(3, 1)) + " " + std::to_string(global_pos(3, 2)));
+            }
+        });
+    }
 }
@@ -22,10 +22,10 @@
 */
 /* -*-LIC_END-*- */
 
-#include <chrono>
 #include <string>
 
 #include "timesystem.h"
+#include "profiler.h"
 #include "entity.h"
 #include "entitygraph.h"
 #include "aspects.h"
@@ -39,39 +39,40 @@ using namespace mage::core;
 
 TimeSystem::TimeSystem(Entitygraph& p_entitygraph) : System(p_entitygraph)
 {
-	const auto dataCloud{ mage::rendering::Datacloud::getInstance() };
-	dataCloud->registerData<std::string>("mage.timings.timesystem");
+	// timeAspect also stands for TimeControl state
+	declareAccess(core::timeAspect::id, core::SystemAccess::WRITE);
 }
 
 void TimeSystem::run()
 {
-	const auto start_time{ std::chrono::high_resolution_clock::now() };
+	_MAGE_PROFILE_ZONE("timesystem");
 
 	auto tc{ TimeControl::getInstance() };
 	tc->update();
-	if (tc->isReady())
-	{
-		auto entities_with_time{ m_entitygraph.getEntitiesListForAspect(core::timeAspect::id) };
-		for (Entity* entity : entities_with_time)
-		{
-			const ComponentContainer& components{ entity->aspectAccess(core::timeAspect::id) };
 
-			// search for TimeManager::Variable objects
+	m_syncvars.clear();
 
-			const auto syncvars_list{ components.getComponentsByType<SyncVariable>() };
-			if (syncvars_list.size())
-			{
-				for (auto& v : syncvars_list)
-				{
-					tc->manageVariable(v->getPurpose());
-				}
-			}
-		}
+	auto entities_with_time{ m_entitygraph.getEntitiesListForAspect(core::timeAspect::id) };
+	for (Entity* entity : entities_with_time)
+	{
+		const ComponentContainer& components{ entity->aspectAccess(core::timeAspect::id) };
 
+		// search for TimeManager::Variable objects
+		components.forEachComponentByType<SyncVariable>([&](Component<SyncVariable>* p_comp)
+		{
+			m_syncvars.add(&p_comp->getPurpose());
+		});
 	}
 
-	const auto end_time{ std::chrono::high_resolution_clock::now() };
-	const auto duration{ std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time) };
-	const auto dataCloud{ mage::rendering::Datacloud::getInstance() };
-	dataCloud->updateDataValue<std::string>("mage.timings.timesystem", std::to_string(duration.count()) + " ms");
-}
\ No newline at end of file
+	if (tc->isReady())
+	{
+		// speed (unit per sec) to step value, time factor included
+		tc->runSimulationSteps([&]()
+		{
+			m_syncvars.step(tc->convertUnitPerSecFramePerSec(1.0));
+		});
+	}
+
+	m_syncvars.interpolate(tc->getInterpolationFactor());
+	m_syncvars.writeBack();
+}
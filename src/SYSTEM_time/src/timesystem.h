@@ -25,6 +25,7 @@
 
 #pragma once
 #include "system.h"
+#include "syncvariablesstore.h"
 
 namespace mage
 {
@@ -39,5 +40,8 @@ namespace mage
         ~TimeSystem() = default;
 
         void run();
+
+    private:
+        core::SyncVariablesStore    m_syncvars; // reused each frame
     };
 }
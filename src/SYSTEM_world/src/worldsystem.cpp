@@ -22,10 +22,10 @@
 */
 /* -*-LIC_END-*- */
 
-#include <chrono>
 #include <string>
 
 #include "worldsystem.h"
+#include "profiler.h"
 #include "entity.h"
 #include "entitygraph.h"
 #include "aspects.h"
@@ -36,44 +36,58 @@
 #include "matrixchain.h"
 #include "datacloud.h"
 #include "matrix.h"
+#include "framearena.h"
 
 using namespace mage;
 using namespace mage::core;
 
 WorldSystem::WorldSystem(Entitygraph& p_entitygraph) : System(p_entitygraph)
 {
-	const auto dataCloud{ mage::rendering::Datacloud::getInstance() };
-	dataCloud->registerData<std::string>("mage.timings.worldsystem");
+	declareAccess(core::timeAspect::id, core::SystemAccess::READ);
+	declareAccess(core::cameraAspect::id, core::SystemAccess::READ);
+	declareAccess(core::tagsAspect::id, core::SystemAccess::READ);
+	declareAccess(core::worldAspect::id, core::SystemAccess::WRITE);
+	declareAccess(core::renderingAspect::id, core::SystemAccess::WRITE); // drawing controls projected_z_neg
+
+	// entitygraph events drained at each run() start
+	m_entitygraph_events = m_entitygraph.getEventBus().registerConsumer();
+}
+
+WorldSystem::~WorldSystem()
+{
+	m_entitygraph.getEventBus().unregisterConsumer(m_entitygraph_events);
+}
 
-	// Register callback for entitygraph events
-	m_entitygraph.registerSubscriber([this](core::EntitygraphEvents p_event, const core::Entity& p_entity)
+void WorldSystem::drainEntitygraphEvents()
+{
+	constexpr auto mask{ property::EventBus<core::EntitygraphEvent>::typeBit(core::EntitygraphEvents::ENTITYGRAPHNODE_COMMITTED, core::EntitygraphEvents::ENTITYGRAPHNODE_ASPECT_ADDED, core::EntitygraphEvents::ENTITYGRAPHNODE_REMOVED) };
+
+	m_entitygraph.getEventBus().drain(m_entitygraph_events, mask, [this](const core::EntitygraphEvent& p_event)
 	{
-		switch (p_event)
+		switch (p_event.type)
 		{
-			case core::EntitygraphEvents::ENTITYGRAPHNODE_ADDED:
+			case core::EntitygraphEvents::ENTITYGRAPHNODE_COMMITTED:
 			{
-				// push it to the queue to be processed later - in next run() call, because entity was just created so no any aspects added yet at this moment
-
-				m_newly_added_entities.push(const_cast<core::Entity*>(&p_entity));
+				// entity aspects and components are set : process it once, below
+				m_newly_added_entities.push(p_event.handle);
 			}
 			break;
 
-			case core::EntitygraphEvents::ENTITYGRAPHNODE_REMOVED:
+			case core::EntitygraphEvents::ENTITYGRAPHNODE_ASPECT_ADDED:
 			{
-				if (m_entities_to_compute_distance.count(const_cast<core::Entity*>(&p_entity)))
-				{
-					m_entities_to_compute_distance.erase(const_cast<core::Entity*>(&p_entity));
-				}
-
-				if (m_entities_to_compute_2d_pos.count(const_cast<core::Entity*>(&p_entity)))
+				// world aspect made after entity commit
+				if (core::worldAspect::id == p_event.aspect)
 				{
-					m_entities_to_compute_2d_pos.erase(const_cast<core::Entity*>(&p_entity));
+					m_newly_added_entities.push(p_event.handle);
 				}
+			}
+			break;
 
-				if (m_entities_to_compute.count(const_cast<core::Entity*>(&p_entity)))
-				{
-					m_entities_to_compute.erase(const_cast<core::Entity*>(&p_entity));
-				}
+			case core::EntitygraphEvents::ENTITYGRAPHNODE_REMOVED:
+			{
+				m_entities_to_compute_distance.erase(p_event.entity);
+				m_entities_to_compute_2d_pos.erase(p_event.entity);
+				m_entities_to_compute.erase(p_event.entity);
 			}
 			break;
 		}
@@ -122,17 +136,20 @@ void WorldSystem::extractProjAndViewFromRenderingQueue(const std::string& p_curr
 
 void WorldSystem::run()
 {
-	const auto start_time_main{ std::chrono::high_resolution_clock::now() };
+	_MAGE_PROFILE_ZONE("worldsystem");
 
 	const auto dataCloud{ mage::rendering::Datacloud::getInstance() };
 
+	drainEntitygraphEvents();
+
 	//////////////////////////////////////////////////////////
-	/// I : Process newly added entities from FIFO queue
+	/// I : Process newly committed entities from FIFO queue
 	//////////////////////////////////////////////////////////
 
 	while (!m_newly_added_entities.empty())
 	{
-		core::Entity* newly_added_entity{ m_newly_added_entities.front() };
+		// nullptr if entity committed then removed before this run
+		core::Entity* newly_added_entity{ m_entitygraph.getEntity(m_newly_added_entities.front()) };
 		m_newly_added_entities.pop();
 
 		// Process the newly added entity
@@ -324,18 +341,16 @@ void WorldSystem::run()
 		}
 
 	}
-
-	const auto end_time_main{ std::chrono::high_resolution_clock::now() };
-	const auto duration_main{ std::chrono::duration_cast<std::chrono::milliseconds>(end_time_main - start_time_main) };
-	
-	dataCloud->updateDataValue<std::string>("mage.timings.worldsystem", std::to_string(duration_main.count()) + " ms");
 }
 
 void WorldSystem::compute_entity(core::Entity* p_entity, const ComponentContainer& p_world_components)
 {
 	///// compute matrix hierarchy
 
-	const auto& entity_worldposition_list{ p_world_components.getComponentsByType<transform::WorldPosition>() };
+	// per-entity, per-frame lists : allocated from frame arena
+	const auto arena{ core::FrameArena::getInstance() };
+
+	const auto entity_worldposition_list{ p_world_components.getComponentsByType<transform::WorldPosition>(arena) };
 	if (0 == entity_worldposition_list.size())
 	{
 		//_EXCEPTION("Entity world aspect : missing world position " + p_entity->getId());
@@ -356,7 +371,7 @@ void WorldSystem::compute_entity(core::Entity* p_entity, const ComponentContaine
 	if (parent_entity && parent_entity->hasAspect(worldAspect::id))
 	{
 		const auto& parent_worldaspect{ parent_entity->aspectAccess(worldAspect::id) };
-		const auto& parententity_worldpositions_list{ parent_worldaspect.getComponentsByType<transform::WorldPosition>() };
+		const auto parententity_worldpositions_list{ parent_worldaspect.getComponentsByType<transform::WorldPosition>(arena) };
 
 		if (0 == parententity_worldpositions_list.size())
 		{
@@ -369,7 +384,7 @@ void WorldSystem::compute_entity(core::Entity* p_entity, const ComponentContaine
 
 			///// compute animators -> result stored in local pos
 
-			auto& entity_animators_list{ p_world_components.getComponentsByType<transform::Animator>() };
+			const auto entity_animators_list{ p_world_components.getComponentsByType<transform::Animator>(arena) };
 			if (entity_animators_list.size() > 0)
 			{
 				if (p_entity->hasAspect(core::timeAspect::id))
@@ -404,7 +419,7 @@ void WorldSystem::compute_entity(core::Entity* p_entity, const ComponentContaine
 
 			case transform::WorldPosition::TransformationComposition::TRANSFORMATION_PARENT_PROJECTEDPOS:
 			{
-				auto screenposition_components_list{ parent_worldaspect.getComponentsByType<std::pair<mage::rendering::Queue*, core::maths::Real3Vector>>() };
+				const auto screenposition_components_list{ parent_worldaspect.getComponentsByType<std::pair<mage::rendering::Queue*, core::maths::Real3Vector>>(arena) };
 				if (screenposition_components_list.size())
 				{
 					auto screenposition{ screenposition_components_list.at(0)->getPurpose().second };
@@ -421,7 +436,7 @@ void WorldSystem::compute_entity(core::Entity* p_entity, const ComponentContaine
 					{
 						const auto& entity_renderingaspect{ p_entity->aspectAccess(core::renderingAspect::id) };
 
-						auto& entity_dc_list{ entity_renderingaspect.getComponentsByType<rendering::DrawingControl>() };
+						const auto entity_dc_list{ entity_renderingaspect.getComponentsByType<rendering::DrawingControl>(arena) };
 						if (entity_dc_list.size() > 0)
 						{
 							entity_dc_list.at(0)->getPurpose().projected_z_neg = (screenposition[2] < 0);
@@ -441,7 +456,7 @@ void WorldSystem::compute_entity(core::Entity* p_entity, const ComponentContaine
 	{
 		///// compute animators -> result stored in local pos
 
-		auto& entity_animators_list{ p_world_components.getComponentsByType<transform::Animator>() };
+		const auto entity_animators_list{ p_world_components.getComponentsByType<transform::Animator>(arena) };
 		if (entity_animators_list.size() > 0)
 		{
 			if (p_entity->hasAspect(core::timeAspect::id))
@@ -30,6 +30,7 @@
 #include <unordered_set>
 
 #include "system.h"
+#include "entitygraph.h"
 
 namespace mage
 {
@@ -51,7 +52,7 @@ namespace mage
 
         WorldSystem() = delete;
         WorldSystem(core::Entitygraph& p_entitygraph);
-        ~WorldSystem() = default;
+        ~WorldSystem();
 
         void run();
 
@@ -61,7 +62,11 @@ namespace mage
 
         void compute_entity(core::Entity* p_entity, const core:: ComponentContainer& p_world_components);
 
-        std::queue<core::Entity*> m_newly_added_entities;
+        void drainEntitygraphEvents();
+
+        property::EventBus<core::EntitygraphEvent>::ConsumerId  m_entitygraph_events;
+
+        std::queue<core::EntityHandle> m_newly_added_entities;
 
         std::unordered_set<core::Entity*>  m_entities_to_compute_distance;
         std::unordered_set<core::Entity*>  m_entities_to_compute_2d_pos;
@@ -93,7 +93,7 @@ namespace mage
 
 		double SyncVarValueMatrixSource::getValue() const
 		{
-			return m_syncvar->value;
+			return m_syncvar->interpolated_value;
 		}
 
 		template<typename T>
@@ -37,6 +37,7 @@
 #include "entity.h"
 #include "entitygraph.h"
 #include "renderingqueue.h"
+#include "datacloud.h"
 
 #include "animations.h"
 
@@ -82,6 +83,9 @@ namespace mage
         void                            run(void);
         void                            close(void);
 
+        bool                            hasPendingWork(void);
+        void                            onFrameEnd(const mage::interfaces::FrameStats& p_stats);
+
     protected:
 
         //override
@@ -97,6 +101,8 @@ namespace mage
         static constexpr int            animationsSystemSlot{ 6 };
         static constexpr int            sceneStreamSystemSlot{ 7 };
 
+        static constexpr int            systemsWorkersMax{ 2 };
+
         bool                            m_show_mouse_cursor{ false };
         bool                            m_mouse_relative_mode{ true };
 
@@ -115,6 +121,17 @@ namespace mage
         mage::core::Entity*             m_loading_gear{ nullptr };
         mage::core::Entity*             m_logo{ nullptr };
 
+        size_t                                              m_datacloud_updates_count{ 0 }; // datacloud updates count at end of last frame
+
+        mage::rendering::Datacloud::DataHandle<double>      m_frame_time_mean;
+        mage::rendering::Datacloud::DataHandle<double>      m_frame_time_variance;
+
+        size_t                                              m_pools_allocations_count{ 0 }; // pools allocations count at end of last frame
+
+        mage::rendering::Datacloud::DataHandle<long>        m_frame_arena_allocations;
+        mage::rendering::Datacloud::DataHandle<long>        m_frame_arena_bytes;
+        mage::rendering::Datacloud::DataHandle<long>        m_pools_allocations;
+
     };
 }
 
@@ -33,6 +33,8 @@
 #include <functional>
 
 #include <chrono>
+#include <thread>
+#include <algorithm>
 
 #include "aspects.h"
 
@@ -65,6 +67,7 @@
 #include "animators_helpers.h"
 
 #include "datacloud.h"
+#include "exporter.h"
 
 #include "shaders_service.h"
 #include "textures_service.h"
@@ -98,6 +101,10 @@ void Base::init(const std::string p_appWindowsEntityName)
 	sysEngine->makeSystem<mage::AnimationsSystem>(animationsSystemSlot, m_entitygraph);
 	sysEngine->makeSystem<mage::SceneStreamerSystem>(sceneStreamSystemSlot, m_entitygraph);
 
+	// systems with no conflicting data accesses run concurrently
+	const int hw_threads{ static_cast<int>(std::thread::hardware_concurrency()) };
+	sysEngine->setWorkersCount(std::clamp(hw_threads - 1, 0, systemsWorkersMax));
+
 	// D3D11 system provides compilation shader service : give access to this to resources sytem
 	const auto d3d11System{ sysEngine->getSystem<mage::D3D11System>(d3d11SystemSlot) };
 	services::ShadersCompilationService::getInstance()->registerSubscriber(d3d11System->getShaderCompilationInvocationCallback());
@@ -152,6 +159,29 @@ void Base::init(const std::string p_appWindowsEntityName)
 		}
 	}
 
+	// frame pacing stats, published by onFrameEnd()
+	m_frame_time_mean = dataCloud->registerData<double>("mage.infos.frame_time_mean");
+	m_frame_time_variance = dataCloud->registerData<double>("mage.infos.frame_time_variance");
+
+	// allocations stats, published by onFrameEnd()
+	m_frame_arena_allocations = dataCloud->registerData<long>("mage.allocator.frame_arena_allocations");
+	m_frame_arena_bytes = dataCloud->registerData<long>("mage.allocator.frame_arena_bytes");
+	m_pools_allocations = dataCloud->registerData<long>("mage.allocator.pools_allocations");
+
+	// telemetry : shared memory block named after process id, to monitor each running instance (see console_telemetry)
+	const std::string telemetry_name{ "mage_telemetry_" + std::to_string(::GetCurrentProcessId()) };
+	const std::vector<std::string> telemetry_prefixes{ "mage.timings", "mage.infos", "mage.allocator", "mage.resourcesystem", "mage.scenestreamersystem", "mage.d3d11system" };
+
+	auto& eventsLogger{ services::LoggerSharing::getInstance()->getLogger("Events") };
+	if (core::telemetry::Exporter::getInstance()->open(telemetry_name, telemetry_prefixes))
+	{
+		_MAGE_DEBUG(eventsLogger, "telemetry exported to " + telemetry_name);
+	}
+	else
+	{
+		_MAGE_DEBUG(eventsLogger, "cannot create telemetry shared memory " + telemetry_name);
+	}
+
 	//
 	// setup Matrix factories lambdas
 
@@ -36,6 +36,11 @@
 
 
 #include "resourcesystem.h"
+#include "d3d11system.h"
+#include "datacloud.h"
+#include "exporter.h"
+#include "framearena.h"
+#include "pool.h"
 
 using namespace mage;
 using namespace mage::core;
@@ -43,6 +48,9 @@ using namespace mage::rendering;
 
 void Base::run(void)
 {
+	// frame boundary : publish datacloud values updated during previous frame
+	mage::rendering::Datacloud::getInstance()->commitFrame();
+
 	/////////////////////////////////////////////////////
 
 	auto sysEngine{ SystemEngine::getInstance() };
@@ -71,4 +79,44 @@ void Base::run(void)
 			dc.draw = false;
 		}
 	}	
-}
\ No newline at end of file
+}
+
+bool Base::hasPendingWork(void)
+{
+	// datacloud updated outside of frames (runners, external tools...)
+	if (mage::rendering::Datacloud::getInstance()->getUpdatesCount() != m_datacloud_updates_count)
+	{
+		return true;
+	}
+
+	auto sysEngine{ SystemEngine::getInstance() };
+
+	const auto resourceSystem{ sysEngine->getSystem<mage::ResourceSystem>(resourceSystemSlot) };
+	const auto d3d11System{ sysEngine->getSystem<mage::D3D11System>(d3d11SystemSlot) };
+
+	return resourceSystem->hasPendingWork() || d3d11System->hasPendingWork();
+}
+
+void Base::onFrameEnd(const mage::interfaces::FrameStats& p_stats)
+{
+	const auto dataCloud{ mage::rendering::Datacloud::getInstance() };
+
+	dataCloud->updateDataValue(m_frame_time_mean, p_stats.frame_time_mean);
+	dataCloud->updateDataValue(m_frame_time_variance, p_stats.frame_time_variance);
+
+	// frame arena recycled by SystemEngine::run()
+	const auto arena_stats{ core::FrameArena::getInstance()->getLastFrameStats() };
+
+	const size_t pools_allocations_count{ core::PoolsCounters::allocations };
+
+	dataCloud->updateDataValue(m_frame_arena_allocations, static_cast<long>(arena_stats.allocations));
+	dataCloud->updateDataValue(m_frame_arena_bytes, static_cast<long>(arena_stats.bytes));
+	dataCloud->updateDataValue(m_pools_allocations, static_cast<long>(pools_allocations_count - m_pools_allocations_count));
+
+	m_pools_allocations_count = pools_allocations_count;
+
+	core::telemetry::Exporter::getInstance()->publish(static_cast<uint64_t>(p_stats.frames_count));
+
+	// updates done during this frame must not trigger another one
+	m_datacloud_updates_count = dataCloud->getUpdatesCount();
+}
@@ -0,0 +1,181 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+
+namespace mage
+{
+	namespace property
+	{
+		// typed events records, appended to a queue and drained in batches by consumers at their own pace
+		// each consumer has its own read cursor : it receives every record posted since its previous drain, in posting order
+		// records are copied by value : keep them small and trivially copyable (no strings, ids resolved by consumers)
+		// not thread safe : post and drain from threads that can't run concurrently (see SystemEngine scheduling)
+		template<class Record>
+		class EventBus
+		{
+		public:
+
+			using ConsumerId = size_t;
+
+			EventBus() = default;
+			~EventBus() = default;
+
+			// new consumer receives only records posted from now
+			ConsumerId registerConsumer()
+			{
+				for (size_t i = 0; i < m_cursors.size(); i++)
+				{
+					if (unusedCursor == m_cursors[i])
+					{
+						m_cursors[i] = m_records.size();
+						m_consumers_count++;
+						return i;
+					}
+				}
+				m_cursors.push_back(m_records.size());
+				m_consumers_count++;
+				return m_cursors.size() - 1;
+			}
+
+			void unregisterConsumer(ConsumerId p_consumer)
+			{
+				if (unusedCursor != m_cursors.at(p_consumer))
+				{
+					m_cursors[p_consumer] = unusedCursor;
+					m_consumers_count--;
+					compact();
+				}
+			}
+
+			void post(const Record& p_record)
+			{
+				if (0 == m_consumers_count)
+				{
+					return;
+				}
+				m_records.push_back(p_record);
+			}
+
+			size_t getPendingCount(ConsumerId p_consumer) const
+			{
+				return m_records.size() - m_cursors.at(p_consumer);
+			}
+
+			// visitor : void(const Record&)
+			// records posted by the visitor itself are delivered in the same drain
+			template<class Visitor>
+			void drain(ConsumerId p_consumer, Visitor&& p_visitor)
+			{
+				drainIf(p_consumer, [](const Record&) { return true; }, std::forward<Visitor>(p_visitor));
+			}
+
+			// only records which type bit is set in p_types_mask (see typeBit()) : Record must have a 'type' enum member
+			template<class Visitor>
+			void drain(ConsumerId p_consumer, uint64_t p_types_mask, Visitor&& p_visitor)
+			{
+				drainIf(p_consumer, [p_types_mask](const Record& p_record) { return 0 != (p_types_mask & typeBit(p_record.type)); }, std::forward<Visitor>(p_visitor));
+			}
+
+			// filter : bool(const Record&), records rejected by filter are consumed too
+			template<class Filter, class Visitor>
+			void drainIf(ConsumerId p_consumer, Filter&& p_filter, Visitor&& p_visitor)
+			{
+				// index based : visitor may post, reallocating records storage
+				size_t cursor{ m_cursors.at(p_consumer) };
+				for (; cursor < m_records.size(); cursor++)
+				{
+					const Record record{ m_records[cursor] };
+					if (p_filter(record))
+					{
+						p_visitor(record);
+					}
+				}
+				m_cursors[p_consumer] = cursor;
+				compact();
+			}
+
+			template<typename Enum>
+			static constexpr uint64_t typeBit(Enum p_type)
+			{
+				return uint64_t{ 1 } << static_cast<uint64_t>(p_type);
+			}
+
+			template<typename Enum, typename... Others>
+			static constexpr uint64_t typeBit(Enum p_type, Others... p_others)
+			{
+				return typeBit(p_type) | typeBit(p_others...);
+			}
+
+		private:
+
+			static constexpr size_t unusedCursor{ std::numeric_limits<size_t>::max() };
+
+			// storage capacity is kept : no allocation once steady state is reached
+			std::vector<Record>	m_records;
+			std::vector<size_t>	m_cursors;
+			size_t				m_consumers_count{ 0 };
+
+			// drop records read by all consumers, when it's cheap
+			void compact()
+			{
+				size_t min_cursor{ m_records.size() };
+				for (const auto cursor : m_cursors)
+				{
+					if (unusedCursor != cursor)
+					{
+						min_cursor = std::min(min_cursor, cursor);
+					}
+				}
+
+				if (min_cursor == m_records.size())
+				{
+					m_records.clear();
+				}
+				else if (min_cursor > 0 && min_cursor >= m_records.size() / 2)
+				{
+					m_records.erase(m_records.begin(), m_records.begin() + min_cursor);
+				}
+				else
+				{
+					return;
+				}
+
+				for (auto& cursor : m_cursors)
+				{
+					if (unusedCursor != cursor)
+					{
+						cursor -= min_cursor;
+					}
+				}
+			}
+		};
+	}
+}
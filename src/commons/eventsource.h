@@ -41,9 +41,19 @@ namespace mage
 			~EventSource() = default;
 
 			using Callback = std::function<void(Args...)>;
-			virtual void registerSubscriber(const Callback& p_callback)
+			using SubscriberId = size_t;
+
+			virtual SubscriberId registerSubscriber(const Callback& p_callback)
 			{
 				m_callbacks.push_back(p_callback);
+				return m_callbacks.size() - 1;
+			}
+
+			// subscriber must unregister before being destroyed if source outlives it
+			// slot is kept (other ids stay valid), callback becomes a no-op
+			void unregisterSubscriber(SubscriberId p_id)
+			{
+				m_callbacks.at(p_id) = [](Args...) {};
 			}
 
 		protected:
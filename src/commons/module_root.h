@@ -43,7 +43,15 @@ namespace mage
         {
             MOUSE_MODE_CHANGED,
             MOUSE_DISPLAY_CHANGED,
-            CLOSE_APP
+            CLOSE_APP,
+            FRAME_REQUESTED     // on-demand rendering : ask app for a new frame
+        };
+
+        struct FrameStats
+        {
+            long long   frames_count        { 0 };
+            double      frame_time_mean     { 0.0 };    // ms
+            double      frame_time_variance { 0.0 };    // ms^2
         };
 
         class ModuleRoot : public property::EventSource<ModuleEvents, int>
@@ -70,6 +78,12 @@ namespace mage
             virtual void                    run(void) = 0;
             virtual void                    close(void) = 0;
 
+            // on-demand rendering : app renders a frame only on input events, frame requests or if module has still work to do
+            virtual bool                    hasPendingWork(void) { return true; }
+
+            // called by app after each rendered frame
+            virtual void                    onFrameEnd(const FrameStats&) {}
+
         };
     }
 }
\ No newline at end of file
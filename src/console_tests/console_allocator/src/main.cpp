@@ -0,0 +1,213 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <new>
+#include <cstdlib>
+
+#include "componentcontainer.h"
+#include "framearena.h"
+#include "pool.h"
+
+using namespace mage;
+
+// count every heap allocation done in this process
+static std::atomic<size_t> heapAllocations{ 0 };
+
+void* operator new(size_t p_size)
+{
+	heapAllocations++;
+	void* ptr{ std::malloc(p_size ? p_size : 1) };
+	if (!ptr)
+	{
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void operator delete(void* p_ptr) noexcept
+{
+	std::free(p_ptr);
+}
+
+void operator delete(void* p_ptr, size_t) noexcept
+{
+	std::free(p_ptr);
+}
+
+struct Position
+{
+	double x{ 0 }, y{ 0 }, z{ 0 };
+};
+
+struct Velocity
+{
+	double x{ 0 }, y{ 0 }, z{ 0 };
+};
+
+struct Result
+{
+	double	ms{ 0 };
+	size_t	allocations{ 0 };
+};
+
+static constexpr int nbEntities{ 2000 };
+static constexpr int nbFrames{ 200 };
+
+// per-frame work as done by systems : lists of components fetched for each entity, and a few temporary strings
+template<class Func>
+static Result runFrames(const std::vector<std::unique_ptr<core::ComponentContainer>>& p_containers, const Func& p_frame)
+{
+	const size_t allocations_start{ heapAllocations };
+	const auto start{ std::chrono::steady_clock::now() };
+
+	double checksum{ 0 };
+	for (int frame = 0; frame < nbFrames; frame++)
+	{
+		for (const auto& container : p_containers)
+		{
+			checksum += p_frame(*container);
+		}
+		core::FrameArena::getInstance()->reset();
+	}
+
+	const auto end{ std::chrono::steady_clock::now() };
+
+	Result result;
+	result.ms = std::chrono::duration<double, std::milli>(end - start).count();
+	result.allocations = heapAllocations - allocations_start;
+
+	if (checksum < 0)
+	{
+		std::cout << checksum;
+	}
+	return result;
+}
+
+template<class Func>
+static Result runChurn(const Func& p_churn)
+{
+	const size_t allocations_start{ heapAllocations };
+	const auto start{ std::chrono::steady_clock::now() };
+
+	for (int frame = 0; frame < nbFrames; frame++)
+	{
+		p_churn();
+	}
+
+	const auto end{ std::chrono::steady_clock::now() };
+
+	Result result;
+	result.ms = std::chrono::duration<double, std::milli>(end - start).count();
+	result.allocations = heapAllocations - allocations_start;
+	return result;
+}
+
+static void printResult(const std::string& p_title, const Result& p_result)
+{
+	std::cout << "  " << p_title << " : " << p_result.ms << " ms, " << p_result.allocations << " heap allocations ("
+		<< p_result.allocations / nbFrames << " per frame)\n";
+}
+
+int main( int argc, char* argv[] )
+{    
+	std::cout << "Allocators benchmark : " << nbEntities << " entities, " << nbFrames << " frames\n";
+
+	std::vector<std::unique_ptr<core::ComponentContainer>> containers;
+	for (int i = 0; i < nbEntities; i++)
+	{
+		auto container{ std::make_unique<core::ComponentContainer>() };
+		container->addComponent<Position>("position");
+		container->addComponent<Velocity>("velocity");
+		container->addComponent<Velocity>("acceleration");
+		containers.push_back(std::move(container));
+	}
+
+	/////////////////////////////////////////////////////////
+
+	std::cout << "\nPer-frame components lists\n";
+
+	const auto heap_frames{ runFrames(containers, [](const core::ComponentContainer& p_container)
+	{
+		const auto positions{ p_container.getComponentsByType<Position>() };
+		const auto velocities{ p_container.getComponentsByType<Velocity>() };
+		const std::string id{ "entity_position_with_a_long_enough_name" };
+
+		return positions.at(0)->getPurpose().x + velocities.size() + id.size();
+	}) };
+
+	const auto arena_frames{ runFrames(containers, [](const core::ComponentContainer& p_container)
+	{
+		const auto arena{ core::FrameArena::getInstance() };
+		const auto positions{ p_container.getComponentsByType<Position>(arena) };
+		const auto velocities{ p_container.getComponentsByType<Velocity>(arena) };
+		const std::pmr::string id{ "entity_position_with_a_long_enough_name", arena };
+
+		return positions.at(0)->getPurpose().x + velocities.size() + id.size();
+	}) };
+
+	printResult("std::allocator", heap_frames);
+	printResult("frame arena   ", arena_frames);
+
+	const auto arena_stats{ core::FrameArena::getInstance()->getLastFrameStats() };
+	std::cout << "  frame arena last frame : " << arena_stats.allocations << " allocations, " << arena_stats.bytes << " bytes, capacity "
+		<< arena_stats.capacity << " bytes in " << arena_stats.blocks << " block(s)\n";
+
+	/////////////////////////////////////////////////////////
+
+	std::cout << "\nComponents creation/destruction\n";
+
+	std::vector<std::shared_ptr<core::ComponentBase>> components;
+	components.reserve(nbEntities);
+
+	const auto heap_churn{ runChurn([&]()
+	{
+		for (int i = 0; i < nbEntities; i++)
+		{
+			components.push_back(std::make_shared<core::Component<Position>>());
+		}
+		components.clear();
+	}) };
+
+	const auto pool_churn{ runChurn([&]()
+	{
+		for (int i = 0; i < nbEntities; i++)
+		{
+			components.push_back(std::allocate_shared<core::Component<Position>>(core::PoolAllocator<core::Component<Position>>()));
+		}
+		components.clear();
+	}) };
+
+	printResult("make_shared   ", heap_churn);
+	printResult("pool          ", pool_churn);
+
+	std::cout << "  pools allocations : " << core::PoolsCounters::allocations << ", deallocations : " << core::PoolsCounters::deallocations << "\n";
+
+	return 0;
+}
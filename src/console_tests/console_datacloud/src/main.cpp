@@ -24,6 +24,7 @@
 /* -*-LIC_END-*- */
 
 #include <iostream>
+#include <string>
 
 #include "datacloud.h"
 #include "tvector.h"
@@ -65,7 +66,8 @@ int main( int argc, char* argv[] )
 
 		
 
-	dataCloud->registerData<Real4Vector>("mycolor");
+	const auto mycolorHandle{ dataCloud->registerData<Real4Vector>("mycolor") };
+	dataCloud->commitFrame();
 
 	{
 		const auto mycolorVal{ dataCloud->readDataValue<Real4Vector>("mycolor") };
@@ -79,6 +81,57 @@ int main( int argc, char* argv[] )
 		std::cout << "mycolor = " << mycolorVal[0] << " " << mycolorVal[1] << " " << mycolorVal[2] << " " << mycolorVal[3] << "\n";
 	}
 
+	// handle read : snapshot not published until frame commit
+	dataCloud->updateDataValue(mycolorHandle, Real4Vector(0.9, 0.8, 0.7, 1.0));
+	{
+		const auto& mycolorVal{ mycolorHandle.read() };
+		std::cout << "mycolor (handle, before commit) = " << mycolorVal[0] << " " << mycolorVal[1] << " " << mycolorVal[2] << " " << mycolorVal[3] << "\n";
+	}
+
+	dataCloud->commitFrame();
+	{
+		const auto& mycolorVal{ mycolorHandle.read() };
+		std::cout << "mycolor (handle, after commit) = " << mycolorVal[0] << " " << mycolorVal[1] << " " << mycolorVal[2] << " " << mycolorVal[3] << "\n";
+	}
+
+	// removed variable : event still refers to its id and type when dispatched
+	dataCloud->removeData<Real4Vector>("mycolor");
+	std::cout << "mycolor exists after remove : " << dataCloud->hasData("mycolor") << ", handle valid : " << mycolorHandle.isValid() << "\n";
+	dataCloud->commitFrame();
+	std::cout << "mycolor handle valid after commit : " << mycolorHandle.isValid() << "\n";
+
+	// no frame loop : pending events beyond cap are dropped, oldest ones kept
+	{
+		mage::rendering::Datacloud localCloud;
+
+		int nb_added{ 0 };
+		int nb_removed{ 0 };
+		std::string first_added;
+		localCloud.registerSubscriber([&](mage::rendering::DatacloudEvent p_event, const std::string& p_id, const std::string&)
+		{
+			if (mage::rendering::DatacloudEvent::DATA_ADDED == p_event)
+			{
+				if (0 == nb_added++)
+				{
+					first_added = p_id;
+				}
+			}
+			else if (mage::rendering::DatacloudEvent::DATA_REMOVED == p_event)
+			{
+				nb_removed++;
+			}
+		});
+
+		for (int i = 0; i < 5000; i++)
+		{
+			localCloud.registerData<long>("var" + std::to_string(i));
+		}
+		// DATA_ADDED record of var0 still pending
+		localCloud.removeData<long>("var0");
+		localCloud.commitFrame();
+
+		std::cout << "capped events : added " << nb_added << ", removed " << nb_removed << ", first added : " << first_added << "\n";
+	}
 
     return 0;
 }
@@ -24,12 +24,17 @@
 /* -*-LIC_END-*- */
 
 #include <iostream>
+#include <chrono>
+#include <thread>
+#include <string>
 
 #include "entitygraph.h"
 #include "entity.h"
 #include "aspects.h"
 #include "system.h"
 #include "sysengine.h"
+#include "systemscheduler.h"
+#include "commandbuffer.h"
 
 using namespace mage;
 
@@ -44,6 +49,67 @@ public:
 	}
 };
 
+class ProbeSystem : public core::System
+{
+public:
+	ProbeSystem(core::Entitygraph& p_entitygraph, const std::vector<std::pair<int, core::SystemAccess>>& p_accesses) : System(p_entitygraph)
+	{
+		for (const auto& e : p_accesses)
+		{
+			declareAccess(e.first, e.second);
+		}
+	}
+
+	void run()
+	{
+		m_thread = std::this_thread::get_id();
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	}
+
+	std::thread::id m_thread;
+};
+
+// changes graph structure in run(), as application callbacks fired by D3D11System or AnimationsSystem do
+class GraphBuilderSystem : public core::System
+{
+public:
+	GraphBuilderSystem(core::Entitygraph& p_entitygraph) : System(p_entitygraph)
+	{
+		declareAccess(core::renderingAspect::id, core::SystemAccess::WRITE);
+		declareExclusive();
+	}
+
+	void run()
+	{
+		for (int i = 0; i < 100; i++)
+		{
+			m_entitygraph.add(m_entitygraph.node("root"), "clock" + std::to_string(m_nb_entities++)).data()->makeAspect(core::timeAspect::id);
+		}
+	}
+
+	int m_nb_entities{ 0 };
+};
+
+class TimeReaderSystem : public core::System
+{
+public:
+	TimeReaderSystem(core::Entitygraph& p_entitygraph) : System(p_entitygraph)
+	{
+		declareAccess(core::timeAspect::id, core::SystemAccess::READ);
+	}
+
+	void run()
+	{
+		m_seen = 0;
+		for (const auto& e : m_entitygraph.getEntitiesListForAspect(core::timeAspect::id))
+		{
+			m_seen += e->hasAspect(core::timeAspect::id);
+		}
+	}
+
+	int m_seen{ 0 };
+};
+
 int main( int argc, char* argv[] )
 {    
 	std::cout << "ECS tests\n";
@@ -220,10 +286,266 @@ int main( int argc, char* argv[] )
 		}
 		std::cout << "\n";
 
+		std::cout << "////////////////////////////////////\n\n";
+		std::cout << "move_subtree test\n";
+
+		eg.add(eg.node("ent2"), "ent22");
+		eg.move_subtree(eg.node("ent22"), eg.node("ent1"));
+
+		// root to leaf browsing
+		for (auto it = eg.preBegin(); it != eg.preEnd(); ++it)
+		{
+			const auto currId{ it->data()->getId() };
+
+			for (int i = 0; i < it->data()->getDepth(); i++) std::cout << " ";
+			std::cout << currId << "\n";
+		}
+		std::cout << "\n";
+
+		std::cout << "removeSubtree test\n";
+
+		eg.node("ent111").data()->makeAspect(core::teapotAspect::id);
+		eg.removeSubtree("ent22");
+
+		// root to leaf browsing
+		for (auto it = eg.preBegin(); it != eg.preEnd(); ++it)
+		{
+			const auto currId{ it->data()->getId() };
+
+			for (int i = 0; i < it->data()->getDepth(); i++) std::cout << " ";
+			std::cout << currId << "\n";
+		}
+		std::cout << "ent111 still exists : " << eg.hasNode("ent111") << ", teapot entities : " << eg.getEntitiesListForAspect(core::teapotAspect::id).size() << "\n\n";
+
+		std::cout << "entity handles test\n";
+
+		const auto ent3_handle{ eg.add(eg.node("ent2"), "ent3").data()->getHandle() };
+		std::cout << "ent3 handle valid : " << eg.isValid(ent3_handle) << ", id : " << eg.getEntity(ent3_handle)->getId() << "\n";
+
+		eg.remove("ent3");
+		std::cout << "ent3 handle valid after remove : " << eg.isValid(ent3_handle) << "\n";
+
+		// slot reused, with another generation
+		const auto ent4_handle{ eg.add(eg.node("ent2"), "ent4").data()->getHandle() };
+		std::cout << "ent4 slot : " << ent4_handle.index << " (ent3 slot : " << ent3_handle.index << "), ent3 handle valid : " << eg.isValid(ent3_handle) << "\n\n";
+
 		//////////////
 		// check we can have void returned list
 		auto animated_entities{ eg.getEntitiesListForAspect(core::animationsAspect::id) }; // animated_entities size is : 0
 
 	}
+
+	///// systems scheduling
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+
+	{
+		std::cout << "////////////////////////////////////\n\n";
+		std::cout << "systems scheduler test\n";
+
+		core::Entitygraph eg;
+
+		ProbeSystem time_sys(eg, { { core::timeAspect::id, core::SystemAccess::WRITE } });
+		ProbeSystem world_sys(eg, { { core::timeAspect::id, core::SystemAccess::READ }, { core::worldAspect::id, core::SystemAccess::WRITE } });
+		ProbeSystem resources_sys(eg, { { core::resourcesAspect::id, core::SystemAccess::WRITE } });
+		ProbeSystem undeclared_sys(eg, {});
+
+		core::SystemScheduler scheduler;
+		scheduler.build({ { 0, &time_sys }, { 1, &world_sys }, { 2, &resources_sys }, { 3, &undeclared_sys } });
+
+		for (int slot = 0; slot < 4; slot++)
+		{
+			std::cout << "slot " << slot << " waits for :";
+			for (const auto dep : scheduler.getDependencies(slot))
+			{
+				std::cout << " " << dep;
+			}
+			std::cout << "\n";
+		}
+
+		for (int workers : { 0, 2 })
+		{
+			scheduler.setWorkersCount(workers);
+
+			const auto start{ std::chrono::steady_clock::now() };
+			scheduler.run();
+			const auto ms{ std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count() };
+
+			std::cout << workers << " workers : " << ms << " ms, time and resources systems on same thread : " << (time_sys.m_thread == resources_sys.m_thread) << "\n";
+		}
+		std::cout << "\n";
+	}
+
+	{
+		std::cout << "////////////////////////////////////\n\n";
+		std::cout << "exclusive systems scheduler test\n";
+
+		core::Entitygraph eg;
+		eg.makeRoot("root");
+
+		GraphBuilderSystem builder_sys(eg);
+		TimeReaderSystem reader_sys(eg);
+
+		core::SystemScheduler scheduler;
+		scheduler.build({ { 0, &builder_sys }, { 1, &reader_sys } });
+		scheduler.setWorkersCount(2);
+
+		std::cout << "reader waits for builder : " << scheduler.getDependencies(1).size() << "\n";
+
+		for (int frame = 0; frame < 3; frame++)
+		{
+			scheduler.run();
+			std::cout << "frame " << frame << ", time entities seen by reader : " << reader_sys.m_seen << "\n";
+		}
+		std::cout << "\n";
+	}
+
+	///// deferred structural changes
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+
+	{
+		std::cout << "////////////////////////////////////\n\n";
+		std::cout << "command buffers test\n";
+
+		core::Entitygraph eg;
+		eg.makeRoot("root");
+
+		core::CommandBuffer commands0(eg);
+		core::CommandBuffer commands1(eg);
+
+		std::thread thread0([&]()
+		{
+			commands0.addEntity("root", "a");
+			commands0.addComponent<std::string>("a", core::teapotAspect::id, "name", "built by thread 0");
+		});
+
+		std::thread thread1([&]()
+		{
+			commands1.addEntity("root", "b");
+			commands1.addEntity("b", "b1");
+			commands1.addComponent<int>("b1", core::teapotAspect::id, "value", 42);
+		});
+
+		thread0.join();
+		thread1.join();
+
+		std::cout << "before apply, a exists : " << eg.hasNode("a") << ", recorded commands : " << commands0.size() + commands1.size() << "\n";
+
+		// merge order doesn't depend on threads completion order
+		commands0.append(std::move(commands1));
+		commands0.apply();
+
+		for (auto it = eg.preBegin(); it != eg.preEnd(); ++it)
+		{
+			for (int i = 0; i < it->data()->getDepth(); i++) std::cout << " ";
+			std::cout << it->data()->getId() << "\n";
+		}
+
+		const auto& a_teapot{ eg.node("a").data()->aspectAccess(core::teapotAspect::id) };
+		const auto& b1_teapot{ eg.node("b1").data()->aspectAccess(core::teapotAspect::id) };
+		std::cout << "a name : " << a_teapot.getComponent<std::string>("name")->getPurpose() << ", b1 value : " << b1_teapot.getComponent<int>("value")->getPurpose() << "\n";
+
+		commands0.removeAspect("b1", core::teapotAspect::id);
+		commands0.apply();
+
+		std::cout << "after removeAspect, b1 has teapot aspect : " << eg.node("b1").data()->hasAspect(core::teapotAspect::id) << ", teapot entities : " << eg.getEntitiesListForAspect(core::teapotAspect::id).size() << "\n\n";
+	}
+
+	///// entitygraph events bus
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+
+	{
+		std::cout << "////////////////////////////////////\n\n";
+		std::cout << "entitygraph events bus test\n";
+
+		core::Entitygraph eg;
+		auto& bus{ eg.getEventBus() };
+
+		const auto all_events{ bus.registerConsumer() };
+		const auto removals_only{ bus.registerConsumer() };
+
+		eg.makeRoot("root");
+		eg.add(eg.node("root"), "a");
+		eg.add(eg.node("a"), "a1");
+		const auto b_handle{ eg.add(eg.node("root"), "b").data()->getHandle() };
+
+		std::cout << "pending before drain : " << bus.getPendingCount(all_events) << "\n";
+
+		// records delivered in posting order, entities still alive can be resolved through handle
+		bus.drain(all_events, [&](const core::EntitygraphEvent& p_event)
+		{
+			const auto entity{ eg.getEntity(p_event.handle) };
+			std::cout << " event " << static_cast<int>(p_event.type) << " : " << (entity ? entity->getId() : "<removed>") << "\n";
+		});
+
+		eg.removeSubtree("a");
+		eg.remove("b");
+
+		const auto removed_mask{ property::EventBus<core::EntitygraphEvent>::typeBit(core::EntitygraphEvents::ENTITYGRAPHNODE_REMOVED) };
+
+		int removed_count{ 0 };
+		bus.drain(removals_only, removed_mask, [&](const core::EntitygraphEvent&)
+		{
+			removed_count++;
+		});
+		std::cout << "removed entities : " << removed_count << ", b handle valid : " << eg.isValid(b_handle) << "\n";
+
+		std::cout << "pending for first consumer : " << bus.getPendingCount(all_events) << ", for second consumer : " << bus.getPendingCount(removals_only) << "\n";
+
+		bus.unregisterConsumer(all_events);
+		bus.unregisterConsumer(removals_only);
+		eg.add(eg.node("root"), "c");
+		std::cout << "no consumer, records stored : " << bus.getPendingCount(bus.registerConsumer()) << "\n\n";
+	}
+
+	///// entities commit
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+
+	{
+		std::cout << "////////////////////////////////////\n\n";
+		std::cout << "entities commit test\n";
+
+		core::Entitygraph eg;
+		auto& bus{ eg.getEventBus() };
+		const auto consumer{ bus.registerConsumer() };
+
+		const auto mask{ property::EventBus<core::EntitygraphEvent>::typeBit(core::EntitygraphEvents::ENTITYGRAPHNODE_COMMITTED, core::EntitygraphEvents::ENTITYGRAPHNODE_ASPECT_ADDED) };
+		const auto dump{ [&](const core::EntitygraphEvent& p_event)
+		{
+			if (core::EntitygraphEvents::ENTITYGRAPHNODE_COMMITTED == p_event.type)
+			{
+				std::cout << " committed : " << p_event.entity->getId() << ", has teapot aspect : " << p_event.entity->hasAspect(core::teapotAspect::id) << "\n";
+			}
+			else
+			{
+				std::cout << " aspect " << p_event.aspect << " added to : " << p_event.entity->getId() << "\n";
+			}
+		} };
+
+		eg.makeRoot("root");
+		eg.add(eg.node("root"), "a").data()->makeAspect(core::teapotAspect::id);
+		eg.add(eg.node("root"), "b");
+
+		// explicit commit, at end of entity construction
+		eg.commit("a");
+		bus.drain(consumer, mask, dump);
+
+		// others are committed in a batch (by SystemEngine, each frame), a entity not committed twice
+		eg.commitPending();
+		eg.commit("a");
+		bus.drain(consumer, mask, dump);
+
+		// aspect made on committed entity
+		eg.node("b").data()->makeAspect(core::teapotAspect::id);
+		bus.drain(consumer, mask, dump);
+		std::cout << "\n";
+	}
     return 0;
 }
@@ -33,6 +33,7 @@
 #include "logging.h"
 
 static mage::core::logger::Sink appLogger("MyTestApp", mage::core::logger::Configuration::getInstance());
+static mage::core::logger::Sink appLoggerAsync("MyTestAppAsync", mage::core::logger::Configuration::getInstance());
 
 int main( int argc, char* argv[] )
 {    
@@ -55,6 +56,16 @@ int main( int argc, char* argv[] )
 		_MAGE_TRACE(appLogger, "trace log with another value : " << 42 );
 
 		_MAGE_WARN(appLogger, "this is a warning : " << 3.1415 );
+
+		// disabled level : message not built
+		appLogger.setCurrentLevel(mage::core::logger::Sink::Level::LEVEL_WARN);
+		_MAGE_TRACE(appLogger, "never built : " << 42);
+
+		for (int i = 0; i < 20000; i++)
+		{
+			_MAGE_DEBUG(appLoggerAsync, "async log burst : " << i);
+		}
+		std::cout << "async output dropped records : " << mage::core::logger::Configuration::getInstance()->getDroppedRecordsCount() << "\n";
 	}
 	catch (const std::exception& e)
 	{
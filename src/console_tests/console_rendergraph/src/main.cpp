@@ -0,0 +1,182 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "rendergraphcompiler.h"
+#include "headlessrendergraphbackend.h"
+
+using namespace mage;
+using namespace mage::rendering;
+
+static constexpr int width{ 1280 };
+static constexpr int height{ 720 };
+
+// same layout as rendergraphs/json/open_env_rendergraph.json, plus a shadow map and an unused debug channel
+static void build_open_env_rendergraph(RendergraphCompiler& p_compiler, bool p_ambient_and_emissive_combiner)
+{
+	p_compiler.clear();
+
+	p_compiler.addTarget({ "fog_input_0", Texture::Format::TEXTURE_RGB, width, height });
+	p_compiler.addTarget({ "fog_input_1", Texture::Format::TEXTURE_FLOAT32, width, height });
+	p_compiler.addTarget({ "modulate_input_0", Texture::Format::TEXTURE_RGB, width, height });
+	p_compiler.addTarget({ "modulate_input_1", Texture::Format::TEXTURE_RGB, width, height });
+	p_compiler.addTarget({ "add_input_0", Texture::Format::TEXTURE_RGB, width, height });
+	p_compiler.addTarget({ "add_input_1", Texture::Format::TEXTURE_RGB, width, height });
+	p_compiler.addTarget({ "add_input_2", Texture::Format::TEXTURE_RGB, width, height });
+	p_compiler.addTarget({ "normals_debug", Texture::Format::TEXTURE_RGB, width, height });
+	p_compiler.addTarget({ "shadowmap", Texture::Format::TEXTURE_FLOAT32, 2048, 2048, true });
+
+	p_compiler.addPass({ "Fog_queue", { "fog_input_0", "fog_input_1" }, "" });
+
+	if (p_ambient_and_emissive_combiner)
+	{
+		p_compiler.addPass({ "ModulateFogAndLitTextures_queue", { "modulate_input_0", "modulate_input_1" }, "fog_input_0" });
+	}
+	else
+	{
+		// combiner quad disabled : lit channels not read anymore
+		p_compiler.addPass({ "ModulateFogAndLitTextures_queue", { "modulate_input_0" }, "fog_input_0" });
+	}
+
+	p_compiler.addPass({ "TextureChannelScene_Entity", {}, "modulate_input_0" });
+	p_compiler.addPass({ "AddAmbientAndEmissive_queue", { "add_input_0", "add_input_1", "add_input_2" }, "modulate_input_1" });
+	p_compiler.addPass({ "AmbientLitChannelScene_Entity", {}, "add_input_0" });
+	p_compiler.addPass({ "EmissiveLitChannelScene_Entity", {}, "add_input_1" });
+	p_compiler.addPass({ "DirectionalLitChannelScene_Entity", { "shadowmap" }, "add_input_2" });
+	p_compiler.addPass({ "ZdepthChannelScene_Entity", {}, "fog_input_1" });
+	p_compiler.addPass({ "NormalsDebugChannelScene_Entity", {}, "normals_debug" });
+	p_compiler.addPass({ "ShadowMapChannelScene_Entity", {}, "shadowmap" });
+}
+
+static bool check(bool p_condition, const std::string& p_descr)
+{
+	std::cout << (p_condition ? "OK   : " : "FAIL : ") << p_descr << "\n";
+	return p_condition;
+}
+
+int main(int argc, char* argv[])
+{
+	std::cout << "Rendergraph compiler test\n";
+
+	bool success{ true };
+
+	try
+	{
+		RendergraphCompiler compiler;
+		HeadlessRendergraphBackend backend;
+
+		/////////////// full rendergraph
+
+		build_open_env_rendergraph(compiler, true);
+
+		const auto result{ compiler.compile() };
+		std::cout << result.report();
+
+		backend.execute(compiler, result);
+
+		const auto position
+		{
+			[&](const std::string& p_pass)
+			{
+				const auto& executed{ backend.getExecutedPasses() };
+				return std::find(executed.begin(), executed.end(), p_pass) - executed.begin();
+			}
+		};
+
+		success &= check(result.culled_passes == std::vector<std::string>{ "NormalsDebugChannelScene_Entity" }, "unused debug channel culled");
+		success &= check(backend.getExecutedPasses().size() == 9, "9 passes executed");
+		success &= check(position("AmbientLitChannelScene_Entity") < position("AddAmbientAndEmissive_queue"), "lit channel before its combiner");
+		success &= check(position("AddAmbientAndEmissive_queue") < position("ModulateFogAndLitTextures_queue"), "combiners order");
+		success &= check(position("ShadowMapChannelScene_Entity") < position("DirectionalLitChannelScene_Entity"), "shadow map before directional lit channel");
+		success &= check(position("Fog_queue") == 8, "screen pass last");
+		success &= check(result.targets_allocation.at("add_input_0") == result.targets_allocation.at("fog_input_0"), "add_input_0 aliased with fog_input_0");
+		success &= check(result.pool.size() < compiler.getTargets().size(), "targets pooled");
+		success &= check(result.allocated_bytes < result.declared_bytes, "memory saved");
+
+		/////////////// ambient/emissive combiner disabled
+
+		std::cout << "\n";
+		build_open_env_rendergraph(compiler, false);
+
+		const auto result2{ compiler.compile() };
+		std::cout << result2.report();
+
+		backend.execute(compiler, result2);
+
+		success &= check(result2.culled_passes.size() == 5, "combiner and its 3 lit channels culled with debug channel");
+		success &= check(result2.allocated_bytes < result.allocated_bytes, "less memory with culled passes");
+
+		/////////////// errors
+
+		std::cout << "\n";
+
+		compiler.clear();
+		compiler.addTarget({ "a", Texture::Format::TEXTURE_RGB, width, height });
+		compiler.addTarget({ "b", Texture::Format::TEXTURE_RGB, width, height });
+		compiler.addPass({ "screen", { "a" }, "" });
+		compiler.addPass({ "pass_a", { "b" }, "a" });
+		compiler.addPass({ "pass_b", { "a" }, "b" });
+
+		bool cycle_detected{ false };
+		try
+		{
+			compiler.compile();
+		}
+		catch (const std::exception&)
+		{
+			cycle_detected = true;
+		}
+		success &= check(cycle_detected, "dependency cycle detected");
+
+		// wrong allocation : aliasing a target still to be read
+		build_open_env_rendergraph(compiler, true);
+
+		auto wrong_result{ compiler.compile() };
+		wrong_result.targets_allocation["modulate_input_1"] = wrong_result.targets_allocation.at("modulate_input_0");
+
+		bool overwrite_detected{ false };
+		try
+		{
+			backend.execute(compiler, wrong_result);
+		}
+		catch (const std::exception&)
+		{
+			overwrite_detected = true;
+		}
+		success &= check(overwrite_detected, "headless backend detects overwritten target");
+	}
+	catch (const std::exception& e)
+	{
+		std::cout << "exception : " << e.what() << "\n";
+		success = false;
+	}
+
+	std::cout << (success ? "\nALL TESTS PASSED\n" : "\nSOME TESTS FAILED\n");
+	return success ? 0 : 1;
+}
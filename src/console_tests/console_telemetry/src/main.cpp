@@ -0,0 +1,151 @@
+
+/* -*-LIC_BEGIN-*- */
+/*
+*
+* MaGE rendering framework
+* Emmanuel Chaumont Copyright (c) 2013-2026
+*
+* This file is part of MaGE.
+*
+*    MaGE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    MaGE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with MaGE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*/
+/* -*-LIC_END-*- */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+
+#include "reader.h"
+
+using namespace mage::core::telemetry;
+
+// usage : console_telemetry <shared block name> [channel filter]
+// print last value, min/avg/max over the last period and a small history graph of each channel, then new events
+
+static constexpr int historySize{ 40 };
+
+static std::string graph(const std::deque<double>& p_history)
+{
+	static const std::string levels{ " .:-=+*#%@" };
+
+	if (p_history.empty())
+	{
+		return "";
+	}
+
+	const auto minmax{ std::minmax_element(p_history.begin(), p_history.end()) };
+	const double range{ *minmax.second - *minmax.first };
+
+	std::string out;
+	for (const auto v : p_history)
+	{
+		const int level{ range > 0.0 ? static_cast<int>((v - *minmax.first) / range * (levels.size() - 1)) : 0 };
+		out += levels[level];
+	}
+	return out;
+}
+
+int main( int argc, char* argv[] )
+{
+	if (argc < 2)
+	{
+		std::cout << "usage : console_telemetry <shared block name> [channel filter]\n";
+		return 1;
+	}
+
+	const std::string name{ argv[1] };
+	const std::string filter{ argc > 2 ? argv[2] : "" };
+
+	Reader reader;
+	while (!reader.open(name))
+	{
+		std::cout << "waiting for " << name << "...\n";
+		std::this_thread::sleep_for(std::chrono::seconds(1));
+	}
+
+	uint64_t next_frame{ 0 };
+	uint64_t next_event{ 0 };
+
+	std::vector<std::deque<double>> histories;
+
+	while (1)
+	{
+		const auto names{ reader.getChannelsNames() };
+		histories.resize(names.size());
+
+		std::vector<double> mins(names.size(), 0.0);
+		std::vector<double> maxs(names.size(), 0.0);
+		std::vector<double> sums(names.size(), 0.0);
+		std::vector<double> lasts(names.size(), 0.0);
+		uint64_t last_frame{ 0 };
+		bool first{ true };
+
+		const auto nb_frames{ reader.readFrames(next_frame, [&](uint64_t p_frame, int64_t p_timestamp_ns, const double* p_values, size_t p_count)
+		{
+			const size_t count{ std::min(p_count, names.size()) };
+			for (size_t i = 0; i < count; i++)
+			{
+				const double v{ p_values[i] };
+				mins[i] = first ? v : std::min(mins[i], v);
+				maxs[i] = first ? v : std::max(maxs[i], v);
+				sums[i] += v;
+				lasts[i] = v;
+			}
+			last_frame = p_frame;
+			first = false;
+		}) };
+
+		if (nb_frames > 0)
+		{
+			std::cout << "\n==== " << name << " frame " << last_frame << " (" << nb_frames << " frames read)\n";
+
+			for (size_t i = 0; i < names.size(); i++)
+			{
+				if (!filter.empty() && std::string::npos == names[i].find(filter))
+				{
+					continue;
+				}
+
+				auto& history{ histories[i] };
+				history.push_back(lasts[i]);
+				if (history.size() > historySize)
+				{
+					history.pop_front();
+				}
+
+				std::cout << std::left << std::setw(48) << names[i] << std::right << std::fixed << std::setprecision(3)
+					<< std::setw(12) << lasts[i]
+					<< "  min " << std::setw(10) << mins[i]
+					<< "  avg " << std::setw(10) << sums[i] / nb_frames
+					<< "  max " << std::setw(10) << maxs[i]
+					<< "  |" << graph(history) << "|\n";
+			}
+		}
+
+		reader.readEvents(next_event, [&](uint64_t p_frame, const std::string& p_text)
+		{
+			std::cout << "[frame " << p_frame << "] " << p_text << "\n";
+		});
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(250));
+	}
+
+	return 0;
+}
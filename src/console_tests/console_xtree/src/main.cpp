@@ -27,6 +27,7 @@
 #include <string>
 #include <map>
 #include "xtree.h"
+#include "linearxtree.h"
 
 using namespace mage::core;
 
@@ -107,10 +108,59 @@ void print_neighbours(OctreeNode<std::string>* node)
 }
 
 
+void linear_xtree_test()
+{
+	std::cout << "LinearXTree test\n";
+
+	LinearOctree<std::string> octree;
+	octree.configure({ -100.0, -100.0, -100.0 }, 200.0, 6);
+
+	// codes round trip
+	bool roundtrip_ok{ true };
+	for (uint32_t x = 0; x < 64; x += 7)
+	{
+		for (uint32_t y = 0; y < 64; y += 5)
+		{
+			for (uint32_t z = 0; z < 64; z += 3)
+			{
+				const auto code{ LinearOctree<std::string>::encode({ x, y, z }, 6) };
+				const auto coords{ LinearOctree<std::string>::decode(code) };
+				roundtrip_ok = roundtrip_ok && coords[0] == x && coords[1] == y && coords[2] == z && 6 == LinearOctree<std::string>::depthOf(code);
+			}
+		}
+	}
+	std::cout << "encode/decode round trip : " << roundtrip_ok << "\n";
+
+	const auto leaf{ octree.locate({ 10.0, -20.0, 99.0 }) };
+	const auto leaf_min{ octree.cellMin(leaf) };
+	std::cout << "leaf depth " << LinearOctree<std::string>::depthOf(leaf) << " side " << octree.cellSideLength(leaf) << " min " << leaf_min[0] << " " << leaf_min[1] << " " << leaf_min[2] << "\n";
+	std::cout << "outside : " << (LinearOctree<std::string>::invalidCode == octree.locate({ 0.0, 0.0, 100.0 })) << "\n";
+	std::cout << "parent of leaf contains point : " << octree.contains(LinearOctree<std::string>::parentOf(leaf), { 10.0, -20.0, 99.0 }) << "\n";
+	std::cout << "z+ neighbour of border leaf : " << (LinearOctree<std::string>::invalidCode == LinearOctree<std::string>::neighbourOf(leaf, 2, 1)) << "\n";
+
+	// sparse : only occupied nodes exist
+	octree.nodeAccess(leaf) = "leaf";
+	octree.nodeAccess(LinearOctree<std::string>::neighbourOf(leaf, 0, 1)) = "x+1";
+	octree.nodeAccess(LinearOctree<std::string>::neighbourOf(LinearOctree<std::string>::neighbourOf(leaf, 0, 1), 1, -1)) = "x+1 y-1";
+	octree.nodeAccess(LinearOctree<std::string>::neighbourOf(leaf, 0, -3)) = "x-3";
+	octree.nodeAccess(LinearOctree<std::string>::rootCode) = "root";
+	std::cout << "nodes count : " << octree.getNodesCount() << "\n";
+
+	octree.forEachNodeAround(leaf, 2, [](LinearOctree<std::string>::Code, const std::string& p_data)
+	{
+		std::cout << " around leaf (radius 2) : " << p_data << "\n";
+	});
+
+	std::cout << "object depth for size 20 (ratio 0.1) : " << octree.depthForSize(20.0, 0.1) << "\n";
+	std::cout << "object depth for size 0.001 (ratio 0.1) : " << octree.depthForSize(0.001, 0.1) << "\n\n";
+}
+
 int main( int argc, char* argv[] )
 {    
 	std::cout << "XTree test !\n";
 
+	linear_xtree_test();
+
 	
 	QuadTreeNode<std::string> root("root");
 
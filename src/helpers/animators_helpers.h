@@ -81,7 +81,7 @@ namespace mage
 					if (std::abs(fps_speed) > 0.0)
 					{
 						const auto tc{ core::TimeControl::getInstance() };
-						const auto sync_fps_speed{ fps_speed / tc->getInstance()->getFPS() };
+						const auto sync_fps_speed{ fps_speed * tc->getFrameDeltaSeconds() };
 
 						//project speed vector in global coords
 
@@ -182,7 +182,7 @@ namespace mage
 					if (std::abs(speed) > 0.0)
 					{
 						const auto tc{ core::TimeControl::getInstance() };
-						const auto sync_speed{ speed / tc->getInstance()->getFPS() };
+						const auto sync_speed{ speed * tc->getFrameDeltaSeconds() };
 
 
 						//project speed vector in global coords
@@ -84,7 +84,11 @@ std::unordered_map<std::string, Entity*> RenderingChannels::registerToQueues(mag
 		
 		///// link triangle meshe to related entity in scenegraph side 
 		const auto& base_entity_resource_aspect{ p_entity->aspectAccess(core::resourcesAspect::id) };
-		auto* meshe_ref{ &base_entity_resource_aspect.getComponent<std::pair<std::pair<std::string, std::string>, TriangleMeshe>>("meshe")->getPurpose() };
+		auto* meshe_ref{ p_channelsRendering.meshe_ref };
+		if (nullptr == meshe_ref)
+		{
+			meshe_ref = &base_entity_resource_aspect.getComponent<std::pair<std::pair<std::string, std::string>, TriangleMeshe>>("meshe")->getPurpose();
+		}
 
 		proxy_entity_resource_aspect.addComponent<std::pair<std::pair<std::string, std::string>, TriangleMeshe>*>("meshe_ref", meshe_ref);
 
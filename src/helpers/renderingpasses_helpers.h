@@ -43,6 +43,8 @@ namespace mage
 		class Entity;
 	};
 
+	class TriangleMeshe;
+
 	namespace helpers
 	{
 		struct ChannelConfig
@@ -73,6 +75,9 @@ namespace mage
 			std::unordered_map< std::string, ChannelConfig>										configs;
 			std::unordered_map<std::string, std::vector<std::pair<std::string, std::string>>>	vertex_shaders_params;
 			std::unordered_map<std::string, std::vector<std::pair<std::string, std::string>>>	pixel_shaders_params;
+
+			// meshe to link to proxies; if nullptr, entity "meshe" component is used
+			std::pair<std::pair<std::string, std::string>, TriangleMeshe>*						meshe_ref{ nullptr };
 		};
 
 		// rendering passes helper struct
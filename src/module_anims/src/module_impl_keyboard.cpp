@@ -35,6 +35,7 @@
 #include "syncvariable.h"
 #include "entitygraph_helpers.h"
 #include "timecontrol.h"
+#include "profiler.h"
 
 using namespace mage;
 using namespace mage::core;
@@ -212,6 +213,22 @@ void ModuleImpl::onEndKeyPress(long p_key)
 		helpers::logEntitygraph(m_entitygraph, true);
 	}
 
+	else if (VK_F10 == p_key)
+	{
+		// profiler capture start/stop, trace exported when stopped
+		auto profilerInstance{ profiler::Profiler::getInstance() };
+		if (profilerInstance->isCapturing())
+		{
+			profilerInstance->stopCapture();
+			profilerInstance->exportChromeTrace("profiler_capture.json");
+			_MAGE_DEBUG(eventsLogger, "profiler capture exported to profiler_capture.json");
+		}
+		else
+		{
+			profilerInstance->startCapture();
+		}
+	}
+
 	else if ('Q' == p_key)
 	{
 		if ("camera_Entity" == mainView)
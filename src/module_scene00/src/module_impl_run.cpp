@@ -54,6 +54,9 @@ void ModuleImpl::run(void)
 
 	const auto dataCloud{ mage::rendering::Datacloud::getInstance() };
 
+	// frame boundary : publish datacloud values updated during previous frame
+	dataCloud->commitFrame();
+
 	/////////////////////////////////////////////////////
 
 	auto sysEngine{ SystemEngine::getInstance() };
@@ -37,6 +37,7 @@
 #include "syncvariable.h"
 #include "entitygraph_helpers.h"
 #include "timecontrol.h"
+#include "profiler.h"
 
 using namespace mage;
 using namespace mage::core;
@@ -242,6 +243,22 @@ void ModuleImpl::onEndKeyPress(long p_key)
 		::MessageBox(0, "Log dump done", "Mage", MB_OK | MB_ICONINFORMATION);
 	}
 
+	else if (VK_F10 == p_key)
+	{
+		// profiler capture start/stop, trace exported when stopped
+		auto profilerInstance{ profiler::Profiler::getInstance() };
+		if (profilerInstance->isCapturing())
+		{
+			profilerInstance->stopCapture();
+			profilerInstance->exportChromeTrace("profiler_capture.json");
+			_MAGE_DEBUG(eventsLogger, "profiler capture exported to profiler_capture.json");
+		}
+		else
+		{
+			profilerInstance->startCapture();
+		}
+	}
+
 	else if ('Q' == p_key)
 	{
 		if ("camera_Entity" == mainView)